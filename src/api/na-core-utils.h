@@ -53,6 +53,7 @@ gchar   *na_core_utils_str_add_prefix( const gchar *prefix, const gchar *str );
 int      na_core_utils_str_collate( const gchar *str1, const gchar *str2 );
 gchar   *na_core_utils_str_remove_char( const gchar *string, const gchar *to_remove );
 gchar   *na_core_utils_str_remove_suffix( const gchar *string, const gchar *suffix );
+gsize    na_core_utils_str_skip_bom_and_spaces( const gchar *data, gsize length );
 void     na_core_utils_str_split_first_word( const gchar *string, gchar **first, gchar **other );
 gchar   *na_core_utils_str_subst( const gchar *pattern, const gchar *key, const gchar *subst );
 
@@ -99,6 +100,7 @@ gchar   *na_core_utils_file_load_from_uri( const gchar *uri, gsize *length );
 
 /* miscellaneous
  */
+gint64   na_core_utils_get_monotonic_time( void );
 void     na_core_utils_print_version( void );
 
 G_END_DECLS
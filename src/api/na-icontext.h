@@ -94,18 +94,20 @@ typedef struct {
 
 GType    na_icontext_get_type( void );
 
-gboolean na_icontext_are_equal       ( const NAIContext *a, const NAIContext *b );
-gboolean na_icontext_is_candidate    ( const NAIContext *context, guint target, GList *selection );
-gboolean na_icontext_is_valid        ( const NAIContext *context );
+gboolean na_icontext_are_equal           ( const NAIContext *a, const NAIContext *b );
+gboolean na_icontext_is_candidate        ( const NAIContext *context, guint target, GList *selection );
+gboolean na_icontext_is_candidate_static ( const NAIContext *context, guint target, GList *selection );
+gboolean na_icontext_is_candidate_dynamic( const NAIContext *context, guint target, GList *selection );
+gboolean na_icontext_is_valid            ( const NAIContext *context );
 
-void     na_icontext_check_mimetypes ( const NAIContext *context );
+void     na_icontext_check_mimetypes     ( const NAIContext *context );
 
-void     na_icontext_copy            ( NAIContext *context, const NAIContext *source );
-void     na_icontext_read_done       ( NAIContext *context );
-void     na_icontext_set_scheme      ( NAIContext *context, const gchar *scheme, gboolean selected );
-void     na_icontext_set_only_desktop( NAIContext *context, const gchar *desktop, gboolean selected );
-void     na_icontext_set_not_desktop ( NAIContext *context, const gchar *desktop, gboolean selected );
-void     na_icontext_replace_folder  ( NAIContext *context, const gchar *old, const gchar *new );
+void     na_icontext_copy                ( NAIContext *context, const NAIContext *source );
+void     na_icontext_read_done           ( NAIContext *context );
+void     na_icontext_set_scheme          ( NAIContext *context, const gchar *scheme, gboolean selected );
+void     na_icontext_set_only_desktop    ( NAIContext *context, const gchar *desktop, gboolean selected );
+void     na_icontext_set_not_desktop     ( NAIContext *context, const gchar *desktop, gboolean selected );
+void     na_icontext_replace_folder      ( NAIContext *context, const gchar *old, const gchar *new );
 
 G_END_DECLS
 
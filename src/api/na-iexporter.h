@@ -102,6 +102,12 @@
  *          <entry>&prodname;</entry>
  *          <entry>2010-02-15</entry>
  *        </row>
+ *        <row>
+ *          <entry><literal>GConfDump</literal></entry>
+ *          <entry>NA XML module</entry>
+ *          <entry>&prodname;</entry>
+ *          <entry>2026-10-19</entry>
+ *        </row>
  *      </tbody>
  *    </tgroup>
  *  </table>
@@ -317,7 +323,7 @@ typedef struct {
  *                 equals to 2;
  *                 since structure version 1.
  * @content:  [in] version of the content of this structure;
- *                 equals to 1;
+ *                 equals to 2;
  *                 since structure version 2.
  * @exported: [in] exported NAObjectItem-derived object;
  *                 since structure version 1.
@@ -331,6 +337,14 @@ typedef struct {
  *                 the provider may append messages to this list,
  *                 but shouldn't reinitialize it;
  *                 since structure version 1.
+ * @more_exported: [in/out] a #GList of the #NAObjectItem -derived
+ *                 objects which are to be exported after @exported;
+ *                 a provider whose @format is able to hold several items
+ *                 in a same file may write them all in the file, and then
+ *                 reset this pointer to %NULL; other providers just
+ *                 ignore it, and will be called again for each item;
+ *                 only set if @content is 2 or more;
+ *                 since description content version 2.
  *
  * The structure that the plugin receives as a parameter of
  * #NAIExporterInterface.to_file () interface method.
@@ -345,6 +359,7 @@ typedef struct {
 	gchar        *format;
 	gchar        *basename;
 	GSList       *messages;
+	GList        *more_exported;
 }
 	NAIExporterFileParmsv2;
 
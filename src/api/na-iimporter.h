@@ -380,7 +380,7 @@ typedef enum {
  * NAIImporterImportFromUriParmsv2:
  * @version:       [in] the version of the structure, equals to 2;
  *                      since structure version 1.
- * @content:       [in] the version of the description content, equals to 1;
+ * @content:       [in] the version of the description content, equals to 3;
  *                      since structure version 2.
  * @uri:           [in] uri of the file to be imported;
  *                      since structure version 1.
@@ -390,6 +390,19 @@ typedef enum {
  *                      the provider may append messages to this list, but
  *                      shouldn't reinitialize it;
  *                      since structure version 1.
+ * @more_imported: [out] when the imported document contains several items,
+ *                      a #GList of the #NAObjectItem -derived objects found
+ *                      after the first one (which is returned in @imported);
+ *                      only set if @content is 2 or more;
+ *                      since description content version 2.
+ * @data:          [in] the content of the file at @uri, as already read by
+ *                      the caller, or %NULL; when set, the provider should
+ *                      examine these data rather than reading the file
+ *                      again; only set if @content is 3 or more;
+ *                      since description content version 3.
+ * @length:        [in] the length of @data;
+ *                      only set if @content is 3 or more;
+ *                      since description content version 3.
  *
  * This structure allows all used parameters when importing from an URI
  * to be passed and received through a single structure.
@@ -402,6 +415,9 @@ typedef struct {
 	const gchar  *uri;
 	NAObjectItem *imported;
 	GSList       *messages;
+	GList        *more_imported;
+	const gchar  *data;
+	gsize         length;
 }
 	NAIImporterImportFromUriParmsv2;
 
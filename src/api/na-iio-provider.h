@@ -217,6 +217,9 @@ typedef struct _NAIIOProviderInterfacePrivate     NAIIOProviderInterfacePrivate;
  * @write_item:          [should] writes an item.
  * @delete_item:         [should] deletes an item.
  * @duplicate_data:      [may]    let the I/O provider duplicates its specific data.
+ * @check_items_writability: [may] let the I/O provider set the read-only status of its items.
+ * @write_batch_begin:   [may]    starts a batch of writes.
+ * @write_batch_end:     [may]    ends a batch of writes.
  *
  * This defines the methods that a #NAIIOProvider may, should, or must
  * implement.
@@ -424,6 +427,65 @@ typedef struct {
 	 * Since: 2.30
 	 */
 	guint    ( *duplicate_data )     ( const NAIIOProvider *instance, NAObjectItem *dest, const NAObjectItem *source, GSList **messages );
+
+	/**
+	 * check_items_writability:
+	 * @instance: the NAIIOProvider provider.
+	 * @items: a flat list of NAObjectItem-derived items, menus or actions,
+	 *  which have all been read by this I/O provider.
+	 *
+	 * Nautilus-Actions calls this method only when it actually needs
+	 * to know whether the items may be updated, i.e. from the &nact;
+	 * configuration tool, once per load of the items tree.
+	 *
+	 * The I/O provider is expected to set the read-only status of each
+	 * item of the list, and may take advantage of this batch to share
+	 * its checks between the items.
+	 *
+	 * An I/O provider which doesn't implement this method should have
+	 * set the read-only status of its items when reading them.
+	 *
+	 * Since: 3.2.5
+	 */
+	void     ( *check_items_writability )( const NAIIOProvider *instance, GList *items );
+
+	/**
+	 * write_batch_begin:
+	 * @instance: the NAIIOProvider provider.
+	 *
+	 * Nautilus-Actions calls this method before writing several items
+	 * in a row, e.g. when saving the modifications from the &nact;
+	 * configuration tool.
+	 *
+	 * Up to the corresponding write_batch_end() call, the I/O provider
+	 * may delay the actual commit of the written items, in order to
+	 * commit them all at once.
+	 *
+	 * Since: 3.2.5
+	 */
+	void     ( *write_batch_begin )  ( const NAIIOProvider *instance );
+
+	/**
+	 * write_batch_end:
+	 * @instance: the NAIIOProvider provider.
+	 * @failed: a pointer to a GList list of #NAObjectItem objects; the
+	 *  provider should prepend to this list, with a new reference, the
+	 *  items which had been successfully written during the batch, but
+	 *  which have not been committed.
+	 * @messages: a pointer to a GSList list of strings; the provider
+	 *  may append messages to this list, but shouldn't reinitialize it.
+	 *
+	 * Ends a batch of writes started with write_batch_begin(). The
+	 * I/O provider should commit here all the items written during
+	 * the batch.
+	 *
+	 * Return value: NA_IIO_PROVIDER_CODE_OK if all the items have been
+	 * successfully committed, or another code depending of the detected
+	 * error.
+	 *
+	 * Since: 3.2.5
+	 */
+	guint    ( *write_batch_end )    ( const NAIIOProvider *instance, GList **failed, GSList **messages );
 }
 	NAIIOProviderInterface;
 
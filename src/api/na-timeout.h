@@ -75,7 +75,18 @@ typedef void ( *NATimeoutFunc )( void *user_data );
  * When an event is detected, the na_timeout_event() function must be called
  * with this structure. The function makes sure that the @handler callback
  * will be triggered as soon as no event will be recorded after @timeout
- * milliseconds of inactivity.
+ * milliseconds of inactivity. A continuous burst of events cannot delay the
+ * @handler more than a few @timeout periods after the first event.
+ *
+ * All #NATimeout structures are managed by a single coalescing scheduler,
+ * which runs one monotonic deadline timer for all of them. When a @handler
+ * itself records an event on another #NATimeout (e.g. an I/O provider which
+ * signals NAPivot, which itself signals the menu plugin), this chained event
+ * is dispatched in the same pass, so that a change is only delayed once
+ * along the chain.
+ *
+ * The owner of the structure should call na_timeout_remove() before
+ * releasing it.
  *
  * Since: 3.1
  */
@@ -90,7 +101,8 @@ typedef struct {
 }
 	NATimeout;
 
-void na_timeout_event( NATimeout *timeout );
+void na_timeout_event ( NATimeout *timeout );
+void na_timeout_remove( NATimeout *timeout );
 
 G_END_DECLS
 
@@ -73,6 +73,7 @@ struct _NABoxedPrivate {
 	gboolean        dispose_has_run;
 	const BoxedDef *def;
 	gboolean        is_set;
+	guint           serial;
 	union {
 		gboolean    boolean;
 		void       *pointer;
@@ -87,12 +88,22 @@ struct _NABoxedPrivate {
 
 static GObjectClass *st_parent_class   = NULL;
 
+/* each time a box is created or its value is set, it is stamped with
+ * a new serial number, so that consumers are able to only reconsider
+ * the boxes which have actually changed
+ *
+ * the counter is atomically incremented, so that boxes may be created
+ * or set from any thread
+ */
+static volatile gint st_serial         = 0;
+
 static GType           register_type( void );
 static void            class_init( NABoxedClass *klass );
 static void            instance_init( GTypeInstance *instance, gpointer klass );
 static void            instance_dispose( GObject *object );
 static void            instance_finalize( GObject *object );
 
+static guint           get_next_serial( void );
 static NABoxed        *boxed_new( const BoxedDef *def );
 static const BoxedDef *get_boxed_def( guint type );
 static gchar         **string_to_array( const gchar *string );
@@ -365,6 +376,7 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->dispose_has_run = FALSE;
 	self->private->def = NULL;
 	self->private->is_set = FALSE;
+	self->private->serial = get_next_serial();
 }
 
 static void
@@ -413,6 +425,19 @@ instance_finalize( GObject *object )
 	}
 }
 
+/*
+ * returns a new serial number
+ */
+static guint
+get_next_serial( void )
+{
+#if GLIB_CHECK_VERSION( 2, 30, 0 )
+	return(( guint ) g_atomic_int_add( &st_serial, 1 ) + 1 );
+#else
+	return(( guint ) g_atomic_int_exchange_and_add( &st_serial, 1 ) + 1 );
+#endif
+}
+
 static NABoxed *
 boxed_new( const BoxedDef *def )
 {
@@ -562,6 +587,27 @@ na_boxed_copy( const NABoxed *boxed )
 	return( dest );
 }
 
+/**
+ * na_boxed_get_serial:
+ * @boxed: the #NABoxed object.
+ *
+ * The serial number of a box is updated each time its value is set.
+ * As the serial numbers are given from an ever-increasing counter, a
+ * consumer which has recorded the greatest serial number it has seen
+ * is able to later know which boxes have been set since.
+ *
+ * Returns: the serial number of the @boxed.
+ *
+ * Since: 3.2.5
+ */
+guint
+na_boxed_get_serial( const NABoxed *boxed )
+{
+	g_return_val_if_fail( NA_IS_BOXED( boxed ), 0 );
+
+	return( boxed->private->serial );
+}
+
 /**
  * na_boxed_dump:
  * @boxed: the #NABoxed box to be dumped.
@@ -838,6 +884,7 @@ na_boxed_set_from_boxed( NABoxed *boxed, const NABoxed *value )
 	( *boxed->private->def->free )( boxed );
 	( *boxed->private->def->copy )( boxed, value );
 	boxed->private->is_set = TRUE;
+	boxed->private->serial = get_next_serial();
 }
 
 /**
@@ -861,6 +908,7 @@ na_boxed_set_from_string( NABoxed *boxed, const gchar *value )
 	( *boxed->private->def->free )( boxed );
 	( *boxed->private->def->from_string )( boxed, value );
 	boxed->private->is_set = TRUE;
+	boxed->private->serial = get_next_serial();
 }
 
 /**
@@ -884,6 +932,7 @@ na_boxed_set_from_value( NABoxed *boxed, const GValue *value )
 	( *boxed->private->def->free )( boxed );
 	( *boxed->private->def->from_value )( boxed, value );
 	boxed->private->is_set = TRUE;
+	boxed->private->serial = get_next_serial();
 }
 
 /**
@@ -907,6 +956,7 @@ na_boxed_set_from_void( NABoxed *boxed, const void *value )
 	( *boxed->private->def->free )( boxed );
 	( *boxed->private->def->from_void )( boxed, value );
 	boxed->private->is_set = TRUE;
+	boxed->private->serial = get_next_serial();
 }
 
 static gboolean
@@ -242,6 +242,37 @@ na_core_utils_str_remove_suffix( const gchar *string, const gchar *suffix )
 	return( removed );
 }
 
+/**
+ * na_core_utils_str_skip_bom_and_spaces:
+ * @data: the content of a file, not necessarily null-terminated.
+ * @length: the length of @data.
+ *
+ * Returns: the offset of the first significant character of @data, after
+ * an eventual UTF-8 byte order mark and leading spaces, or @length if
+ * there is no such character.
+ *
+ * Since: 3.2.5
+ */
+gsize
+na_core_utils_str_skip_bom_and_spaces( const gchar *data, gsize length )
+{
+	gsize i;
+
+	if( !data ){
+		return( length );
+	}
+
+	i = 0;
+	if( length >= 3 && !memcmp( data, "\xef\xbb\xbf", 3 )){
+		i = 3;
+	}
+	while( i < length && g_ascii_isspace( data[i] )){
+		i++;
+	}
+
+	return( i );
+}
+
 /**
  * na_core_utils_str_split_first_word:
  * @string: a space-separated string.
@@ -1202,6 +1233,29 @@ na_core_utils_file_load_from_uri( const gchar *uri, gsize *length )
 	return( data );
 }
 
+/**
+ * na_core_utils_get_monotonic_time:
+ *
+ * Returns: the current monotonic time in microseconds, or the current
+ * system time when the monotonic clock is not available in this
+ * version of GLib.
+ *
+ * Since: 3.2.5
+ */
+gint64
+na_core_utils_get_monotonic_time( void )
+{
+#if GLIB_CHECK_VERSION( 2, 28, 0 )
+	return( g_get_monotonic_time());
+#else
+	GTimeVal now;
+
+	g_get_current_time( &now );
+
+	return(( gint64 ) now.tv_sec * G_USEC_PER_SEC + now.tv_usec );
+#endif
+}
+
 /**
  * na_core_utils_print_version:
  *
@@ -31,7 +31,16 @@
 #include <config.h>
 #endif
 
+#ifdef HAVE_GDBUS
+#include <gio/gio.h>
+#else
+# ifdef HAVE_DBUS_GLIB
+#include <dbus/dbus-glib.h>
+# endif
+#endif
+#include <gdk/gdk.h>
 #include <glib/gi18n.h>
+#include <string.h>
 
 #include "na-desktop-environment.h"
 
@@ -45,6 +54,14 @@ static const NADesktopEnv st_desktops[] = {
 	{ NULL }
 };
 
+/* the running desktop does not change during the session
+ */
+static const gchar *st_running_desktop = NULL;
+
+static const gchar *detect_running_desktop( void );
+static gboolean     is_dbus_name_owned( const gchar *name );
+static gboolean     is_xfce_running( void );
+
 /*
  * na_desktop_environment_get_known_list:
  *
@@ -63,16 +80,27 @@ na_desktop_environment_get_known_list( void )
  * Have asked on xdg-list how to identify the currently running desktop environment
  * (see http://standards.freedesktop.org/menu-spec/latest/apb.html)
  * For now, just reproduce the xdg-open algorythm from xdg-utils 1.0
+ *
+ * The result is computed once, without spawning any external command,
+ * and then cached for the lifetime of the process.
  */
 const gchar *
 na_desktop_environment_detect_running_desktop( void )
 {
 	static const gchar *thisfn = "na_desktop_environment_detect_running_desktop";
+
+	if( !st_running_desktop ){
+		st_running_desktop = detect_running_desktop();
+		g_debug( "%s: running desktop is %s", thisfn, st_running_desktop );
+	}
+
+	return( st_running_desktop );
+}
+
+static const gchar *
+detect_running_desktop( void )
+{
 	const gchar *value;
-	gchar *output_str, *error_str;
-	gint exit_status;
-	GError *error;
-	gboolean ok;
 	int i;
 
 	value = g_getenv( "XDG_CURRENT_DESKTOP" );
@@ -106,48 +134,139 @@ na_desktop_environment_detect_running_desktop( void )
 		}
 	}
 
-	output_str = NULL;
-	error_str = NULL;
-	error = NULL;
-	if( g_spawn_command_line_sync(
-			"dbus-send --print-reply --dest=org.freedesktop.DBus /org/freedesktop/DBus org.freedesktop.DBus.GetNameOwner string:org.gnome.SessionManager",
-			&output_str, &error_str, &exit_status, &error )){
-		ok = ( exit_status == 0 && output_str && strlen( output_str ) && ( !error_str || !strlen( error_str )));
-		g_free( output_str );
-		g_free( error_str );
-		if( ok ){
-			return( DESKTOP_GNOME );
-		}
+	if( is_dbus_name_owned( "org.gnome.SessionManager" )){
+		return( DESKTOP_GNOME );
 	}
-	if( error ){
-		g_warning( "%s: dbus-send: %s", thisfn, error->message );
-		g_error_free( error );
+
+	if( is_xfce_running()){
+		return( DESKTOP_XFCE );
 	}
 
-	output_str = NULL;
-	error_str = NULL;
-	error = NULL;
-	if( g_spawn_command_line_sync(
-			"xprop -root _DT_SAVE_MODE", &output_str, &error_str, &exit_status, &error )){
-		ok = ( exit_status == 0 && output_str && strlen( output_str ) && ( !error_str || !strlen( error_str )));
-		if( ok ){
-			ok = ( g_strstr_len( output_str, -1, "xfce" ) != NULL );
+	/* do not know how to identify ROX
+	 * this one and other desktops are just identified as 'Old' (legacy systems)
+	 */
+	return( DESKTOP_OLD );
+}
+
+/*
+ * ask the session bus whether the @name is currently owned
+ * (was: dbus-send ... org.freedesktop.DBus.GetNameOwner)
+ */
+static gboolean
+is_dbus_name_owned( const gchar *name )
+{
+	static const gchar *thisfn = "na_desktop_environment_is_dbus_name_owned";
+	gboolean owned = FALSE;
+	GError *error = NULL;
+#ifdef HAVE_GDBUS
+	GDBusConnection *connection;
+	GVariant *result;
+#else
+# ifdef HAVE_DBUS_GLIB
+	DBusGConnection *connection;
+	DBusGProxy *proxy;
+# endif
+#endif
+
+#ifdef HAVE_GDBUS
+	connection = g_bus_get_sync( G_BUS_TYPE_SESSION, NULL, &error );
+
+	if( connection ){
+		result = g_dbus_connection_call_sync( connection,
+				"org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+				"NameHasOwner", g_variant_new( "(s)", name ), G_VARIANT_TYPE( "(b)" ),
+				G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error );
+
+		if( result ){
+			g_variant_get( result, "(b)", &owned );
+			g_variant_unref( result );
 		}
-		g_free( output_str );
-		g_free( error_str );
-		if( ok ){
-			return( DESKTOP_XFCE );
+
+		g_object_unref( connection );
+	}
+#else
+# ifdef HAVE_DBUS_GLIB
+	connection = dbus_g_bus_get( DBUS_BUS_SESSION, &error );
+
+	if( connection ){
+		proxy = dbus_g_proxy_new_for_name( connection,
+				"org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus" );
+
+		if( !dbus_g_proxy_call( proxy, "NameHasOwner", &error,
+				G_TYPE_STRING, name, G_TYPE_INVALID,
+				G_TYPE_BOOLEAN, &owned, G_TYPE_INVALID )){
+			owned = FALSE;
 		}
+
+		g_object_unref( proxy );
+		dbus_g_connection_unref( connection );
 	}
+# endif
+#endif
+
 	if( error ){
-		g_warning( "%s: xprop: %s", thisfn, error->message );
+		g_warning( "%s: %s", thisfn, error->message );
 		g_error_free( error );
 	}
 
-	/* do not know how to identify ROX
-	 * this one and other desktops are just identified as 'Old' (legacy systems)
-	 */
-	return( DESKTOP_OLD );
+	return( owned );
+}
+
+/*
+ * look at the _DT_SAVE_MODE property of the root window
+ * (was: xprop -root _DT_SAVE_MODE)
+ *
+ * there is no default display when GDK has not been initialized (e.g.
+ * from the command-line utilities): we then open our own connection to
+ * the display for the time of the query; if there is no display at all,
+ * XFCE is not considered as running
+ */
+static gboolean
+is_xfce_running( void )
+{
+	static const gchar *thisfn = "na_desktop_environment_is_xfce_running";
+	gboolean ok;
+	GdkDisplay *display, *opened;
+	GdkAtom atom;
+	GdkAtom actual_type;
+	gint actual_format, actual_length;
+	guchar *data;
+
+	ok = FALSE;
+	opened = NULL;
+	display = gdk_display_get_default();
+
+	if( !display ){
+		opened = gdk_display_open( NULL );
+		display = opened;
+		g_debug( "%s: no default display, opened display=%p", thisfn, ( void * ) opened );
+	}
+
+	if( display ){
+
+		/* do not create the atom if it does not exist yet */
+		atom = gdk_atom_intern( "_DT_SAVE_MODE", TRUE );
+
+		if( atom != GDK_NONE ){
+			data = NULL;
+
+			if( gdk_property_get(
+					gdk_screen_get_root_window( gdk_display_get_default_screen( display )),
+					atom, GDK_NONE, 0, 1024, FALSE,
+					&actual_type, &actual_format, &actual_length, &data ) && data ){
+
+				ok = ( g_strstr_len(( const gchar * ) data, actual_length, "xfce" ) != NULL );
+			}
+
+			g_free( data );
+		}
+	}
+
+	if( opened ){
+		gdk_display_close( opened );
+	}
+
+	return( ok );
 }
 
 /*
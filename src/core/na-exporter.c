@@ -59,10 +59,17 @@ static NAExporterFormatStr st_format_ask = {
 /* i18n: NAIExporter is an interface name, do not even try to translate */
 #define NO_IMPLEMENTATION_MSG			N_( "No NAIExporter implementation found for '%s' format." )
 
-static GList *exporter_get_formats( const NAIExporter *exporter );
-static void   exporter_free_formats( const NAIExporter *exporter, GList * str_list );
-static gchar *exporter_get_name( const NAIExporter *exporter );
-static void   on_pixbuf_finalized( gpointer user_data, GObject *pixbuf );
+/* the format -> exporter map is attached to the pivot under this key
+ */
+#define EXPORTER_FORMATS_MAP			"na-exporter-formats-map"
+
+static GList      *exporter_get_formats( const NAIExporter *exporter );
+static void        exporter_free_formats( const NAIExporter *exporter, GList * str_list );
+static gchar      *exporter_get_name( const NAIExporter *exporter );
+static GHashTable *get_formats_map( const NAPivot *pivot );
+static gchar      *export_to_buffer( NAIExporter *exporter, const NAObjectItem *item, const gchar *format, GSList **messages );
+static gchar      *export_to_file( NAIExporter *exporter, const NAObjectItem *item, GList **more, const gchar *folder_uri, const gchar *format, GSList **messages );
+static void        on_pixbuf_finalized( gpointer user_data, GObject *pixbuf );
 
 /*
  * na_exporter_get_formats:
@@ -264,9 +271,7 @@ na_exporter_to_buffer( const NAPivot *pivot,
 {
 	static const gchar *thisfn = "na_exporter_to_buffer";
 	gchar *buffer;
-	NAIExporterBufferParmsv2 parms;
 	NAIExporter *exporter;
-	gchar *name;
 	gchar *msg;
 
 	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
@@ -285,32 +290,107 @@ na_exporter_to_buffer( const NAPivot *pivot,
 	g_debug( "%s: exporter=%p (%s)", thisfn, ( void * ) exporter, G_OBJECT_TYPE_NAME( exporter ));
 
 	if( exporter ){
+		buffer = export_to_buffer( exporter, item, format, messages );
+
+	} else {
+		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		*messages = g_slist_append( *messages, msg );
+	}
+
+	return( buffer );
+}
+
+/*
+ * na_exporter_to_buffers:
+ * @pivot: the #NAPivot pivot for the running application.
+ * @items: a list of #NAObjectItem-derived objects.
+ * @format: the target format identifier.
+ * @messages: a pointer to a #GSList list of strings; the provider
+ *  may append messages to this list, but shouldn't reinitialize it.
+ *
+ * Exports all the specified @items in the required @format, only
+ * searching once for the #NAIExporter which provides this @format.
+ *
+ * Returns: a list of output buffers, in the same order than @items,
+ * each element being a newly allocated string, or %NULL if the
+ * corresponding item has not been exported.
+ * The returned list should be released by the caller, i.e. each element
+ * g_free(), then the list g_list_free().
+ */
+GList *
+na_exporter_to_buffers( const NAPivot *pivot,
+		GList *items, const gchar *format, GSList **messages )
+{
+	static const gchar *thisfn = "na_exporter_to_buffers";
+	GList *buffers, *it;
+	NAIExporter *exporter;
+	gchar *msg;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+
+	buffers = NULL;
+
+	g_debug( "%s: pivot=%p, items=%p (count=%d), format=%s, messages=%p",
+			thisfn,
+			( void * ) pivot,
+			( void * ) items, g_list_length( items ),
+			format,
+			( void * ) messages );
+
+	exporter = na_exporter_find_for_format( pivot, format );
+
+	if( exporter ){
+		for( it = items ; it ; it = it->next ){
+			buffers = g_list_prepend( buffers,
+					NA_IS_OBJECT_ITEM( it->data )
+							? export_to_buffer( exporter, NA_OBJECT_ITEM( it->data ), format, messages )
+							: NULL );
+		}
+		buffers = g_list_reverse( buffers );
+
+	} else {
+		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		*messages = g_slist_append( *messages, msg );
+	}
+
+	return( buffers );
+}
+
+static gchar *
+export_to_buffer( NAIExporter *exporter, const NAObjectItem *item, const gchar *format, GSList **messages )
+{
+	gchar *buffer;
+	NAIExporterBufferParmsv2 parms;
+	gchar *name;
+	gchar *msg;
+
+	buffer = NULL;
+
+	if( NA_IEXPORTER_GET_INTERFACE( exporter )->to_buffer ){
 		parms.version = 2;
+		parms.content = 1;
 		parms.exported = ( NAObjectItem * ) item;
 		parms.format = g_strdup( format );
 		parms.buffer = NULL;
 		parms.messages = messages ? *messages : NULL;
 
-		if( NA_IEXPORTER_GET_INTERFACE( exporter )->to_buffer ){
-			NA_IEXPORTER_GET_INTERFACE( exporter )->to_buffer( exporter, &parms );
-
-			if( parms.buffer ){
-				buffer = parms.buffer;
-			}
+		NA_IEXPORTER_GET_INTERFACE( exporter )->to_buffer( exporter, &parms );
 
-		} else {
-			name = exporter_get_name( exporter );
-			/* i18n: NAIExporter is an interface name, do not even try to translate */
-			msg = g_strdup_printf( _( "%s NAIExporter doesn't implement 'to_buffer' interface." ), name );
-			*messages = g_slist_append( *messages, msg );
-			g_free( name );
+		if( parms.buffer ){
+			buffer = parms.buffer;
+		}
+		if( messages ){
+			*messages = parms.messages;
 		}
 
 		g_free( parms.format );
 
 	} else {
-		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		name = exporter_get_name( exporter );
+		/* i18n: NAIExporter is an interface name, do not even try to translate */
+		msg = g_strdup_printf( _( "%s NAIExporter doesn't implement 'to_buffer' interface." ), name );
 		*messages = g_slist_append( *messages, msg );
+		g_free( name );
 	}
 
 	return( buffer );
@@ -336,10 +416,8 @@ na_exporter_to_file( const NAPivot *pivot,
 {
 	static const gchar *thisfn = "na_exporter_to_file";
 	gchar *export_uri;
-	NAIExporterFileParmsv2 parms;
 	NAIExporter *exporter;
 	gchar *msg;
-	gchar *name;
 
 	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
 	g_return_val_if_fail( NA_IS_OBJECT_ITEM( item ), NULL );
@@ -357,33 +435,198 @@ na_exporter_to_file( const NAPivot *pivot,
 	exporter = na_exporter_find_for_format( pivot, format );
 
 	if( exporter ){
+		export_uri = export_to_file( exporter, item, NULL, folder_uri, format, messages );
+
+	} else {
+		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		*messages = g_slist_append( *messages, msg );
+	}
+
+	return( export_uri );
+}
+
+/*
+ * na_exporter_to_file_more:
+ * @pivot: the #NAPivot pivot for the running application.
+ * @item: a #NAObjectItem-derived object.
+ * @more: [in][out]: a pointer to the list of the items to be exported
+ *  after @item.
+ * @folder_uri: the URI of the target folder.
+ * @format: the target format identifier.
+ * @messages: a pointer to a #GSList list of strings; the provider
+ *  may append messages to this list, but shouldn't reinitialize it.
+ *
+ * Exports the specified @item to the target @folder_uri in the required
+ * @format, offering to the #NAIExporter provider to write the @more items
+ * in the same file. If it has done so, *@more is reset to %NULL.
+ *
+ * This lets the caller export a list of items one step after the other,
+ * while still writing them in a single archive when the @format is able
+ * to hold several items.
+ *
+ * Returns: the URI of the exported file, as a newly allocated string which
+ * should be g_free() by the caller, or %NULL if an error has been detected.
+ *
+ * Since: 3.2.5
+ */
+gchar *
+na_exporter_to_file_more( const NAPivot *pivot,
+		const NAObjectItem *item, GList **more, const gchar *folder_uri, const gchar *format, GSList **messages )
+{
+	static const gchar *thisfn = "na_exporter_to_file_more";
+	gchar *export_uri;
+	NAIExporter *exporter;
+	gchar *msg;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+	g_return_val_if_fail( NA_IS_OBJECT_ITEM( item ), NULL );
+	g_return_val_if_fail( more != NULL, NULL );
+
+	export_uri = NULL;
+
+	g_debug( "%s: pivot=%p, item=%p (%s), more=%p (count=%d), folder_uri=%s, format=%s",
+			thisfn,
+			( void * ) pivot,
+			( void * ) item, G_OBJECT_TYPE_NAME( item ),
+			( void * ) *more, g_list_length( *more ),
+			folder_uri,
+			format );
+
+	exporter = na_exporter_find_for_format( pivot, format );
+
+	if( exporter ){
+		export_uri = export_to_file( exporter, item, more, folder_uri, format, messages );
+
+	} else {
+		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		*messages = g_slist_append( *messages, msg );
+	}
+
+	return( export_uri );
+}
+
+/*
+ * na_exporter_to_files:
+ * @pivot: the #NAPivot pivot for the running application.
+ * @items: a list of #NAObjectItem-derived objects.
+ * @folder_uri: the URI of the target folder.
+ * @format: the target format identifier.
+ * @messages: a pointer to a #GSList list of strings; the provider
+ *  may append messages to this list, but shouldn't reinitialize it.
+ *
+ * Exports all the specified @items to the target @folder_uri in the
+ * required @format, only searching once for the #NAIExporter which
+ * provides this @format.
+ *
+ * If the @format is able to hold several items in a same file, the
+ * #NAIExporter provider may write all remaining items in the same
+ * archive file, which is so created only once.
+ *
+ * Returns: a list of the URIs of the exported files, in the same order
+ * than @items, each element being a newly allocated string, or %NULL
+ * if the corresponding item has not been exported.
+ * The returned list should be released by the caller, i.e. each element
+ * g_free(), then the list g_list_free().
+ */
+GList *
+na_exporter_to_files( const NAPivot *pivot,
+		GList *items, const gchar *folder_uri, const gchar *format, GSList **messages )
+{
+	static const gchar *thisfn = "na_exporter_to_files";
+	GList *uris, *it, *more;
+	NAIExporter *exporter;
+	gchar *msg;
+	gchar *uri;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+
+	uris = NULL;
+
+	g_debug( "%s: pivot=%p, items=%p (count=%d), folder_uri=%s, format=%s, messages=%p",
+			thisfn,
+			( void * ) pivot,
+			( void * ) items, g_list_length( items ),
+			folder_uri,
+			format,
+			( void * ) messages );
+
+	exporter = na_exporter_find_for_format( pivot, format );
+
+	if( exporter ){
+		for( it = items ; it ; it = it->next ){
+			uri = NULL;
+			more = it->next;
+
+			if( NA_IS_OBJECT_ITEM( it->data )){
+				uri = export_to_file( exporter, NA_OBJECT_ITEM( it->data ), &more, folder_uri, format, messages );
+			}
+			uris = g_list_prepend( uris, uri );
+
+			/* the provider has written all remaining items in the same file
+			 */
+			if( it->next && !more ){
+				for( it = it->next ; it ; it = it->next ){
+					uris = g_list_prepend( uris, g_strdup( uri ));
+				}
+				break;
+			}
+		}
+		uris = g_list_reverse( uris );
+
+	} else {
+		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		*messages = g_slist_append( *messages, msg );
+	}
+
+	return( uris );
+}
+
+/*
+ * more, if not null, points to the list of the items to be exported
+ * after this one; it is reset to NULL if the provider has exported them
+ * in the same file
+ */
+static gchar *
+export_to_file( NAIExporter *exporter, const NAObjectItem *item, GList **more, const gchar *folder_uri, const gchar *format, GSList **messages )
+{
+	gchar *export_uri;
+	NAIExporterFileParmsv2 parms;
+	gchar *name;
+	gchar *msg;
+
+	export_uri = NULL;
+
+	if( NA_IEXPORTER_GET_INTERFACE( exporter )->to_file ){
 		parms.version = 2;
+		parms.content = 2;
 		parms.exported = ( NAObjectItem * ) item;
 		parms.folder = ( gchar * ) folder_uri;
 		parms.format = g_strdup( format );
 		parms.basename = NULL;
 		parms.messages = messages ? *messages : NULL;
+		parms.more_exported = more ? *more : NULL;
 
-		if( NA_IEXPORTER_GET_INTERFACE( exporter )->to_file ){
-			NA_IEXPORTER_GET_INTERFACE( exporter )->to_file( exporter, &parms );
+		NA_IEXPORTER_GET_INTERFACE( exporter )->to_file( exporter, &parms );
 
-			if( parms.basename ){
-				export_uri = g_strdup_printf( "%s%s%s", folder_uri, G_DIR_SEPARATOR_S, parms.basename );
-			}
+		if( more ){
+			*more = parms.more_exported;
+		}
 
-		} else {
-			name = exporter_get_name( exporter );
-			/* i18n: NAIExporter is an interface name, do not even try to translate */
-			msg = g_strdup_printf( _( "%s NAIExporter doesn't implement 'to_file' interface." ), name );
-			*messages = g_slist_append( *messages, msg );
-			g_free( name );
+		if( parms.basename ){
+			export_uri = g_strdup_printf( "%s%s%s", folder_uri, G_DIR_SEPARATOR_S, parms.basename );
+		}
+		if( messages ){
+			*messages = parms.messages;
 		}
 
 		g_free( parms.format );
 
 	} else {
-		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		name = exporter_get_name( exporter );
+		/* i18n: NAIExporter is an interface name, do not even try to translate */
+		msg = g_strdup_printf( _( "%s NAIExporter doesn't implement 'to_file' interface." ), name );
 		*messages = g_slist_append( *messages, msg );
+		g_free( name );
 	}
 
 	return( export_uri );
@@ -411,31 +654,72 @@ exporter_get_name( const NAIExporter *exporter )
  * Returns: the #NAIExporter instance which provides the @format export
  * format. The returned instance is owned by @pivot, and should not be
  * released by the caller.
+ *
+ * The lookup is done against a format -> exporter map which is built
+ * on first call, and then kept attached to the @pivot.
  */
 NAIExporter *
 na_exporter_find_for_format( const NAPivot *pivot, const gchar *format )
 {
-	NAIExporter *exporter;
-	GList *formats, *ifmt;
-	gchar *id;
-	NAExportFormat *export_format;
+	GHashTable *map;
 
 	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
 
-	exporter = NULL;
-	formats = na_exporter_get_formats( pivot );
+	if( !format ){
+		return( NULL );
+	}
+
+	map = get_formats_map( pivot );
 
-	for( ifmt = formats ; ifmt && !exporter ; ifmt = ifmt->next ){
+	return(( NAIExporter * ) g_hash_table_lookup( map, format ));
+}
 
-		export_format = NA_EXPORT_FORMAT( ifmt->data );
-		id = na_ioption_get_id( NA_IOPTION( export_format ));
-		if( !strcmp( id, format )){
-			exporter = na_export_format_get_provider( NA_EXPORT_FORMAT( ifmt->data ));
+/*
+ * Returns the format -> exporter map, building it if needed.
+ *
+ * The map is directly built from the formats described by the providers,
+ * so that we do not allocate any NAExportFormat object nor pixbuf here.
+ * As the I/O providers are loaded once for the pivot lifetime, the map
+ * is attached to the pivot and released with it.
+ * When several providers claim the same format, the first one wins, as
+ * with the previous linear lookup.
+ */
+static GHashTable *
+get_formats_map( const NAPivot *pivot )
+{
+	static const gchar *thisfn = "na_exporter_get_formats_map";
+	GHashTable *map;
+	GList *iexporters, *imod;
+	GList *str_list, *is;
+	NAIExporterFormatv2 *str;
+
+	map = ( GHashTable * ) g_object_get_data( G_OBJECT( pivot ), EXPORTER_FORMATS_MAP );
+
+	if( !map ){
+		map = g_hash_table_new_full( g_str_hash, g_str_equal, ( GDestroyNotify ) g_free, NULL );
+		iexporters = na_pivot_get_providers( pivot, NA_TYPE_IEXPORTER );
+
+		for( imod = iexporters ; imod ; imod = imod->next ){
+			str_list = exporter_get_formats( NA_IEXPORTER( imod->data ));
+
+			for( is = str_list ; is ; is = is->next ){
+				str = ( NAIExporterFormatv2 * ) is->data;
+				if( str->format && !g_hash_table_lookup( map, str->format )){
+					g_hash_table_insert( map, g_strdup( str->format ), imod->data );
+				}
+			}
+
+			exporter_free_formats( NA_IEXPORTER( imod->data ), str_list );
 		}
-		g_free( id );
-	}
 
-	na_exporter_free_formats( formats );
+		na_pivot_free_providers( iexporters );
+
+		g_debug( "%s: pivot=%p, formats count=%d",
+				thisfn, ( void * ) pivot, g_hash_table_size( map ));
+
+		g_object_set_data_full( G_OBJECT( pivot ),
+				EXPORTER_FORMATS_MAP, map, ( GDestroyNotify ) g_hash_table_destroy );
+	}
 
-	return( exporter );
+	return( map );
 }
@@ -55,12 +55,30 @@ gchar       *na_exporter_to_buffer      ( const NAPivot *pivot,
                                           const gchar *format,
                                           GSList **messages );
 
+GList       *na_exporter_to_buffers     ( const NAPivot *pivot,
+                                          GList *items,
+                                          const gchar *format,
+                                          GSList **messages );
+
 gchar       *na_exporter_to_file        ( const NAPivot *pivot,
                                           const NAObjectItem *item,
                                           const gchar *folder_uri,
                                           const gchar *format,
                                           GSList **messages );
 
+gchar       *na_exporter_to_file_more   ( const NAPivot *pivot,
+                                          const NAObjectItem *item,
+                                          GList **more,
+                                          const gchar *folder_uri,
+                                          const gchar *format,
+                                          GSList **messages );
+
+GList       *na_exporter_to_files       ( const NAPivot *pivot,
+                                          GList *items,
+                                          const gchar *folder_uri,
+                                          const gchar *format,
+                                          GSList **messages );
+
 NAIExporter *na_exporter_find_for_format( const NAPivot *pivot,
 		                                  const gchar *format );
 
@@ -89,6 +89,32 @@ typedef struct {
 }
 	NafoDefaultIter;
 
+/* the modification and validity status of the data attached to an
+ * object, as they have been last checked
+ * a box whose serial is greater than the recorded one has been set
+ * since this last check; a count which has changed means that some
+ * boxes have been attached or detached
+ */
+typedef struct {
+	const NAIFactoryObject *origin;
+	guint                   origin_count;
+	guint                   origin_serial;
+	guint                   count;
+	guint                   serial;
+	GSList                 *differing;
+	gboolean                valid_checked;
+	guint                   valid_count;
+	guint                   valid_serial;
+	gboolean                valid;
+}
+	NafoStatus;
+
+#define NA_IFACTORY_OBJECT_PROP_STATUS		"na-ifactory-object-prop-status"
+
+/* the count of the objects which share a box, besides its first owner
+ */
+#define NA_IFACTORY_OBJECT_BOXED_SHARERS	"na-ifactory-object-boxed-sharers"
+
 extern gboolean                   ifactory_object_initialized;
 extern gboolean                   ifactory_object_finalized;
 
@@ -108,7 +134,14 @@ static guint        v_write_start( NAIFactoryObject *serializable, const NAIFact
 static guint        v_write_done( NAIFactoryObject *serializable, const NAIFactoryProvider *reader, void *reader_data, GSList **messages );
 
 static void         attach_boxed_to_object( NAIFactoryObject *object, NADataBoxed *boxed );
+static NADataBoxed *get_unshared_boxed( const NAIFactoryObject *object, NADataBoxed *boxed );
+static NADataBoxed *share_boxed( NADataBoxed *boxed );
+static void         release_boxed( NADataBoxed *boxed );
 static void         free_data_boxed_list( NAIFactoryObject *object );
+static NafoStatus  *get_status( const NAIFactoryObject *object );
+static void         free_status( NafoStatus *status );
+static guint        get_greatest_serial( GList *list, guint *count );
+static GSList      *check_data_differ( GSList *differing, const NAIFactoryObject *a, NADataBoxed *b_boxed );
 static void         iter_on_data_defs( const NADataGroup *idgroups, guint mode, NADataDefIterFunc pfn, void *user_data );
 
 /*
@@ -335,6 +368,8 @@ na_factory_object_move_boxed( NAIFactoryObject *target, const NAIFactoryObject *
 	GList *src_list = g_object_get_data( G_OBJECT( source ), NA_IFACTORY_OBJECT_PROP_DATA );
 
 	if( g_list_find( src_list, boxed )){
+		boxed = get_unshared_boxed( source, boxed );
+		src_list = g_object_get_data( G_OBJECT( source ), NA_IFACTORY_OBJECT_PROP_DATA );
 		src_list = g_list_remove( src_list, boxed );
 		g_object_set_data( G_OBJECT( source ), NA_IFACTORY_OBJECT_PROP_DATA, src_list );
 
@@ -353,6 +388,10 @@ na_factory_object_move_boxed( NAIFactoryObject *target, const NAIFactoryObject *
  *
  * Copies one instance to another.
  * Takes care of not overriding provider data.
+ *
+ * The copyable #NADataBoxed are not themselves duplicated, but shared
+ * between @source and @target: they will only be actually copied when
+ * one of these objects sets a new value (see get_unshared_boxed()).
  */
 void
 na_factory_object_copy( NAIFactoryObject *target, const NAIFactoryObject *source )
@@ -384,7 +423,7 @@ na_factory_object_copy( NAIFactoryObject *target, const NAIFactoryObject *source
 		def = na_data_boxed_get_data_def( boxed );
 		if( def->copyable ){
 			dest_list = g_list_remove_link( dest_list, idest );
-			g_object_unref( idest->data );
+			release_boxed( NA_DATA_BOXED( idest->data ));
 		}
 		idest = inext;
 	}
@@ -399,10 +438,11 @@ na_factory_object_copy( NAIFactoryObject *target, const NAIFactoryObject *source
 		if( def->copyable ){
 			NADataBoxed *tgt_boxed = na_ifactory_object_get_data_boxed( target, def->name );
 			if( !tgt_boxed ){
-				tgt_boxed = na_data_boxed_new( def );
-				attach_boxed_to_object( target, tgt_boxed );
+				attach_boxed_to_object( target, share_boxed( boxed ));
+			} else {
+				tgt_boxed = get_unshared_boxed( target, tgt_boxed );
+				na_boxed_set_from_boxed( NA_BOXED( tgt_boxed ), NA_BOXED( boxed ));
 			}
-			na_boxed_set_from_boxed( NA_BOXED( tgt_boxed ), NA_BOXED( boxed ));
 		}
 	}
 
@@ -421,6 +461,11 @@ na_factory_object_copy( NAIFactoryObject *target, const NAIFactoryObject *source
  * @a: the first (original) #NAIFactoryObject instance.
  * @b: the second (current) #NAIFactoryObject isntance.
  *
+ * The names of the data which differ between @b and its origin @a are
+ * recorded on @b. Only the data which have been set since the last
+ * check are so compared again, unless @a happens to be a new origin,
+ * or to have been itself modified.
+ *
  * Returns: %TRUE if @a is equal to @b, %FALSE else.
  */
 gboolean
@@ -429,54 +474,101 @@ na_factory_object_are_equal( const NAIFactoryObject *a, const NAIFactoryObject *
 	static const gchar *thisfn = "na_factory_object_are_equal";
 	gboolean are_equal;
 	GList *a_list, *b_list, *ia, *ib;
-
-	are_equal = FALSE;
+	NafoStatus *status;
+	guint a_count, a_serial, b_count, b_serial;
+	gboolean full_check;
 
 	a_list = g_object_get_data( G_OBJECT( a ), NA_IFACTORY_OBJECT_PROP_DATA );
 	b_list = g_object_get_data( G_OBJECT( b ), NA_IFACTORY_OBJECT_PROP_DATA );
 
-	g_debug( "%s: a=%p, b=%p", thisfn, ( void * ) a, ( void * ) b );
+	status = get_status( b );
+	a_serial = get_greatest_serial( a_list, &a_count );
+	b_serial = get_greatest_serial( b_list, &b_count );
 
-	are_equal = TRUE;
-	for( ia = a_list ; ia && are_equal ; ia = ia->next ){
+	full_check = ( status->origin != a ||
+			status->origin_count != a_count ||
+			status->origin_serial != a_serial ||
+			status->count != b_count );
 
-		NADataBoxed *a_boxed = NA_DATA_BOXED( ia->data );
-		const NADataDef *a_def = na_data_boxed_get_data_def( a_boxed );
-		if( a_def->comparable ){
+	g_debug( "%s: a=%p, b=%p, full_check=%s",
+			thisfn, ( void * ) a, ( void * ) b, full_check ? "True":"False" );
 
-			NADataBoxed *b_boxed = na_ifactory_object_get_data_boxed( b, a_def->name );
-			if( b_boxed ){
-				are_equal = na_boxed_are_equal( NA_BOXED( a_boxed ), NA_BOXED( b_boxed ));
-				if( !are_equal ){
-					g_debug( "%s: %s not equal as %s different", thisfn, G_OBJECT_TYPE_NAME( a ), a_def->name );
-				}
+	if( full_check ){
+		g_slist_free( status->differing );
+		status->differing = NULL;
 
-			} else {
-				are_equal = FALSE;
+		for( ib = b_list ; ib ; ib = ib->next ){
+			status->differing = check_data_differ( status->differing, a, NA_DATA_BOXED( ib->data ));
+		}
+
+		for( ia = a_list ; ia ; ia = ia->next ){
+			NADataBoxed *a_boxed = NA_DATA_BOXED( ia->data );
+			const NADataDef *a_def = na_data_boxed_get_data_def( a_boxed );
+			if( a_def->comparable && !na_ifactory_object_get_data_boxed( b, a_def->name )){
 				g_debug( "%s: %s not equal as %s has disappeared", thisfn, G_OBJECT_TYPE_NAME( a ), a_def->name );
+				status->differing = g_slist_prepend( status->differing, ( gpointer ) a_def->name );
 			}
 		}
-	}
-
-	for( ib = b_list ; ib && are_equal ; ib = ib->next ){
-
-		NADataBoxed *b_boxed = NA_DATA_BOXED( ib->data );
-		const NADataDef *b_def = na_data_boxed_get_data_def( b_boxed );
-		if( b_def->comparable ){
 
-			NADataBoxed *a_boxed = na_ifactory_object_get_data_boxed( a, b_def->name );
-			if( !a_boxed ){
-				are_equal = FALSE;
-				g_debug( "%s: %s not equal as %s was not set", thisfn, G_OBJECT_TYPE_NAME( a ), b_def->name );
+	} else {
+		for( ib = b_list ; ib ; ib = ib->next ){
+			if( na_boxed_get_serial( NA_BOXED( ib->data )) > status->serial ){
+				status->differing = check_data_differ( status->differing, a, NA_DATA_BOXED( ib->data ));
 			}
 		}
 	}
 
+	status->origin = a;
+	status->origin_count = a_count;
+	status->origin_serial = a_serial;
+	status->count = b_count;
+	status->serial = b_serial;
+
+	are_equal = ( status->differing == NULL );
+
 	are_equal &= v_are_equal( a, b );
 
 	return( are_equal );
 }
 
+/*
+ * compare the @b_boxed data with the same in @a, updating accordingly
+ * the list of the names of the differing data
+ */
+static GSList *
+check_data_differ( GSList *differing, const NAIFactoryObject *a, NADataBoxed *b_boxed )
+{
+	static const gchar *thisfn = "na_factory_object_check_data_differ";
+	const NADataDef *b_def;
+	NADataBoxed *a_boxed;
+	gboolean are_equal;
+
+	b_def = na_data_boxed_get_data_def( b_boxed );
+
+	if( b_def->comparable ){
+		differing = g_slist_remove( differing, b_def->name );
+		a_boxed = na_ifactory_object_get_data_boxed( a, b_def->name );
+
+		if( a_boxed ){
+			are_equal = ( a_boxed == b_boxed ||
+					na_boxed_are_equal( NA_BOXED( a_boxed ), NA_BOXED( b_boxed )));
+			if( !are_equal ){
+				g_debug( "%s: %s not equal as %s different", thisfn, G_OBJECT_TYPE_NAME( a ), b_def->name );
+			}
+
+		} else {
+			are_equal = FALSE;
+			g_debug( "%s: %s not equal as %s was not set", thisfn, G_OBJECT_TYPE_NAME( a ), b_def->name );
+		}
+
+		if( !are_equal ){
+			differing = g_slist_prepend( differing, ( gpointer ) b_def->name );
+		}
+	}
+
+	return( differing );
+}
+
 /*
  * na_factory_object_is_valid:
  * @object: the #NAIFactoryObject instance whose validity is to be checked.
@@ -490,6 +582,8 @@ na_factory_object_is_valid( const NAIFactoryObject *object )
 	gboolean is_valid;
 	NADataGroup *groups;
 	GList *list, *iv;
+	NafoStatus *status;
+	guint count, serial;
 
 	g_return_val_if_fail( NA_IS_IFACTORY_OBJECT( object ), FALSE );
 
@@ -498,20 +592,39 @@ na_factory_object_is_valid( const NAIFactoryObject *object )
 	list = g_object_get_data( G_OBJECT( object ), NA_IFACTORY_OBJECT_PROP_DATA );
 	is_valid = TRUE;
 
-	/* mandatory data must be set
+	/* the validity of the data only has to be checked again when some
+	 * of them have been set, attached or detached since the last check
 	 */
-	NafoValidIter iter_data;
-	iter_data.object = ( NAIFactoryObject * ) object;
-	iter_data.is_valid = TRUE;
+	status = get_status( object );
+	serial = get_greatest_serial( list, &count );
 
-	groups = v_get_groups( object );
-	if( groups ){
-		iter_on_data_defs( groups, DATA_DEF_ITER_IS_VALID, ( NADataDefIterFunc ) is_valid_mandatory_iter, &iter_data );
-	}
-	is_valid = iter_data.is_valid;
+	if( status->valid_checked &&
+		status->valid_count == count &&
+		status->valid_serial == serial ){
+
+		is_valid = status->valid;
 
-	for( iv = list ; iv && is_valid ; iv = iv->next ){
-		is_valid = na_data_boxed_is_valid( NA_DATA_BOXED( iv->data ));
+	} else {
+		/* mandatory data must be set
+		 */
+		NafoValidIter iter_data;
+		iter_data.object = ( NAIFactoryObject * ) object;
+		iter_data.is_valid = TRUE;
+
+		groups = v_get_groups( object );
+		if( groups ){
+			iter_on_data_defs( groups, DATA_DEF_ITER_IS_VALID, ( NADataDefIterFunc ) is_valid_mandatory_iter, &iter_data );
+		}
+		is_valid = iter_data.is_valid;
+
+		for( iv = list ; iv && is_valid ; iv = iv->next ){
+			is_valid = na_data_boxed_is_valid( NA_DATA_BOXED( iv->data ));
+		}
+
+		status->valid_checked = TRUE;
+		status->valid_count = count;
+		status->valid_serial = serial;
+		status->valid = is_valid;
 	}
 
 	is_valid &= v_is_valid( object );
@@ -639,6 +752,7 @@ read_data_iter( NADataDef *def, NafoReadIter *iter )
 		NADataBoxed *exist = na_ifactory_object_get_data_boxed( iter->object, def->name );
 
 		if( exist ){
+			exist = get_unshared_boxed( iter->object, exist );
 			na_boxed_set_from_boxed( NA_BOXED( exist ), NA_BOXED( boxed ));
 			g_object_unref( boxed );
 
@@ -814,6 +928,7 @@ na_factory_object_set_from_value( NAIFactoryObject *object, const gchar *name, c
 
 	NADataBoxed *boxed = na_ifactory_object_get_data_boxed( object, name );
 	if( boxed ){
+		boxed = get_unshared_boxed( object, boxed );
 		na_boxed_set_from_value( NA_BOXED( boxed ), value );
 
 	} else {
@@ -846,6 +961,7 @@ na_factory_object_set_from_void( NAIFactoryObject *object, const gchar *name, co
 
 	NADataBoxed *boxed = na_ifactory_object_get_data_boxed( object, name );
 	if( boxed ){
+		boxed = get_unshared_boxed( object, boxed );
 		na_boxed_set_from_void( NA_BOXED( boxed ), data );
 
 	} else {
@@ -947,6 +1063,65 @@ attach_boxed_to_object( NAIFactoryObject *object, NADataBoxed *boxed )
 	g_object_set_data( G_OBJECT( object ), NA_IFACTORY_OBJECT_PROP_DATA, list );
 }
 
+/*
+ * a box which is held by more than one object (i.e. which is shared
+ * between an object and its duplicates) is replaced in the list of
+ * @object by a private copy, before being updated
+ *
+ * Returns: the #NADataBoxed which may be safely updated.
+ */
+static NADataBoxed *
+get_unshared_boxed( const NAIFactoryObject *object, NADataBoxed *boxed )
+{
+	GList *list, *it;
+	NADataBoxed *copy;
+
+	if( GPOINTER_TO_UINT( g_object_get_data( G_OBJECT( boxed ), NA_IFACTORY_OBJECT_BOXED_SHARERS ))){
+		list = g_object_get_data( G_OBJECT( object ), NA_IFACTORY_OBJECT_PROP_DATA );
+		it = g_list_find( list, boxed );
+
+		if( it ){
+			copy = na_data_boxed_new( na_data_boxed_get_data_def( boxed ));
+			na_boxed_set_from_boxed( NA_BOXED( copy ), NA_BOXED( boxed ));
+			it->data = copy;
+			release_boxed( boxed );
+			boxed = copy;
+		}
+	}
+
+	return( boxed );
+}
+
+/*
+ * the box is about to be held by one more object
+ */
+static NADataBoxed *
+share_boxed( NADataBoxed *boxed )
+{
+	guint sharers;
+
+	sharers = GPOINTER_TO_UINT( g_object_get_data( G_OBJECT( boxed ), NA_IFACTORY_OBJECT_BOXED_SHARERS ));
+	g_object_set_data( G_OBJECT( boxed ), NA_IFACTORY_OBJECT_BOXED_SHARERS, GUINT_TO_POINTER( sharers+1 ));
+
+	return( g_object_ref( boxed ));
+}
+
+/*
+ * the box is no more held by one of its objects
+ */
+static void
+release_boxed( NADataBoxed *boxed )
+{
+	guint sharers;
+
+	sharers = GPOINTER_TO_UINT( g_object_get_data( G_OBJECT( boxed ), NA_IFACTORY_OBJECT_BOXED_SHARERS ));
+	if( sharers ){
+		g_object_set_data( G_OBJECT( boxed ), NA_IFACTORY_OBJECT_BOXED_SHARERS, GUINT_TO_POINTER( sharers-1 ));
+	}
+
+	g_object_unref( boxed );
+}
+
 static void
 free_data_boxed_list( NAIFactoryObject *object )
 {
@@ -954,12 +1129,58 @@ free_data_boxed_list( NAIFactoryObject *object )
 
 	list = g_object_get_data( G_OBJECT( object ), NA_IFACTORY_OBJECT_PROP_DATA );
 
-	g_list_foreach( list, ( GFunc ) g_object_unref, NULL );
+	g_list_foreach( list, ( GFunc ) release_boxed, NULL );
 	g_list_free( list );
 
 	g_object_set_data( G_OBJECT( object ), NA_IFACTORY_OBJECT_PROP_DATA, NULL );
 }
 
+static NafoStatus *
+get_status( const NAIFactoryObject *object )
+{
+	NafoStatus *status;
+
+	status = ( NafoStatus * ) g_object_get_data( G_OBJECT( object ), NA_IFACTORY_OBJECT_PROP_STATUS );
+
+	if( !status ){
+		status = g_new0( NafoStatus, 1 );
+		g_object_set_data_full( G_OBJECT( object ), NA_IFACTORY_OBJECT_PROP_STATUS, status, ( GDestroyNotify ) free_status );
+	}
+
+	return( status );
+}
+
+static void
+free_status( NafoStatus *status )
+{
+	g_slist_free( status->differing );
+	g_free( status );
+}
+
+/*
+ * returns the greatest serial number of the boxes of the list,
+ * setting @count to the count of boxes
+ */
+static guint
+get_greatest_serial( GList *list, guint *count )
+{
+	GList *it;
+	guint serial, greatest;
+
+	greatest = 0;
+	*count = 0;
+
+	for( it = list ; it ; it = it->next ){
+		serial = na_boxed_get_serial( NA_BOXED( it->data ));
+		if( serial > greatest ){
+			greatest = serial;
+		}
+		*count += 1;
+	}
+
+	return( greatest );
+}
+
 /*
  * the iter function must return TRUE to stops the enumeration
  */
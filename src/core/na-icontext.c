@@ -228,18 +228,48 @@ na_icontext_is_candidate( const NAIContext *context, guint target, GList *select
 	g_debug( "%s: object=%p (%s), target=%d, selection=%p (count=%d)",
 			thisfn, ( void * ) context, G_OBJECT_TYPE_NAME( context ), target, (void * ) selection, g_list_length( selection ));
 
+	is_candidate =
+			na_icontext_is_candidate_static( context, target, selection ) &&
+			na_icontext_is_candidate_dynamic( context, target, selection );
+
+	return( is_candidate );
+}
+
+/**
+ * na_icontext_is_candidate_static:
+ * @context: a #NAIContext to be checked.
+ * @target: the current target.
+ * @selection: the currently selected items, as a #GList of NASelectedInfo items.
+ *
+ * Only checks the conditions whose the result only depends on the
+ * target and on the properties of the selected items which are taken
+ * into account by the selection signature (see the menu plugin), i.e.
+ * the count of selected items, their mimetypes, schemes, dirnames and
+ * capabilities.
+ *
+ * The result of this function may so be safely cached by the caller
+ * for a given selection signature, as long as the items are not
+ * reloaded.
+ *
+ * Returns: %TRUE if this @context succeeds to all static tests, %FALSE
+ * else.
+ *
+ * Since: 3.2.5
+ */
+gboolean
+na_icontext_is_candidate_static( const NAIContext *context, guint target, GList *selection )
+{
+	gboolean is_candidate;
+
+	g_return_val_if_fail( NA_IS_ICONTEXT( context ), FALSE );
+
 	is_candidate = v_is_candidate( NA_ICONTEXT( context ), target, selection );
 
 	if( is_candidate ){
 		is_candidate =
 				is_candidate_for_target( context, target, selection ) &&
 				is_candidate_for_show_in( context, target, selection ) &&
-				is_candidate_for_try_exec( context, target, selection ) &&
-				is_candidate_for_show_if_registered( context, target, selection ) &&
-				is_candidate_for_show_if_true( context, target, selection ) &&
-				is_candidate_for_show_if_running( context, target, selection ) &&
 				is_candidate_for_mimetypes( context, target, selection ) &&
-				is_candidate_for_basenames( context, target, selection ) &&
 				is_candidate_for_selection_count( context, target, selection ) &&
 				is_candidate_for_schemes( context, target, selection ) &&
 				is_candidate_for_folders( context, target, selection ) &&
@@ -249,6 +279,39 @@ na_icontext_is_candidate( const NAIContext *context, guint target, GList *select
 	return( is_candidate );
 }
 
+/**
+ * na_icontext_is_candidate_dynamic:
+ * @context: a #NAIContext to be checked.
+ * @target: the current target.
+ * @selection: the currently selected items, as a #GList of NASelectedInfo items.
+ *
+ * Checks the conditions which have to be re-evaluated each time the
+ * menu is displayed: these depend either on the runtime environment
+ * (TryExec, ShowIfRegistered, ShowIfTrue, ShowIfRunning), or on the
+ * full basenames of the selected items.
+ *
+ * Returns: %TRUE if this @context succeeds to all dynamic tests, %FALSE
+ * else.
+ *
+ * Since: 3.2.5
+ */
+gboolean
+na_icontext_is_candidate_dynamic( const NAIContext *context, guint target, GList *selection )
+{
+	gboolean is_candidate;
+
+	g_return_val_if_fail( NA_IS_ICONTEXT( context ), FALSE );
+
+	is_candidate =
+			is_candidate_for_basenames( context, target, selection ) &&
+			is_candidate_for_try_exec( context, target, selection ) &&
+			is_candidate_for_show_if_registered( context, target, selection ) &&
+			is_candidate_for_show_if_true( context, target, selection ) &&
+			is_candidate_for_show_if_running( context, target, selection );
+
+	return( is_candidate );
+}
+
 /**
  * na_icontext_is_valid:
  * @context: the #NAIContext to be checked.
@@ -51,6 +51,66 @@ typedef struct {
 }
 	NAImportModeStr;
 
+/* an imported file, which may be read ahead of its import by a worker
+ * thread; the members are protected by the pipeline mutex until 'done'
+ * is set
+ */
+typedef struct {
+	const gchar *uri;
+	gchar       *data;
+	gsize        length;
+	gboolean     done;
+}
+	ImportPrefetch;
+
+typedef struct {
+	GThreadPool *pool;
+	GMutex      *mutex;
+	GCond       *cond;
+}
+	ImportPipeline;
+
+/* the state of the duplicates check during an import operation
+ */
+typedef struct {
+	GHashTable  *imported;				/* id -> already checked imported item */
+	GHashTable  *existing;				/* the index provided by the caller, if any */
+	gboolean     index_requested;
+}
+	ImportCheck;
+
+/* the kind of content of an imported file, as sniffed from its first bytes
+ */
+enum {
+	CONTENT_KIND_UNKNOWN = 0,
+	CONTENT_KIND_XML,
+	CONTENT_KIND_TEXT,
+	CONTENT_KIND_N
+};
+
+/* an import operation, which may be run by chunks of uris
+ */
+struct _NAImporterJob {
+	const NAPivot          *pivot;
+	NAImporterParms        *parms;
+	GList                  *modules;
+	NAIImporter            *dispatch[CONTENT_KIND_N];
+	ImportPrefetch         *prefetch;
+	guint                   count;
+	guint                   next;
+	ImportPipeline          pipeline;
+	gboolean                threaded;
+	ImportCheck             check;
+	NAImporterAskUserParms  ask_parms;
+	GList                  *results;
+};
+
+/* how many files are read at the same time, and how many files may be
+ * read in advance of the one being currently imported
+ */
+#define PREFETCH_THREADS				4
+#define PREFETCH_WINDOW					64
+
 static NAImportModeStr st_import_modes[] = {
 
 	{ IMPORTER_MODE_NO_IMPORT,
@@ -89,9 +149,16 @@ static NAImportModeStr st_import_ask_mode = {
 			"import-mode-ask.png"
 };
 
-static NAImporterResult *import_from_uri( const NAPivot *pivot, GList *modules, const gchar *uri );
-static void              manage_import_mode( NAImporterParms *parms, GList *results, NAImporterAskUserParms *ask_parms, NAImporterResult *result );
-static NAObjectItem     *is_importing_already_exists( NAImporterParms *parms, GList *results, NAImporterResult *result );
+static gboolean          pipeline_init( ImportPipeline *pipeline );
+static void              pipeline_wait( ImportPipeline *pipeline, ImportPrefetch *prefetch );
+static void              pipeline_free( ImportPipeline *pipeline );
+static void              prefetch_worker( ImportPrefetch *prefetch, ImportPipeline *pipeline );
+static gchar            *prefetch_load( const gchar *uri, gsize *length );
+static GList            *import_from_uri( const NAPivot *pivot, GList *modules, NAIImporter **dispatch, ImportPrefetch *prefetch );
+static guint             sniff_content( const gchar *data, gsize length );
+static void              manage_import_mode( NAImporterParms *parms, ImportCheck *check, NAImporterAskUserParms *ask_parms, NAImporterResult *result );
+static NAObjectItem     *is_importing_already_exists( NAImporterParms *parms, ImportCheck *check, NAImporterResult *result );
+static void              check_add_imported( ImportCheck *check, NAImporterResult *result );
 static void              renumber_label_item( NAObjectItem *item );
 static guint             ask_user_for_mode( const NAObjectItem *importing, const NAObjectItem *existing, NAImporterAskUserParms *parms );
 static guint             get_id_from_string( const gchar *str );
@@ -129,38 +196,73 @@ GList *
 na_importer_import_from_uris( const NAPivot *pivot, NAImporterParms *parms )
 {
 	static const gchar *thisfn = "na_importer_import_from_uris";
-	GList *results, *ires;
-	GList *modules;
+	NAImporterJob *job;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+	g_return_val_if_fail( parms != NULL, NULL );
+
+	g_debug( "%s: pivot=%p, parms=%p", thisfn, ( void * ) pivot, ( void * ) parms );
+
+	job = na_importer_job_new( pivot, parms );
+
+	while( na_importer_job_step( job, G_MAXUINT ))
+		;
+
+	return( na_importer_job_free( job ));
+}
+
+/*
+ * na_importer_job_new:
+ * @pivot: the #NAPivot pivot for this application.
+ * @parms: a #NAImporterParms structure, which must stay valid until the
+ *  job is released.
+ *
+ * Prepares the import of the #parms.uris list of URIs, which will be
+ * actually run by successive calls to na_importer_job_step(), e.g. from
+ * an idle callback of the caller.
+ *
+ * Returns: a newly allocated #NAImporterJob, to be released with
+ * na_importer_job_free().
+ *
+ * Since: 3.2.5
+ */
+NAImporterJob *
+na_importer_job_new( const NAPivot *pivot, NAImporterParms *parms )
+{
+	static const gchar *thisfn = "na_importer_job_new";
+	NAImporterJob *job;
 	GSList *uri;
-	NAImporterResult *import_result;
-	NAImporterAskUserParms ask_parms;
 	gchar *mode_str;
+	guint i;
 
 	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
 	g_return_val_if_fail( parms != NULL, NULL );
 
-	results = NULL;
-
-	g_debug( "%s: pivot=%p, parms=%p", thisfn, ( void * ) pivot, ( void * ) parms );
+	job = g_new0( NAImporterJob, 1 );
+	job->pivot = pivot;
+	job->parms = parms;
+	job->modules = na_pivot_get_providers( pivot, NA_TYPE_IIMPORTER );
 
-	/* first phase: just try to import the uris into memory
+	/* files are read ahead by a pool of worker threads, while they are
+	 * parsed in the thread of the caller, in the order of the uris, as
+	 * the importers are not expected to be thread-safe
 	 */
-	modules = na_pivot_get_providers( pivot, NA_TYPE_IIMPORTER );
-
-	for( uri = parms->uris ; uri ; uri = uri->next ){
-		import_result = import_from_uri( pivot, modules, ( const gchar * ) uri->data );
-		results = g_list_prepend( results, import_result );
+	job->count = g_slist_length( parms->uris );
+	job->prefetch = g_new0( ImportPrefetch, job->count );
+	for( uri = parms->uris, i = 0 ; uri ; uri = uri->next, ++i ){
+		job->prefetch[i].uri = ( const gchar * ) uri->data;
 	}
 
-	na_pivot_free_providers( modules );
+	job->threaded = ( job->count > 1 && pipeline_init( &job->pipeline ));
 
-	results = g_list_reverse( results );
+	for( i = 0 ; job->threaded && i < job->count && i < PREFETCH_WINDOW ; ++i ){
+		g_thread_pool_push( job->pipeline.pool, &job->prefetch[i], NULL );
+	}
 
-	memset( &ask_parms, '\0', sizeof( NAImporterAskUserParms ));
-	ask_parms.parent = parms->parent_toplevel;
-	ask_parms.count = 0;
-	ask_parms.keep_choice = FALSE;
-	ask_parms.pivot = pivot;
+	job->ask_parms.parent = parms->parent_toplevel;
+	job->ask_parms.count = 0;
+	job->ask_parms.keep_choice = FALSE;
+	job->ask_parms.pivot = pivot;
 
 	/* set the default import mode
 	 */
@@ -170,23 +272,262 @@ na_importer_import_from_uris( const NAPivot *pivot, NAImporterParms *parms )
 		g_free( mode_str );
 	}
 
-	/* second phase: check for their pre-existence
-	 */
-	for( ires = results ; ires ; ires = ires->next ){
-		import_result = ( NAImporterResult * ) ires->data;
+	job->check.imported = g_hash_table_new_full( g_str_hash, g_str_equal, ( GDestroyNotify ) g_free, NULL );
+	job->check.existing = NULL;
+	job->check.index_requested = FALSE;
+
+	g_debug( "%s: job=%p, count=%u, threaded=%s",
+			thisfn, ( void * ) job, job->count, job->threaded ? "True":"False" );
+
+	return( job );
+}
+
+/*
+ * na_importer_job_step:
+ * @job: a #NAImporterJob.
+ * @count: the maximum count of URIs to be imported.
+ *
+ * Imports the next @count URIs of the job.
+ *
+ * Each URI is first imported into memory; the imported item is then
+ * checked for its pre-existence, which may be an interactive process
+ * depending of the preferred import mode.
+ *
+ * Returns: %TRUE if there is still some URIs to be imported,
+ * %FALSE when the job is done.
+ *
+ * Since: 3.2.5
+ */
+gboolean
+na_importer_job_step( NAImporterJob *job, guint count )
+{
+	GList *ires, *uri_results;
+	NAImporterResult *import_result;
+	ImportPrefetch *prefetch;
+	guint i;
 
-		if( import_result->imported ){
-			g_return_val_if_fail( NA_IS_OBJECT_ITEM( import_result->imported ), NULL );
-			g_return_val_if_fail( NA_IS_IIMPORTER( import_result->importer ), NULL );
+	g_return_val_if_fail( job != NULL, FALSE );
 
-			ask_parms.uri = import_result->uri;
-			manage_import_mode( parms, results, &ask_parms, import_result );
+	for( i = 0 ; i < count && job->next < job->count ; ++i, ++job->next ){
+		prefetch = &job->prefetch[job->next];
+
+		if( job->threaded ){
+			if( job->next + PREFETCH_WINDOW < job->count ){
+				g_thread_pool_push( job->pipeline.pool, &job->prefetch[job->next+PREFETCH_WINDOW], NULL );
+			}
+			pipeline_wait( &job->pipeline, prefetch );
+
+		} else {
+			prefetch->data = prefetch_load( prefetch->uri, &prefetch->length );
 		}
+
+		/* first phase: just try to import the uri into memory
+		 */
+		uri_results = import_from_uri( job->pivot, job->modules, job->dispatch, prefetch );
+
+		g_free( prefetch->data );
+		prefetch->data = NULL;
+
+		/* second phase: check for the pre-existence of the imported items
+		 */
+		for( ires = uri_results ; ires ; ires = ires->next ){
+			import_result = ( NAImporterResult * ) ires->data;
+
+			if( import_result->imported ){
+				g_warn_if_fail( NA_IS_OBJECT_ITEM( import_result->imported ));
+				g_warn_if_fail( NA_IS_IIMPORTER( import_result->importer ));
+
+				job->ask_parms.uri = import_result->uri;
+				manage_import_mode( job->parms, &job->check, &job->ask_parms, import_result );
+				check_add_imported( &job->check, import_result );
+			}
+
+			job->results = g_list_prepend( job->results, import_result );
+		}
+
+		g_list_free( uri_results );
 	}
 
+	return( job->next < job->count );
+}
+
+/*
+ * na_importer_job_get_progress:
+ * @job: a #NAImporterJob.
+ * @done: [out]: set to the count of already imported URIs.
+ * @total: [out]: set to the total count of URIs to be imported.
+ *
+ * Since: 3.2.5
+ */
+void
+na_importer_job_get_progress( const NAImporterJob *job, guint *done, guint *total )
+{
+	g_return_if_fail( job != NULL );
+
+	if( done ){
+		*done = job->next;
+	}
+	if( total ){
+		*total = job->count;
+	}
+}
+
+/*
+ * na_importer_job_free:
+ * @job: a #NAImporterJob.
+ *
+ * Releases the job. If it was not done, the URIs which have not been
+ * imported yet are just ignored: this is how an import is cancelled.
+ *
+ * Returns: a #GList of #NAImporterResult structures, for the URIs which
+ * have been imported, in the same order.
+ *
+ * Since: 3.2.5
+ */
+GList *
+na_importer_job_free( NAImporterJob *job )
+{
+	static const gchar *thisfn = "na_importer_job_free";
+	GList *results;
+	guint i;
+
+	g_return_val_if_fail( job != NULL, NULL );
+
+	g_debug( "%s: job=%p, imported=%u/%u", thisfn, ( void * ) job, job->next, job->count );
+
+	if( job->threaded ){
+		pipeline_free( &job->pipeline );
+	}
+
+	/* files which have been read in advance but not imported
+	 */
+	for( i = job->next ; i < job->count ; ++i ){
+		g_free( job->prefetch[i].data );
+	}
+
+	g_free( job->prefetch );
+	na_pivot_free_providers( job->modules );
+
+	g_hash_table_destroy( job->check.imported );
+	if( job->check.existing ){
+		g_hash_table_destroy( job->check.existing );
+	}
+
+	results = g_list_reverse( job->results );
+	g_free( job );
+
 	return( results );
 }
 
+/*
+ * threads are only used if they have been initialized by the application
+ * (which is always the case starting with GLib 2.32)
+ */
+static gboolean
+pipeline_init( ImportPipeline *pipeline )
+{
+	static const gchar *thisfn = "na_importer_pipeline_init";
+	GError *error;
+
+#if !GLIB_CHECK_VERSION( 2, 32, 0 )
+	if( !g_thread_supported()){
+		return( FALSE );
+	}
+	pipeline->mutex = g_mutex_new();
+	pipeline->cond = g_cond_new();
+#else
+	pipeline->mutex = g_new0( GMutex, 1 );
+	g_mutex_init( pipeline->mutex );
+	pipeline->cond = g_new0( GCond, 1 );
+	g_cond_init( pipeline->cond );
+#endif
+
+	error = NULL;
+	pipeline->pool = g_thread_pool_new(( GFunc ) prefetch_worker, pipeline, PREFETCH_THREADS, FALSE, &error );
+
+	if( !pipeline->pool ){
+		g_warning( "%s: %s", thisfn, error ? error->message : "(null)" );
+		if( error ){
+			g_error_free( error );
+		}
+		pipeline_free( pipeline );
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+static void
+pipeline_wait( ImportPipeline *pipeline, ImportPrefetch *prefetch )
+{
+	g_mutex_lock( pipeline->mutex );
+	while( !prefetch->done ){
+		g_cond_wait( pipeline->cond, pipeline->mutex );
+	}
+	g_mutex_unlock( pipeline->mutex );
+}
+
+/*
+ * when the job is cancelled, the files which are still queued are not
+ * read, while we wait for the end of the running tasks
+ */
+static void
+pipeline_free( ImportPipeline *pipeline )
+{
+	if( pipeline->pool ){
+		g_thread_pool_free( pipeline->pool, TRUE, TRUE );
+		pipeline->pool = NULL;
+	}
+
+#if !GLIB_CHECK_VERSION( 2, 32, 0 )
+	g_cond_free( pipeline->cond );
+	g_mutex_free( pipeline->mutex );
+#else
+	g_cond_clear( pipeline->cond );
+	g_free( pipeline->cond );
+	g_mutex_clear( pipeline->mutex );
+	g_free( pipeline->mutex );
+#endif
+}
+
+/*
+ * run in a worker thread: only GIO is used here
+ */
+static void
+prefetch_worker( ImportPrefetch *prefetch, ImportPipeline *pipeline )
+{
+	gchar *data;
+	gsize length;
+
+	data = prefetch_load( prefetch->uri, &length );
+
+	g_mutex_lock( pipeline->mutex );
+	prefetch->data = data;
+	prefetch->length = length;
+	prefetch->done = TRUE;
+	g_cond_broadcast( pipeline->cond );
+	g_mutex_unlock( pipeline->mutex );
+}
+
+/*
+ * too big files are not preloaded, and importers are left free to
+ * stream them if they are able to
+ */
+static gchar *
+prefetch_load( const gchar *uri, gsize *length )
+{
+	gchar *data;
+
+	data = NULL;
+	*length = 0;
+
+	if( na_core_utils_file_is_loadable( uri )){
+		data = na_core_utils_file_load_from_uri( uri, length );
+	}
+
+	return( data );
+}
+
 /*
  * na_importer_free_result:
  * @result: the #NAImporterResult structure to be released.
@@ -211,28 +552,51 @@ na_importer_free_result( NAImporterResult *result )
  * We so let each interface push its messages in the list, but be ready to
  * only keep the messages provided by the interface which has successfully
  * imported the item.
+ *
+ * An URI may contain several items: we return one #NAImporterResult for
+ * each of them, the messages being attached to the first one.
+ *
+ * The file has been read only once (see prefetch_load()), and its content
+ * is handed to each interface, so that they do not have to read it again. Its kind is
+ * sniffed from its first bytes; @dispatch remembers which interface has
+ * accepted a content of each kind, and this one is asked first for the
+ * next files of the same kind, so that the others are only tried when
+ * it is not willing to import the file.
  */
-static NAImporterResult *
-import_from_uri( const NAPivot *pivot, GList *modules, const gchar *uri )
+static GList *
+import_from_uri( const NAPivot *pivot, GList *modules, NAIImporter **dispatch, ImportPrefetch *prefetch )
 {
+	GList *results;
 	NAImporterResult *result;
 	NAIImporterImportFromUriParmsv2 provider_parms;
-	GList *im;
+	GList *order, *im, *it;
 	guint code;
 	GSList *all_messages;
 	NAIImporter *provider;
+	const gchar *uri;
+	guint kind;
 
 	result = NULL;
 	all_messages = NULL;
 	provider = NULL;
 	code = IMPORTER_CODE_NOT_WILLING_TO;
+	uri = prefetch->uri;
+	kind = sniff_content( prefetch->data, prefetch->length );
+
+	order = g_list_copy( modules );
+	if( dispatch[kind] && g_list_find( order, dispatch[kind] )){
+		order = g_list_remove( order, dispatch[kind] );
+		order = g_list_prepend( order, dispatch[kind] );
+	}
 
 	memset( &provider_parms, '\0', sizeof( NAIImporterImportFromUriParmsv2 ));
 	provider_parms.version = 2;
-	provider_parms.content = 1;
+	provider_parms.content = 3;
 	provider_parms.uri = uri;
+	provider_parms.data = prefetch->data;
+	provider_parms.length = prefetch->length;
 
-	for( im = modules ;
+	for( im = order ;
 			im && ( code == IMPORTER_CODE_NOT_WILLING_TO || code == IMPORTER_CODE_NOT_LOADABLE ) ;
 			im = im->next ){
 
@@ -256,13 +620,53 @@ import_from_uri( const NAPivot *pivot, GList *modules, const gchar *uri )
 		}
 	}
 
+	if( provider && kind != CONTENT_KIND_UNKNOWN ){
+		dispatch[kind] = provider;
+	}
+
+	g_list_free( order );
+
 	result = g_new0( NAImporterResult, 1 );
 	result->uri = g_strdup( uri );
 	result->imported = provider_parms.imported;
 	result->importer = provider;
 	result->messages = all_messages;
+	results = g_list_prepend( NULL, result );
+
+	for( it = provider_parms.more_imported ; it ; it = it->next ){
+		result = g_new0( NAImporterResult, 1 );
+		result->uri = g_strdup( uri );
+		result->imported = NA_OBJECT_ITEM( it->data );
+		result->importer = provider;
+		results = g_list_prepend( results, result );
+	}
+
+	g_list_free( provider_parms.more_imported );
+
+	return( g_list_reverse( results ));
+}
+
+/*
+ * only distinguish between XML documents and other text files (e.g.
+ * .desktop key files), after having skipped an eventual UTF-8 byte order
+ * mark and leading spaces
+ */
+static guint
+sniff_content( const gchar *data, gsize length )
+{
+	gsize i;
+
+	if( !data || !length ){
+		return( CONTENT_KIND_UNKNOWN );
+	}
+
+	i = na_core_utils_str_skip_bom_and_spaces( data, length );
+
+	if( i == length ){
+		return( CONTENT_KIND_UNKNOWN );
+	}
 
-	return( result );
+	return( data[i] == '<' ? CONTENT_KIND_XML : CONTENT_KIND_TEXT );
 }
 
 /*
@@ -270,7 +674,7 @@ import_from_uri( const NAPivot *pivot, GList *modules, const gchar *uri )
  * ask for the user if needed
  */
 static void
-manage_import_mode( NAImporterParms *parms, GList *results, NAImporterAskUserParms *ask_parms, NAImporterResult *result )
+manage_import_mode( NAImporterParms *parms, ImportCheck *check, NAImporterAskUserParms *ask_parms, NAImporterResult *result )
 {
 	static const gchar *thisfn = "na_importer_manage_import_mode";
 	NAObjectItem *exists;
@@ -285,7 +689,7 @@ manage_import_mode( NAImporterParms *parms, GList *results, NAImporterAskUserPar
 	/* if no check function is provided, then we systematically allocate
 	 * a new identifier to the imported item
 	 */
-	if( !parms->check_fn ){
+	if( !parms->check_fn && !parms->index_fn ){
 		renumber_label_item( result->imported );
 		na_core_utils_slist_add_message(
 				&result->messages,
@@ -294,7 +698,7 @@ manage_import_mode( NAImporterParms *parms, GList *results, NAImporterAskUserPar
 		result->mode = IMPORTER_MODE_RENUMBER;
 
 	} else {
-		exists = is_importing_already_exists( parms, results, result );
+		exists = is_importing_already_exists( parms, check, result );
 	}
 
 	g_debug( "%s: exists=%p", thisfn, exists );
@@ -358,49 +762,69 @@ manage_import_mode( NAImporterParms *parms, GList *results, NAImporterAskUserPar
 
 /*
  * First check here for duplicates inside of imported population,
- * then delegates to the caller-provided check function the rest of work...
+ * then delegates to the caller-provided index or check function the rest
+ * of work...
  */
 static NAObjectItem *
-is_importing_already_exists( NAImporterParms *parms, GList *results, NAImporterResult *result )
+is_importing_already_exists( NAImporterParms *parms, ImportCheck *check, NAImporterResult *result )
 {
 	static const gchar *thisfn = "na_importer_is_importing_already_exists";
 	NAObjectItem *exists;
-	GList *ip;
-
-	exists = NULL;
+	gchar *importing_id;
 
-	gchar *importing_id = na_object_get_id( result->imported );
+	importing_id = na_object_get_id( result->imported );
 	g_debug( "%s: importing=%p, id=%s", thisfn, ( void * ) result->imported, importing_id );
 
 	/* is the importing item already in the current importation list ?
-	 * (only tries previous items of the list)
+	 * (only previous items of the list have been registered)
 	 */
-	for( ip = results ; ip && !exists && ip->data != result ; ip = ip->next ){
-		NAImporterResult *try_result = ( NAImporterResult * ) ip->data;
+	exists = ( NAObjectItem * ) g_hash_table_lookup( check->imported, importing_id );
 
-		if( try_result->imported ){
-			g_return_val_if_fail( NA_IS_OBJECT_ITEM( try_result->imported ), NULL );
-
-			gchar *id = na_object_get_id( try_result->imported );
-			if( !strcmp( importing_id, id )){
-				exists = NA_OBJECT_ITEM( try_result->imported );
+	/* if not found in our current importation list,
+	 * then check the existence via provided index or function and data
+	 */
+	if( !exists ){
+		if( parms->index_fn ){
+			if( !check->index_requested ){
+				check->existing = parms->index_fn( parms->check_fn_data );
+				check->index_requested = TRUE;
 			}
-			g_free( id );
+			if( check->existing ){
+				exists = ( NAObjectItem * ) g_hash_table_lookup( check->existing, importing_id );
+			}
+
+		} else {
+			exists = parms->check_fn( result->imported, parms->check_fn_data );
 		}
 	}
 
 	g_free( importing_id );
 
-	/* if not found in our current importation list,
-	 * then check the existence via provided function and data
-	 */
-	if( !exists ){
-		exists = parms->check_fn( result->imported, parms->check_fn_data );
-	}
-
 	return( exists );
 }
 
+/*
+ * register the checked item (with its possibly new identifier), so that
+ * the next imported items are checked against it; the first registered
+ * item is kept for a given identifier
+ */
+static void
+check_add_imported( ImportCheck *check, NAImporterResult *result )
+{
+	gchar *id;
+
+	if( result->imported ){
+		id = na_object_get_id( result->imported );
+
+		if( !g_hash_table_lookup( check->imported, id )){
+			g_hash_table_insert( check->imported, id, result->imported );
+
+		} else {
+			g_free( id );
+		}
+	}
+}
+
 /*
  * renumber the item, and set a new label
  */
@@ -53,6 +53,9 @@
  * - last, and depending of the exact individual import mode of each item,
  *   insert new items or override existing ones in the referential of the
  *   import context.
+ *
+ * The two first phases are run URI after URI, so that a long import may
+ * be run by chunks, and cancelled (see na_importer_job_new()).
  */
 
 #include <gtk/gtk.h>
@@ -116,12 +119,33 @@ typedef enum {
  */
 typedef NAObjectItem * ( *NAImporterCheckFn )( const NAObjectItem *, void * );
 
+/*
+ * NAImporterIndexFn:
+ * @fn_data: some data to be passed to the function.
+ *
+ * The caller may provide this function in order to index once its own
+ * import context, instead of checking it for each imported item.
+ *
+ * The function should return a newly allocated #GHashTable whose keys
+ * are the identifiers of the existing items, and whose values are the
+ * corresponding #NAObjectItem -derived objects. The library destroys
+ * the hash table at the end of the import operation.
+ *
+ * When this function is provided, @check_fn is not called.
+ *
+ * Returns: a #GHashTable index of the existing items, or %NULL.
+ *
+ * Since: 3.2.5
+ */
+typedef GHashTable * ( *NAImporterIndexFn )( void * );
+
 typedef struct {
 	GSList             *uris;				/* the list of uris to import */
 	NAImporterCheckFn   check_fn;			/* the check_for_duplicate function */
-	void               *check_fn_data;		/* data to be passed to the check_fn function */
+	void               *check_fn_data;		/* data to be passed to the check_fn and index_fn functions */
 	guint               preferred_mode;		/* preferred import mode, defaults to NA_IPREFS_IMPORT_PREFERRED_MODE */
 	GtkWindow          *parent_toplevel;	/* parent toplevel */
+	NAImporterIndexFn   index_fn;			/* the index_existing function, since 3.2.5 */
 }
 	NAImporterParms;
 
@@ -141,8 +165,15 @@ typedef struct {
 }
 	NAImporterResult;
 
+typedef struct _NAImporterJob NAImporterJob;
+
 GList     *na_importer_import_from_uris( const NAPivot *pivot, NAImporterParms *parms );
 
+NAImporterJob *na_importer_job_new         ( const NAPivot *pivot, NAImporterParms *parms );
+gboolean       na_importer_job_step        ( NAImporterJob *job, guint count );
+void           na_importer_job_get_progress( const NAImporterJob *job, guint *done, guint *total );
+GList         *na_importer_job_free        ( NAImporterJob *job );
+
 void       na_importer_free_result     ( NAImporterResult *result );
 
 GList     *na_importer_get_modes       ( void );
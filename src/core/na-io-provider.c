@@ -1340,6 +1340,86 @@ na_io_provider_duplicate_data( const NAIOProvider *provider, NAObjectItem *dest,
 	return( ret );
 }
 
+/*
+ * na_io_provider_check_items_writability:
+ * @provider: this #NAIOProvider object.
+ * @items: a flat list of #NAObjectItem items read by this @provider.
+ *
+ * Lets the I/O provider set the read-only status of the @items, if it
+ * has chosen to delay this check until it is actually needed.
+ */
+void
+na_io_provider_check_items_writability( const NAIOProvider *provider, GList *items )
+{
+	static const gchar *thisfn = "na_io_provider_check_items_writability";
+
+	g_return_if_fail( NA_IS_IO_PROVIDER( provider ));
+
+	if( !provider->private->dispose_has_run &&
+		provider->private->provider &&
+		NA_IS_IIO_PROVIDER( provider->private->provider ) &&
+		NA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->check_items_writability ){
+
+			g_debug( "%s: provider=%p (%s), count=%d",
+					thisfn, ( void * ) provider, provider->private->id, g_list_length( items ));
+
+			NA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->check_items_writability( provider->private->provider, items );
+	}
+}
+
+/*
+ * na_io_provider_write_batch_begin:
+ * @provider: this #NAIOProvider object.
+ *
+ * Lets the I/O provider know that several items are going to be written.
+ */
+void
+na_io_provider_write_batch_begin( const NAIOProvider *provider )
+{
+	g_return_if_fail( NA_IS_IO_PROVIDER( provider ));
+
+	if( !provider->private->dispose_has_run &&
+		provider->private->provider &&
+		NA_IS_IIO_PROVIDER( provider->private->provider ) &&
+		NA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_batch_begin ){
+
+			NA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_batch_begin( provider->private->provider );
+	}
+}
+
+/*
+ * na_io_provider_write_batch_end:
+ * @provider: this #NAIOProvider object.
+ * @failed: the list of the items which have not been committed.
+ * @messages: error messages.
+ *
+ * Lets the I/O provider commit the items written since
+ * na_io_provider_write_batch_begin().
+ *
+ * Returns: the NAIIOProvider return code.
+ */
+guint
+na_io_provider_write_batch_end( const NAIOProvider *provider, GList **failed, GSList **messages )
+{
+	guint ret;
+
+	ret = NA_IIO_PROVIDER_CODE_PROGRAM_ERROR;
+
+	g_return_val_if_fail( NA_IS_IO_PROVIDER( provider ), ret );
+
+	ret = NA_IIO_PROVIDER_CODE_OK;
+
+	if( !provider->private->dispose_has_run &&
+		provider->private->provider &&
+		NA_IS_IIO_PROVIDER( provider->private->provider ) &&
+		NA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_batch_end ){
+
+			ret = NA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_batch_end( provider->private->provider, failed, messages );
+	}
+
+	return( ret );
+}
+
 /*
  * na_io_provider_get_readonly_tooltip:
  * @reason: the reason for why an item is not writable.
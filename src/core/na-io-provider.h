@@ -112,6 +112,9 @@ GList        *na_io_provider_load_items( const NAPivot *pivot, guint loadable_se
 guint         na_io_provider_write_item    ( const NAIOProvider *provider, const NAObjectItem *item, GSList **messages );
 guint         na_io_provider_delete_item   ( const NAIOProvider *provider, const NAObjectItem *item, GSList **messages );
 guint         na_io_provider_duplicate_data( const NAIOProvider *provider, NAObjectItem *dest, const NAObjectItem *source, GSList **messages );
+void          na_io_provider_check_items_writability( const NAIOProvider *provider, GList *items );
+void          na_io_provider_write_batch_begin      ( const NAIOProvider *provider );
+guint         na_io_provider_write_batch_end        ( const NAIOProvider *provider, GList **failed, GSList **messages );
 
 gchar        *na_io_provider_get_readonly_tooltip ( guint reason );
 gchar        *na_io_provider_get_return_code_label( guint code );
@@ -336,6 +336,7 @@ iduplicable_is_valid( const NAIDuplicable *object )
  *      |       +- v_are_equal( a, b )
  *      |           +- NAObjectAction::are_equal()
  *      |               +- na_factory_object_are_equal()
+ *      |               |  (only compares the data set since last check)
  *      |               +- check NAObjectActionPrivate data
  *      |               +- call parent class
  *      |                  +- NAObjectItem::are_equal()
@@ -346,6 +347,11 @@ iduplicable_is_valid( const NAIDuplicable *object )
  *      +- valid_status = v_is_valid( object )             -> interface <structfield>NAObjectClass::is_valid</structfield>
  * </literallayout>
  *
+ *   Each #NABoxed data is stamped with a new serial number each time it
+ *   is set. The #NAIFactoryObject implementation so only compares again
+ *   with the origin, and only checks again the validity of, the data
+ *   which have been set since the last check.
+ *
  *   Note that the recursivity is managed here, so that we can be sure
  *   that edition status of children is actually checked before those of
  *   the parent.
@@ -39,6 +39,9 @@
 #include "na-io-provider.h"
 #include "na-module.h"
 #include "na-pivot.h"
+#include "na-service.h"
+#include "na-snapshot.h"
+#include "na-settings.h"
 
 /* private class data
  */
@@ -219,7 +222,6 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->change_timeout.timeout = st_burst_timeout;
 	self->private->change_timeout.handler = ( NATimeoutFunc ) on_items_changed_timeout;
 	self->private->change_timeout.user_data = self;
-	self->private->change_timeout.source_id = 0;
 }
 
 static void
@@ -318,6 +320,8 @@ instance_dispose( GObject *object )
 
 		self->private->dispose_has_run = TRUE;
 
+		na_timeout_remove( &self->private->change_timeout );
+
 		/* release modules */
 		na_module_release_modules( self->private->modules );
 		self->private->modules = NULL;
@@ -580,6 +584,87 @@ na_pivot_load_items( NAPivot *pivot )
 	}
 }
 
+/*
+ * na_pivot_load_shared_items:
+ * @pivot: this #NAPivot instance.
+ *
+ * Loads the hierarchical list of items from the shared menu model
+ * service when it is enabled and available on the session bus for our
+ * loadable set, or from I/O providers as a fallback.
+ *
+ * The items got from the service are read-only copies which do not
+ * carry any provider data: this is only suitable for consumers which
+ * do not update the items.
+ */
+void
+na_pivot_load_shared_items( NAPivot *pivot )
+{
+	static const gchar *thisfn = "na_pivot_load_shared_items";
+	GList *tree;
+
+	g_return_if_fail( NA_IS_PIVOT( pivot ));
+
+	if( !pivot->private->dispose_has_run ){
+
+		g_debug( "%s: pivot=%p", thisfn, ( void * ) pivot );
+
+		tree = NULL;
+
+		if( na_settings_get_boolean( NA_IPREFS_ITEMS_SHARED_SERVICE, NULL, NULL )){
+			tree = na_service_load_items( pivot, pivot->private->loadable_set );
+		}
+
+		if( tree ){
+			na_object_free_items( pivot->private->tree );
+			pivot->private->tree = tree;
+
+		} else {
+			na_pivot_load_items( pivot );
+		}
+	}
+}
+
+/*
+ * na_pivot_get_snapshot_item:
+ * @pivot: this #NAPivot instance.
+ * @id: the identifier of the searched item.
+ *
+ * Gets the item from the snapshot of the tree written by another process
+ * (usually the Nautilus menu plugin) for our loadable set, without loading
+ * nor rebuilding anything else.
+ *
+ * The found item is appended to the tree of the @pivot, which so keeps
+ * the ownership of it, just as with na_pivot_get_item().
+ *
+ * Returns: the found #NAObjectItem, or %NULL if the shared tree is disabled,
+ * there is no usable snapshot, or the item has not been found in it.
+ */
+NAObjectItem *
+na_pivot_get_snapshot_item( NAPivot *pivot, const gchar *id )
+{
+	static const gchar *thisfn = "na_pivot_get_snapshot_item";
+	NAObjectItem *item;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+
+	item = NULL;
+
+	if( !pivot->private->dispose_has_run ){
+
+		g_debug( "%s: pivot=%p, id=%s", thisfn, ( void * ) pivot, id );
+
+		if( na_settings_get_boolean( NA_IPREFS_ITEMS_SHARED_SERVICE, NULL, NULL )){
+			item = na_snapshot_get_item( pivot, pivot->private->loadable_set, id );
+		}
+
+		if( item ){
+			pivot->private->tree = g_list_append( pivot->private->tree, item );
+		}
+	}
+
+	return( item );
+}
+
 /*
  * na_pivot_set_new_items:
  * @pivot: this #NAPivot instance.
@@ -145,10 +145,12 @@ void          na_pivot_free_providers( GList *providers );
 
 /* Items, menus and actions, management
  */
-NAObjectItem *na_pivot_get_item     ( const NAPivot *pivot, const gchar *id );
-GList        *na_pivot_get_items    ( const NAPivot *pivot );
-void          na_pivot_load_items   ( NAPivot *pivot );
-void          na_pivot_set_new_items( NAPivot *pivot, GList *tree );
+NAObjectItem *na_pivot_get_item         ( const NAPivot *pivot, const gchar *id );
+GList        *na_pivot_get_items        ( const NAPivot *pivot );
+NAObjectItem *na_pivot_get_snapshot_item( NAPivot *pivot, const gchar *id );
+void          na_pivot_load_items       ( NAPivot *pivot );
+void          na_pivot_load_shared_items( NAPivot *pivot );
+void          na_pivot_set_new_items    ( NAPivot *pivot, GList *tree );
 
 void          na_pivot_on_item_changed_handler( NAIIOProvider *provider, NAPivot *pivot  );
 
@@ -0,0 +1,531 @@
+/*
+ * Nautilus-Actions
+ * A Nautilus extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2014 Pierre Wieser and others (see AUTHORS)
+ *
+ * Nautilus-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Nautilus-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Nautilus-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+
+#include <api/na-core-utils.h>
+#include <api/na-data-types.h>
+#include <api/na-object-api.h>
+
+#include "na-factory-object.h"
+#include "na-io-provider.h"
+#include "na-serializer.h"
+
+/* the serialized image is:
+ * - the version of the image,
+ * - the flat array of entries, where each entry is:
+ *   - the index of the parent entry, or -1 for a level zero item,
+ *   - the type of the object,
+ *   - the id of the i/o provider (only relevant for items),
+ *   - the data of the object, as a dictionary indexed by NADataDef name.
+ */
+#define SERIALIZER_IMAGE_TYPE			"(ua(iysa{sv}))"
+
+#define SERIALIZER_TYPE_ACTION			'A'
+#define SERIALIZER_TYPE_MENU			'M'
+#define SERIALIZER_TYPE_PROFILE			'P'
+
+static void      tree_to_variant_rec( GVariantBuilder *entries, const GList *items, gint parent, gint *count );
+static gboolean  boxed_to_variant_iter( const NAIFactoryObject *object, NADataBoxed *boxed, GVariantBuilder *data );
+static GVariant *boxed_to_variant( const NADataBoxed *boxed, const NADataDef *def );
+static gboolean  is_valid_image( GVariant *variant );
+static gint      find_item_entry( GVariant *entries, const gchar *id );
+static GList    *tree_from_entries( const NAPivot *pivot, GVariant *entries, gint root );
+static NAObject *object_new_by_type( guchar type );
+static void      object_set_from_variant( NAObject *object, const gchar *name, GVariant *value );
+
+/*
+ * na_serializer_tree_to_variant:
+ * @tree: a list of #NAObjectItem, usually the tree of a #NAPivot.
+ *
+ * Returns: a new floating #GVariant which contains the serialized image
+ * of the @tree.
+ */
+GVariant *
+na_serializer_tree_to_variant( const GList *tree )
+{
+	GVariantBuilder entries;
+	gint count;
+
+	g_variant_builder_init( &entries, G_VARIANT_TYPE( "a(iysa{sv})" ));
+	count = 0;
+	tree_to_variant_rec( &entries, tree, -1, &count );
+
+	return( g_variant_new( SERIALIZER_IMAGE_TYPE, NA_SERIALIZER_VERSION, &entries ));
+}
+
+/*
+ * each entry is added to the builder before its children, so that
+ * the parent index is always lesser than the index of the child
+ */
+static void
+tree_to_variant_rec( GVariantBuilder *entries, const GList *items, gint parent, gint *count )
+{
+	const GList *it;
+	GVariantBuilder data;
+	NAIOProvider *provider;
+	gchar *provider_id;
+	guchar type;
+	gint index;
+
+	for( it = items ; it ; it = it->next ){
+
+		if( NA_IS_OBJECT_ACTION( it->data )){
+			type = SERIALIZER_TYPE_ACTION;
+		} else if( NA_IS_OBJECT_MENU( it->data )){
+			type = SERIALIZER_TYPE_MENU;
+		} else if( NA_IS_OBJECT_PROFILE( it->data )){
+			type = SERIALIZER_TYPE_PROFILE;
+		} else {
+			continue;
+		}
+
+		provider_id = NULL;
+		if( NA_IS_OBJECT_ITEM( it->data )){
+			provider = na_object_get_provider( it->data );
+			if( provider ){
+				provider_id = na_io_provider_get_id( provider );
+			}
+		}
+
+		g_variant_builder_init( &data, G_VARIANT_TYPE( "a{sv}" ));
+		na_factory_object_iter_on_boxed(
+				NA_IFACTORY_OBJECT( it->data ), ( NAFactoryObjectIterBoxedFn ) boxed_to_variant_iter, &data );
+
+		g_variant_builder_add( entries, "(iysa{sv})", parent, type, provider_id ? provider_id : "", &data );
+		g_free( provider_id );
+
+		index = ( *count )++;
+
+		if( NA_IS_OBJECT_ITEM( it->data )){
+			tree_to_variant_rec( entries, na_object_get_items( it->data ), index, count );
+		}
+	}
+}
+
+/*
+ * pointers are not serializable: they are either rebuilt when
+ * deserializing the tree (parent, subitems, provider), or just not
+ * relevant in another process (provider data)
+ */
+static gboolean
+boxed_to_variant_iter( const NAIFactoryObject *object, NADataBoxed *boxed, GVariantBuilder *data )
+{
+	const NADataDef *def;
+	GVariant *value;
+
+	def = na_data_boxed_get_data_def( boxed );
+
+	if( def->type != NA_DATA_TYPE_POINTER ){
+		value = boxed_to_variant( boxed, def );
+		if( value ){
+			g_variant_builder_add( data, "{sv}", def->name, value );
+		}
+	}
+
+	/* don't stop the iteration */
+	return( FALSE );
+}
+
+static GVariant *
+boxed_to_variant( const NADataBoxed *boxed, const NADataDef *def )
+{
+	GVariant *value;
+	GVariantBuilder builder;
+	const gchar *str;
+	const GSList *is;
+	const GList *iu;
+
+	value = NULL;
+
+	switch( def->type ){
+
+		case NA_DATA_TYPE_BOOLEAN:
+			value = g_variant_new_boolean( na_boxed_get_boolean( NA_BOXED( boxed )));
+			break;
+
+		case NA_DATA_TYPE_STRING:
+		case NA_DATA_TYPE_LOCALE_STRING:
+			str = ( const gchar * ) na_boxed_get_pointer( NA_BOXED( boxed ));
+			value = g_variant_new_string( str ? str : "" );
+			break;
+
+		case NA_DATA_TYPE_STRING_LIST:
+			g_variant_builder_init( &builder, G_VARIANT_TYPE( "as" ));
+			is = ( const GSList * ) na_boxed_get_pointer( NA_BOXED( boxed ));
+			for( ; is ; is = is->next ){
+				g_variant_builder_add( &builder, "s", ( const gchar * ) is->data );
+			}
+			value = g_variant_builder_end( &builder );
+			break;
+
+		case NA_DATA_TYPE_UINT:
+			value = g_variant_new_uint32( na_boxed_get_uint( NA_BOXED( boxed )));
+			break;
+
+		case NA_DATA_TYPE_UINT_LIST:
+			g_variant_builder_init( &builder, G_VARIANT_TYPE( "au" ));
+			iu = ( const GList * ) na_boxed_get_pointer( NA_BOXED( boxed ));
+			for( ; iu ; iu = iu->next ){
+				g_variant_builder_add( &builder, "u", GPOINTER_TO_UINT( iu->data ));
+			}
+			value = g_variant_builder_end( &builder );
+			break;
+	}
+
+	return( value );
+}
+
+/*
+ * na_serializer_tree_from_variant:
+ * @pivot: the #NAPivot instance, used to find the i/o providers.
+ * @variant: a #GVariant as returned by na_serializer_tree_to_variant().
+ *
+ * Returns: a newly rebuilt tree of #NAObjectItem, which should be
+ * na_object_free_items() by the caller, or %NULL if the @variant is not
+ * a valid image.
+ */
+GList *
+na_serializer_tree_from_variant( const NAPivot *pivot, GVariant *variant )
+{
+	GList *tree;
+	GVariant *entries;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+	g_return_val_if_fail( variant, NULL );
+
+	tree = NULL;
+
+	if( is_valid_image( variant )){
+		entries = g_variant_get_child_value( variant, 1 );
+		tree = tree_from_entries( pivot, entries, -1 );
+		g_variant_unref( entries );
+	}
+
+	return( tree );
+}
+
+/*
+ * na_serializer_item_from_variant:
+ * @pivot: the #NAPivot instance, used to find the i/o providers.
+ * @variant: a #GVariant as returned by na_serializer_tree_to_variant().
+ * @id: the identifier of the searched item.
+ *
+ * Only rebuilds the #NAObjectItem whose identifier is @id, along with
+ * its children. Other entries of the image are just skipped, so that
+ * this is cheap even with a big tree.
+ *
+ * Returns: a newly rebuilt #NAObjectItem, which should be
+ * g_object_unref() by the caller, or %NULL if not found.
+ */
+NAObjectItem *
+na_serializer_item_from_variant( const NAPivot *pivot, GVariant *variant, const gchar *id )
+{
+	NAObjectItem *item;
+	GVariant *entries;
+	GList *tree;
+	gint root;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+	g_return_val_if_fail( variant, NULL );
+	g_return_val_if_fail( id && strlen( id ), NULL );
+
+	item = NULL;
+
+	if( is_valid_image( variant )){
+		entries = g_variant_get_child_value( variant, 1 );
+		root = find_item_entry( entries, id );
+
+		if( root >= 0 ){
+			tree = tree_from_entries( pivot, entries, root );
+			if( tree ){
+				item = NA_OBJECT_ITEM( tree->data );
+			}
+			g_list_free( tree );
+		}
+
+		g_variant_unref( entries );
+	}
+
+	return( item );
+}
+
+static gboolean
+is_valid_image( GVariant *variant )
+{
+	static const gchar *thisfn = "na_serializer_is_valid_image";
+	guint32 version;
+
+	if( !g_variant_is_of_type( variant, G_VARIANT_TYPE( SERIALIZER_IMAGE_TYPE ))){
+		g_warning( "%s: unexpected variant type %s", thisfn, g_variant_get_type_string( variant ));
+		return( FALSE );
+	}
+
+	g_variant_get_child( variant, 0, "u", &version );
+	if( version != NA_SERIALIZER_VERSION ){
+		g_warning( "%s: unsupported image version %u (expected %u)", thisfn, version, NA_SERIALIZER_VERSION );
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * returns the index of the item entry whose identifier is @id, or -1
+ */
+static gint
+find_item_entry( GVariant *entries, const gchar *id )
+{
+	GVariant *data, *value;
+	GVariantIter iter;
+	const gchar *provider_id, *name;
+	gsize count, i;
+	gint parent, found;
+	guchar type;
+
+	found = -1;
+	count = g_variant_n_children( entries );
+
+	for( i = 0 ; i < count && found < 0 ; ++i ){
+
+		g_variant_get_child( entries, i, "(iy&s@a{sv})", &parent, &type, &provider_id, &data );
+
+		if( type == SERIALIZER_TYPE_ACTION || type == SERIALIZER_TYPE_MENU ){
+			g_variant_iter_init( &iter, data );
+			while( g_variant_iter_next( &iter, "{&sv}", &name, &value )){
+				if( !strcmp( name, NAFO_DATA_ID ) &&
+					g_variant_is_of_type( value, G_VARIANT_TYPE_STRING ) &&
+					!strcmp( g_variant_get_string( value, NULL ), id )){
+						found = ( gint ) i;
+				}
+				g_variant_unref( value );
+			}
+		}
+
+		g_variant_unref( data );
+	}
+
+	return( found );
+}
+
+/*
+ * rebuilds the objects from the entries
+ * if @root is -1, the whole tree is rebuilt; else only the entry at
+ * the @root index and its descendants (which necessarily follow it)
+ */
+static GList *
+tree_from_entries( const NAPivot *pivot, GVariant *entries, gint root )
+{
+	static const gchar *thisfn = "na_serializer_tree_from_entries";
+	GList *tree, *it;
+	GVariant *data, *value;
+	GVariantIter iter;
+	NAObject **objects;
+	NAObject *object, *parent_object;
+	NAIOProvider *provider;
+	const gchar *provider_id, *name;
+	gsize count, i;
+	gint parent;
+	guchar type;
+
+	tree = NULL;
+	count = g_variant_n_children( entries );
+	objects = g_new0( NAObject *, count );
+
+	for( i = root < 0 ? 0 : ( gsize ) root ; i < count ; ++i ){
+
+		g_variant_get_child( entries, i, "(iy&s@a{sv})", &parent, &type, &provider_id, &data );
+		parent_object = ( parent >= 0 && parent < ( gint ) i ) ? objects[parent] : NULL;
+
+		if( root >= 0 && i > ( gsize ) root && !parent_object ){
+			g_variant_unref( data );
+			continue;
+		}
+
+		object = object_new_by_type( type );
+
+		if( object ){
+			g_variant_iter_init( &iter, data );
+			while( g_variant_iter_next( &iter, "{&sv}", &name, &value )){
+				object_set_from_variant( object, name, value );
+				g_variant_unref( value );
+			}
+
+			if( NA_IS_OBJECT_ITEM( object ) && strlen( provider_id )){
+				provider = na_io_provider_find_io_provider_by_id( pivot, provider_id );
+				if( provider ){
+					na_object_set_provider( object, provider );
+				}
+			}
+
+			if(( parent < 0 || i == ( gsize ) root ) && NA_IS_OBJECT_ITEM( object )){
+				tree = g_list_prepend( tree, object );
+
+			} else if( NA_IS_OBJECT_ACTION( parent_object ) && NA_IS_OBJECT_PROFILE( object )){
+				na_object_attach_profile( parent_object, object );
+
+			} else if( NA_IS_OBJECT_MENU( parent_object ) && NA_IS_OBJECT_ITEM( object )){
+				na_object_append_item( parent_object, object );
+
+			} else {
+				g_warning( "%s: entry %lu: unexpected parent %d, ignored", thisfn, ( gulong ) i, parent );
+				g_object_unref( object );
+				object = NULL;
+			}
+
+			objects[i] = object;
+		}
+
+		g_variant_unref( data );
+	}
+
+	g_free( objects );
+
+	tree = g_list_reverse( tree );
+
+	for( it = tree ; it ; it = it->next ){
+		na_object_check_status( it->data );
+	}
+
+	return( tree );
+}
+
+static NAObject *
+object_new_by_type( guchar type )
+{
+	static const gchar *thisfn = "na_serializer_object_new_by_type";
+	NAObject *object;
+
+	object = NULL;
+
+	switch( type ){
+		case SERIALIZER_TYPE_ACTION:
+			object = NA_OBJECT( na_object_action_new());
+			break;
+
+		case SERIALIZER_TYPE_MENU:
+			object = NA_OBJECT( na_object_menu_new());
+			break;
+
+		case SERIALIZER_TYPE_PROFILE:
+			object = NA_OBJECT( na_object_profile_new());
+			break;
+
+		default:
+			g_warning( "%s: unknown object type '%c'", thisfn, type );
+	}
+
+	return( object );
+}
+
+/*
+ * only set the data when the variant type matches the type of the
+ * NADataDef as known by this process
+ */
+static void
+object_set_from_variant( NAObject *object, const gchar *name, GVariant *value )
+{
+	static const gchar *thisfn = "na_serializer_object_set_from_variant";
+	const NADataDef *def;
+	GVariantIter iter;
+	const gchar *str;
+	GSList *slist;
+	GList *ulist;
+	guint32 uint;
+	gboolean ok;
+
+	def = na_factory_object_get_data_def( NA_IFACTORY_OBJECT( object ), name );
+	ok = FALSE;
+
+	if( def ){
+		switch( def->type ){
+
+			case NA_DATA_TYPE_BOOLEAN:
+				if( g_variant_is_of_type( value, G_VARIANT_TYPE_BOOLEAN )){
+					na_ifactory_object_set_from_void( NA_IFACTORY_OBJECT( object ), name,
+							GUINT_TO_POINTER( g_variant_get_boolean( value )));
+					ok = TRUE;
+				}
+				break;
+
+			case NA_DATA_TYPE_STRING:
+			case NA_DATA_TYPE_LOCALE_STRING:
+				if( g_variant_is_of_type( value, G_VARIANT_TYPE_STRING )){
+					na_ifactory_object_set_from_void( NA_IFACTORY_OBJECT( object ), name,
+							g_variant_get_string( value, NULL ));
+					ok = TRUE;
+				}
+				break;
+
+			case NA_DATA_TYPE_STRING_LIST:
+				if( g_variant_is_of_type( value, G_VARIANT_TYPE_STRING_ARRAY )){
+					slist = NULL;
+					g_variant_iter_init( &iter, value );
+					while( g_variant_iter_next( &iter, "&s", &str )){
+						slist = g_slist_prepend( slist, g_strdup( str ));
+					}
+					slist = g_slist_reverse( slist );
+					na_ifactory_object_set_from_void( NA_IFACTORY_OBJECT( object ), name, slist );
+					na_core_utils_slist_free( slist );
+					ok = TRUE;
+				}
+				break;
+
+			case NA_DATA_TYPE_UINT:
+				if( g_variant_is_of_type( value, G_VARIANT_TYPE_UINT32 )){
+					na_ifactory_object_set_from_void( NA_IFACTORY_OBJECT( object ), name,
+							GUINT_TO_POINTER( g_variant_get_uint32( value )));
+					ok = TRUE;
+				}
+				break;
+
+			case NA_DATA_TYPE_UINT_LIST:
+				if( g_variant_is_of_type( value, G_VARIANT_TYPE( "au" ))){
+					ulist = NULL;
+					g_variant_iter_init( &iter, value );
+					while( g_variant_iter_next( &iter, "u", &uint )){
+						ulist = g_list_prepend( ulist, GUINT_TO_POINTER( uint ));
+					}
+					ulist = g_list_reverse( ulist );
+					na_ifactory_object_set_from_void( NA_IFACTORY_OBJECT( object ), name, ulist );
+					g_list_free( ulist );
+					ok = TRUE;
+				}
+				break;
+		}
+	}
+
+	if( !ok ){
+		g_debug( "%s: %s: ignoring data of type %s", thisfn, name, g_variant_get_type_string( value ));
+	}
+}
@@ -0,0 +1,65 @@
+/*
+ * Nautilus-Actions
+ * A Nautilus extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2014 Pierre Wieser and others (see AUTHORS)
+ *
+ * Nautilus-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Nautilus-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Nautilus-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifndef __CORE_NA_SERIALIZER_H__
+#define __CORE_NA_SERIALIZER_H__
+
+/* @title: NASerializer
+ * @short_description: Serialization of the tree of items
+ * @include: core/na-serializer.h
+ *
+ * These functions convert a tree of #NAObjectItem items to and from
+ * a #GVariant, so that an already loaded tree may be handed to another
+ * process without this later having to read again all the i/o providers.
+ *
+ * The serialized image is self-contained and pointer-free:
+ * - the tree is flattened as an array of entries, each entry holding
+ *   the index of its parent in the array (or -1 for level zero items);
+ * - each #NADataBoxed of an object is stored with the name of its
+ *   #NADataDef, but pointer-typed data (parent, subitems, provider and
+ *   provider data) which are rebuilt on deserialization;
+ * - the #NAIOProvider of an item is stored as its internal id.
+ *
+ * The image is versioned: a reader refuses an image whose version is
+ * not the one it knows about.
+ */
+
+#include "na-pivot.h"
+
+G_BEGIN_DECLS
+
+#define NA_SERIALIZER_VERSION			1
+
+GVariant     *na_serializer_tree_to_variant  ( const GList *tree );
+GList        *na_serializer_tree_from_variant( const NAPivot *pivot, GVariant *variant );
+NAObjectItem *na_serializer_item_from_variant( const NAPivot *pivot, GVariant *variant, const gchar *id );
+
+G_END_DECLS
+
+#endif /* __CORE_NA_SERIALIZER_H__ */
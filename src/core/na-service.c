@@ -0,0 +1,360 @@
+/*
+ * Nautilus-Actions
+ * A Nautilus extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2014 Pierre Wieser and others (see AUTHORS)
+ *
+ * Nautilus-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Nautilus-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Nautilus-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifdef HAVE_GDBUS
+#include <gio/gio.h>
+#endif
+
+#include <api/na-object-api.h>
+
+#include "na-serializer.h"
+#include "na-service.h"
+
+#ifdef HAVE_GDBUS
+
+/* the data of the exported service
+ */
+typedef struct {
+	NAPivot         *pivot;
+	guint            owner_id;
+	GDBusNodeInfo   *node_info;
+	GDBusConnection *connection;
+	guint            registration_id;
+	GVariant        *image;
+}
+	ServiceData;
+
+static const gchar st_introspection_xml[] =
+		"<node>"
+		"  <interface name='" NA_SERVICE_DBUS_IFACE "'>"
+		"    <method name='GetTree'>"
+		"      <arg name='loadable' type='u' direction='in'/>"
+		"      <arg name='image' type='v' direction='out'/>"
+		"    </method>"
+		"    <signal name='Changed'/>"
+		"  </interface>"
+		"</node>";
+
+static ServiceData *st_service      = NULL;
+static gint         st_call_timeout = 500;		/* client call timeout in msec */
+
+static void on_bus_acquired( GDBusConnection *connection, const gchar *name, ServiceData *service );
+static void on_name_acquired( GDBusConnection *connection, const gchar *name, ServiceData *service );
+static void on_name_lost( GDBusConnection *connection, const gchar *name, ServiceData *service );
+static void on_method_call( GDBusConnection *connection, const gchar *sender, const gchar *object_path, const gchar *interface_name, const gchar *method_name, GVariant *parameters, GDBusMethodInvocation *invocation, ServiceData *service );
+
+static const GDBusInterfaceVTable st_vtable = {
+		( GDBusInterfaceMethodCallFunc ) on_method_call,
+		NULL,
+		NULL
+};
+
+#endif /* HAVE_GDBUS */
+
+/*
+ * na_service_export:
+ * @pivot: the #NAPivot whose tree is to be exported.
+ *
+ * Tries to own the service name on the session bus, and to export the
+ * tree of the @pivot there.
+ *
+ * There is only one service per process: subsequent calls are no-op.
+ */
+void
+na_service_export( NAPivot *pivot )
+{
+#ifdef HAVE_GDBUS
+	static const gchar *thisfn = "na_service_export";
+	GError *error;
+
+	g_return_if_fail( NA_IS_PIVOT( pivot ));
+
+	if( st_service ){
+		g_debug( "%s: pivot=%p: service already exported", thisfn, ( void * ) pivot );
+		return;
+	}
+
+	g_debug( "%s: pivot=%p", thisfn, ( void * ) pivot );
+
+	error = NULL;
+	st_service = g_new0( ServiceData, 1 );
+	st_service->pivot = pivot;
+	st_service->node_info = g_dbus_node_info_new_for_xml( st_introspection_xml, &error );
+
+	if( !st_service->node_info ){
+		g_warning( "%s: %s", thisfn, error->message );
+		g_error_free( error );
+		g_free( st_service );
+		st_service = NULL;
+		return;
+	}
+
+	st_service->owner_id = g_bus_own_name(
+			G_BUS_TYPE_SESSION,
+			NA_SERVICE_DBUS_NAME,
+			G_BUS_NAME_OWNER_FLAGS_NONE,
+			( GBusAcquiredCallback ) on_bus_acquired,
+			( GBusNameAcquiredCallback ) on_name_acquired,
+			( GBusNameLostCallback ) on_name_lost,
+			st_service,
+			NULL );
+#endif
+}
+
+#ifdef HAVE_GDBUS
+static void
+on_bus_acquired( GDBusConnection *connection, const gchar *name, ServiceData *service )
+{
+	static const gchar *thisfn = "na_service_on_bus_acquired";
+	GError *error;
+
+	g_debug( "%s: connection=%p, name=%s, service=%p",
+			thisfn, ( void * ) connection, name, ( void * ) service );
+
+	error = NULL;
+	service->registration_id = g_dbus_connection_register_object(
+			connection,
+			NA_SERVICE_DBUS_PATH,
+			service->node_info->interfaces[0],
+			&st_vtable,
+			service,
+			NULL,
+			&error );
+
+	if( !service->registration_id ){
+		g_warning( "%s: %s", thisfn, error->message );
+		g_error_free( error );
+
+	} else {
+		service->connection = g_object_ref( connection );
+	}
+}
+
+static void
+on_name_acquired( GDBusConnection *connection, const gchar *name, ServiceData *service )
+{
+	static const gchar *thisfn = "na_service_on_name_acquired";
+
+	g_debug( "%s: connection=%p, name=%s, service=%p",
+			thisfn, ( void * ) connection, name, ( void * ) service );
+}
+
+/*
+ * most probably another process already exports its own tree
+ * clients will just use this one
+ */
+static void
+on_name_lost( GDBusConnection *connection, const gchar *name, ServiceData *service )
+{
+	static const gchar *thisfn = "na_service_on_name_lost";
+
+	g_debug( "%s: connection=%p, name=%s, service=%p",
+			thisfn, ( void * ) connection, name, ( void * ) service );
+}
+
+/*
+ * the serialized image is built on the first request, and then kept
+ * until the tree is reloaded
+ */
+static void
+on_method_call( GDBusConnection *connection, const gchar *sender, const gchar *object_path, const gchar *interface_name, const gchar *method_name, GVariant *parameters, GDBusMethodInvocation *invocation, ServiceData *service )
+{
+	static const gchar *thisfn = "na_service_on_method_call";
+	guint loadable, pivot_loadable;
+
+	g_debug( "%s: sender=%s, method=%s", thisfn, sender, method_name );
+
+	if( !g_strcmp0( method_name, "GetTree" )){
+
+		g_variant_get( parameters, "(u)", &loadable );
+		g_object_get( G_OBJECT( service->pivot ), PIVOT_PROP_LOADABLE, &pivot_loadable, NULL );
+
+		if( loadable != pivot_loadable ){
+			g_dbus_method_invocation_return_error( invocation, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS,
+					"loadable set %u is not served (only %u is)", loadable, pivot_loadable );
+			return;
+		}
+
+		if( !service->image ){
+			service->image = g_variant_ref_sink(
+					na_serializer_tree_to_variant( na_pivot_get_items( service->pivot )));
+		}
+
+		g_dbus_method_invocation_return_value( invocation, g_variant_new( "(v)", service->image ));
+
+	} else {
+		g_dbus_method_invocation_return_error( invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD,
+				"unknown method %s", method_name );
+	}
+}
+#endif /* HAVE_GDBUS */
+
+/*
+ * na_service_unexport:
+ * @pivot: the #NAPivot whose tree has been exported.
+ *
+ * Withdraws the service from the session bus.
+ */
+void
+na_service_unexport( NAPivot *pivot )
+{
+#ifdef HAVE_GDBUS
+	static const gchar *thisfn = "na_service_unexport";
+
+	if( st_service && st_service->pivot == pivot ){
+
+		g_debug( "%s: pivot=%p", thisfn, ( void * ) pivot );
+
+		if( st_service->registration_id ){
+			g_dbus_connection_unregister_object( st_service->connection, st_service->registration_id );
+		}
+		if( st_service->connection ){
+			g_object_unref( st_service->connection );
+		}
+		g_bus_unown_name( st_service->owner_id );
+		g_dbus_node_info_unref( st_service->node_info );
+		if( st_service->image ){
+			g_variant_unref( st_service->image );
+		}
+		g_free( st_service );
+		st_service = NULL;
+	}
+#endif
+}
+
+/*
+ * na_service_items_changed:
+ * @pivot: the #NAPivot whose tree has been exported.
+ *
+ * To be called after the @pivot has reloaded its tree: the cached image
+ * is released, and interested clients are signaled.
+ */
+void
+na_service_items_changed( NAPivot *pivot )
+{
+#ifdef HAVE_GDBUS
+	static const gchar *thisfn = "na_service_items_changed";
+	GError *error;
+
+	if( st_service && st_service->pivot == pivot ){
+
+		g_debug( "%s: pivot=%p", thisfn, ( void * ) pivot );
+
+		if( st_service->image ){
+			g_variant_unref( st_service->image );
+			st_service->image = NULL;
+		}
+
+		if( st_service->registration_id ){
+			error = NULL;
+			if( !g_dbus_connection_emit_signal( st_service->connection, NULL,
+					NA_SERVICE_DBUS_PATH, NA_SERVICE_DBUS_IFACE, "Changed", NULL, &error )){
+				g_warning( "%s: %s", thisfn, error->message );
+				g_error_free( error );
+			}
+		}
+	}
+#endif
+}
+
+/*
+ * na_service_load_items:
+ * @pivot: the #NAPivot which requests the tree.
+ * @loadable_set: the requested loadable set.
+ *
+ * Requests the tree of items from the shared service.
+ *
+ * Returns: the rebuilt tree of items, which should be na_object_free_items()
+ * by the caller, or %NULL if the service is not available, or doesn't
+ * serve this @loadable_set.
+ */
+GList *
+na_service_load_items( const NAPivot *pivot, guint loadable_set )
+{
+	GList *tree;
+#ifdef HAVE_GDBUS
+	static const gchar *thisfn = "na_service_load_items";
+	GDBusConnection *connection;
+	GVariant *result, *image;
+	GError *error;
+#endif
+
+	tree = NULL;
+
+#ifdef HAVE_GDBUS
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+
+	/* do not call ourself
+	 */
+	if( st_service ){
+		return( NULL );
+	}
+
+	error = NULL;
+	connection = g_bus_get_sync( G_BUS_TYPE_SESSION, NULL, &error );
+	if( !connection ){
+		g_debug( "%s: %s", thisfn, error->message );
+		g_error_free( error );
+		return( NULL );
+	}
+
+	result = g_dbus_connection_call_sync(
+			connection,
+			NA_SERVICE_DBUS_NAME,
+			NA_SERVICE_DBUS_PATH,
+			NA_SERVICE_DBUS_IFACE,
+			"GetTree",
+			g_variant_new( "(u)", loadable_set ),
+			G_VARIANT_TYPE( "(v)" ),
+			G_DBUS_CALL_FLAGS_NO_AUTO_START,
+			st_call_timeout,
+			NULL,
+			&error );
+
+	if( !result ){
+		g_debug( "%s: %s", thisfn, error->message );
+		g_error_free( error );
+
+	} else {
+		g_variant_get( result, "(v)", &image );
+		tree = na_serializer_tree_from_variant( pivot, image );
+		g_debug( "%s: %d items loaded from the shared service", thisfn, g_list_length( tree ));
+		g_variant_unref( image );
+		g_variant_unref( result );
+	}
+
+	g_object_unref( connection );
+#endif
+
+	return( tree );
+}
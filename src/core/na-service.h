@@ -0,0 +1,71 @@
+/*
+ * Nautilus-Actions
+ * A Nautilus extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2014 Pierre Wieser and others (see AUTHORS)
+ *
+ * Nautilus-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Nautilus-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Nautilus-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifndef __CORE_NA_SERVICE_H__
+#define __CORE_NA_SERVICE_H__
+
+/* @title: NAService
+ * @short_description: The shared menu model service
+ * @include: core/na-service.h
+ *
+ * The process which has loaded the items tree (usually the Nautilus
+ * menu plugin) may export it on the D-Bus session bus, so that other
+ * processes of the same session do not have to read again all the i/o
+ * providers, but just get a serialized image of the already loaded tree
+ * (see na-serializer.h).
+ *
+ * The image is only served to clients which request the same loadable
+ * set than the exporting #NAPivot; other clients, or clients which do
+ * not find the service on the bus, just load the items themselves.
+ *
+ * The service is read-only: the objects a client rebuilds from the image
+ * are its own copies, and are not associated with any provider data.
+ * They so cannot be used to update the storage subsystems.
+ *
+ * This requires GDBus; the service is never available when building
+ * against an older GLib.
+ */
+
+#include "na-pivot.h"
+
+G_BEGIN_DECLS
+
+#define NA_SERVICE_DBUS_NAME				"org.nautilus-actions.MenuModel"
+#define NA_SERVICE_DBUS_PATH				"/org/nautilus_actions/MenuModel"
+#define NA_SERVICE_DBUS_IFACE				"org.nautilus_actions.MenuModel1"
+
+void   na_service_export       ( NAPivot *pivot );
+void   na_service_unexport     ( NAPivot *pivot );
+void   na_service_items_changed( NAPivot *pivot );
+
+GList *na_service_load_items   ( const NAPivot *pivot, guint loadable_set );
+
+G_END_DECLS
+
+#endif /* __CORE_NA_SERVICE_H__ */
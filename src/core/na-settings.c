@@ -113,9 +113,12 @@ struct _NASettingsPrivate {
 	gboolean  dispose_has_run;
 	KeyFile  *mandatory;
 	KeyFile  *user;
-	GList    *content;
-	GList    *consumers;
-	NATimeout timeout;
+	GList      *content;
+	GHashTable *content_index;			/* the KeyValue's of content, indexed by (group,key) */
+	GHashTable *snapshot;
+	GList      *consumers;
+	GHashTable *consumers_by_key;
+	NATimeout   timeout;
 };
 
 #define GROUP_NACT						"nact"
@@ -146,6 +149,8 @@ static const KeyDef st_def_keys[] = {
 	{ NA_IPREFS_SHOW_IF_RUNNING_URI,              GROUP_NACT,    NA_DATA_TYPE_STRING,      "file:///bin" },
 	{ NA_IPREFS_TRY_EXEC_WSP,                     GROUP_NACT,    NA_DATA_TYPE_UINT_LIST,   "" },
 	{ NA_IPREFS_TRY_EXEC_URI,                     GROUP_NACT,    NA_DATA_TYPE_STRING,      "file:///bin" },
+	{ NA_IPREFS_EXECUTION_MAX_CHILDREN,           GROUP_RUNTIME, NA_DATA_TYPE_UINT,        "16" },
+	{ NA_IPREFS_EXECUTION_MAX_LENGTH,             GROUP_RUNTIME, NA_DATA_TYPE_UINT,        "0" },
 	{ NA_IPREFS_EXPORT_ASK_USER_WSP,              GROUP_NACT,    NA_DATA_TYPE_UINT_LIST,   "" },
 	{ NA_IPREFS_EXPORT_ASK_USER_LAST_FORMAT,      GROUP_NACT,    NA_DATA_TYPE_STRING,      "Desktop1" },
 	{ NA_IPREFS_EXPORT_ASK_USER_KEEP_LAST_CHOICE, GROUP_NACT,    NA_DATA_TYPE_BOOLEAN,     "false" },
@@ -169,6 +174,7 @@ static const KeyDef st_def_keys[] = {
 	{ NA_IPREFS_ITEMS_CREATE_ROOT_MENU,           GROUP_RUNTIME, NA_DATA_TYPE_BOOLEAN,     "true" },
 	{ NA_IPREFS_ITEMS_LEVEL_ZERO_ORDER,           GROUP_RUNTIME, NA_DATA_TYPE_STRING_LIST, "" },
 	{ NA_IPREFS_ITEMS_LIST_ORDER_MODE,            GROUP_RUNTIME, NA_DATA_TYPE_STRING,      "AscendingOrder" },
+	{ NA_IPREFS_ITEMS_SHARED_SERVICE,             GROUP_RUNTIME, NA_DATA_TYPE_BOOLEAN,     "true" },
 	{ NA_IPREFS_MAIN_PANED,                       GROUP_NACT,    NA_DATA_TYPE_UINT,        "200" },
 	{ NA_IPREFS_MAIN_SAVE_AUTO,                   GROUP_NACT,    NA_DATA_TYPE_BOOLEAN,     "false" },
 	{ NA_IPREFS_MAIN_SAVE_PERIOD,                 GROUP_NACT,    NA_DATA_TYPE_UINT,        "5" },
@@ -194,6 +200,11 @@ static const KeyDef st_def_keys[] = {
 /* The configuration content is handled as a GList of KeyValue structs.
  * This list is loaded at initialization time, and then compared each
  * time our file monitors signal us that a change has occured.
+ *
+ * Reads are served from a snapshot of this same content, as a hash
+ * table of groups, each group being itself a hash table of KeyValue
+ * structs keyed by key name. The snapshot is rebuilt and swapped when
+ * the configuration files change, and updated when we write a key.
  */
 typedef struct {
 	const KeyDef *def;
@@ -214,6 +225,7 @@ static GObjectClass *st_parent_class           = NULL;
 static gint          st_burst_timeout          = 100;		/* burst timeout in msec */
 static gint          st_signals[ LAST_SIGNAL ] = { 0 };
 static NASettings   *st_settings               = NULL;
+static GHashTable   *st_key_defs               = NULL;		/* key -> KeyDef */
 
 static GType     settings_get_type( void );
 static GType     register_type( void );
@@ -224,20 +236,27 @@ static void      instance_finalize( GObject *object );
 
 static void      settings_new( void );
 
-static GList    *content_diff( GList *old, GList *new );
-static GList    *content_load_keys( GList *content, KeyFile *keyfile );
+static GList    *content_diff( GList *old, GHashTable *old_index, GList *new, GHashTable *new_index );
+static guint     content_hash( const KeyValue *value );
+static gboolean  content_equal( const KeyValue *a, const KeyValue *b );
+static KeyValue *copy_key_value( const KeyValue *value, gboolean mandatory );
+static void      free_consumers_list( gpointer key, GList *list, void *empty );
+static GHashTable *content_index_new( void );
+static GList    *content_load_keys( GList *content, GHashTable *index, KeyFile *keyfile );
 static KeyDef   *get_key_def( const gchar *key );
 static KeyFile  *key_file_new( const gchar *dir );
 static void      on_keyfile_changed( GFileMonitor *monitor, GFile *file, GFile *other_file, GFileMonitorEvent event_type );
 static void      on_keyfile_changed_timeout( void );
 static void      on_key_changed_final_handler( NASettings *settings, gchar *group, gchar *key, NABoxed *new_value, gboolean mandatory );
-static KeyValue *peek_key_value_from_content( GList *content, const gchar *group, const gchar *key );
-static KeyValue *read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory );
+static const KeyValue *read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory );
 static KeyValue *read_key_value_from_key_file( KeyFile *keyfile, const gchar *group, const gchar *key, const KeyDef *key_def );
 static void      release_consumer( Consumer *consumer );
 static void      release_key_file( KeyFile *key_file );
 static void      release_key_value( KeyValue *value );
 static gboolean  set_key_value( const gchar *group, const gchar *key, const gchar *string );
+static GHashTable *snapshot_new( GList *content );
+static void      snapshot_set( GHashTable *snapshot, KeyValue *value );
+static void      snapshot_update( const gchar *group, const gchar *key, const KeyDef *key_def );
 static gboolean  write_user_key_file( void );
 
 static GType
@@ -343,12 +362,14 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->mandatory = NULL;
 	self->private->user = NULL;
 	self->private->content = NULL;
+	self->private->content_index = NULL;
+	self->private->snapshot = NULL;
 	self->private->consumers = NULL;
+	self->private->consumers_by_key = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
 
 	self->private->timeout.timeout = st_burst_timeout;
 	self->private->timeout.handler = ( NATimeoutFunc ) on_keyfile_changed_timeout;
 	self->private->timeout.user_data = NULL;
-	self->private->timeout.source_id = 0;
 }
 
 static void
@@ -367,6 +388,8 @@ instance_dispose( GObject *object )
 
 		self->private->dispose_has_run = TRUE;
 
+		na_timeout_remove( &self->private->timeout );
+
 		release_key_file( self->private->mandatory );
 		release_key_file( self->private->user );
 
@@ -388,9 +411,20 @@ instance_finalize( GObject *object )
 
 	self = NA_SETTINGS( object );
 
+	if( self->private->content_index ){
+		g_hash_table_destroy( self->private->content_index );
+	}
+
 	g_list_foreach( self->private->content, ( GFunc ) release_key_value, NULL );
 	g_list_free( self->private->content );
 
+	if( self->private->snapshot ){
+		g_hash_table_destroy( self->private->snapshot );
+	}
+
+	g_hash_table_foreach( self->private->consumers_by_key, ( GHFunc ) free_consumers_list, NULL );
+	g_hash_table_destroy( self->private->consumers_by_key );
+
 	g_list_foreach( self->private->consumers, ( GFunc ) release_consumer, NULL );
 	g_list_free( self->private->consumers );
 
@@ -414,11 +448,13 @@ settings_new( void )
 	static const gchar *thisfn = "na_settings_new";
 	gchar *dir;
 	GList *content;
+	GHashTable *index;
 	const gchar * const *array;
 	gchar **iter;
 
 	if( !st_settings ){
 		content = NULL;
+		index = content_index_new();
 		st_settings = g_object_new( NA_SETTINGS_TYPE, NULL );
 
 		/* iterate through system config dirs until having found a
@@ -435,7 +471,7 @@ settings_new( void )
 			st_settings->private->mandatory = key_file_new( dir );
 			g_free( dir );
 			st_settings->private->mandatory->mandatory = TRUE;
-			content = content_load_keys( NULL, st_settings->private->mandatory );
+			content = content_load_keys( NULL, index, st_settings->private->mandatory );
 			if( content ){
 				break;
 			}
@@ -447,11 +483,14 @@ settings_new( void )
 		g_mkdir_with_parents( dir, 0750 );
 		st_settings->private->user = key_file_new( dir );
 		g_free( dir );
-		st_settings->private->mandatory->mandatory = FALSE;
-		content = content_load_keys( content, st_settings->private->user );
+		st_settings->private->user->mandatory = FALSE;
+		content = content_load_keys( content, index, st_settings->private->user );
 
 		st_settings->private->content = g_list_copy( content );
+		st_settings->private->content_index = index;
 		g_list_free( content );
+
+		st_settings->private->snapshot = snapshot_new( st_settings->private->content );
 	}
 }
 
@@ -481,6 +520,7 @@ void
 na_settings_register_key_callback( const gchar *key, GCallback callback, gpointer user_data )
 {
 	static const gchar *thisfn = "na_settings_register_key_callback";
+	GList *list;
 
 	g_debug( "%s: key=%s, callback=%p, user_data=%p",
 			thisfn, key, ( void * ) callback, ( void * ) user_data );
@@ -492,6 +532,13 @@ na_settings_register_key_callback( const gchar *key, GCallback callback, gpointe
 
 	settings_new();
 	st_settings->private->consumers = g_list_prepend( st_settings->private->consumers, consumer );
+
+	/* consumers are also indexed by monitored key; the index does not
+	 * own the consumers, but only the lists
+	 */
+	list = ( GList * ) g_hash_table_lookup( st_settings->private->consumers_by_key, key );
+	list = g_list_prepend( list, consumer );
+	g_hash_table_replace( st_settings->private->consumers_by_key, g_strdup( key ), list );
 }
 
 /**
@@ -538,7 +585,7 @@ gboolean
 na_settings_get_boolean_ex( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	gboolean value;
-	KeyValue *key_value;
+	const KeyValue *key_value;
 	KeyDef *key_def;
 
 	value = FALSE;
@@ -546,7 +593,6 @@ na_settings_get_boolean_ex( const gchar *group, const gchar *key, gboolean *foun
 
 	if( key_value ){
 		value = na_boxed_get_boolean( key_value->boxed );
-		release_key_value( key_value );
 
 	} else {
 		key_def = get_key_def( key );
@@ -581,7 +627,7 @@ gchar *
 na_settings_get_string( const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	gchar *value;
-	KeyValue *key_value;
+	const KeyValue *key_value;
 	KeyDef *key_def;
 
 	value = NULL;
@@ -589,7 +635,6 @@ na_settings_get_string( const gchar *key, gboolean *found, gboolean *mandatory )
 
 	if( key_value ){
 		value = na_boxed_get_string( key_value->boxed );
-		release_key_value( key_value );
 
 	} else {
 		key_def = get_key_def( key );
@@ -624,7 +669,7 @@ GSList *
 na_settings_get_string_list( const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	GSList *value;
-	KeyValue *key_value;
+	const KeyValue *key_value;
 	KeyDef *key_def;
 
 	value = NULL;
@@ -632,7 +677,6 @@ na_settings_get_string_list( const gchar *key, gboolean *found, gboolean *mandat
 
 	if( key_value ){
 		value = na_boxed_get_string_list( key_value->boxed );
-		release_key_value( key_value );
 
 	} else {
 		key_def = get_key_def( key );
@@ -667,14 +711,13 @@ na_settings_get_uint( const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	guint value;
 	KeyDef *key_def;
-	KeyValue *key_value;
+	const KeyValue *key_value;
 
 	value = 0;
 	key_value = read_key_value( NULL, key, found, mandatory );
 
 	if( key_value ){
 		value = na_boxed_get_uint( key_value->boxed );
-		release_key_value( key_value );
 
 	} else {
 		key_def = get_key_def( key );
@@ -710,14 +753,13 @@ na_settings_get_uint_list( const gchar *key, gboolean *found, gboolean *mandator
 {
 	GList *value;
 	KeyDef *key_def;
-	KeyValue *key_value;
+	const KeyValue *key_value;
 
 	value = NULL;
 	key_value = read_key_value( NULL, key, found, mandatory );
 
 	if( key_value ){
 		value = na_boxed_get_uint_list( key_value->boxed );
-		release_key_value( key_value );
 
 	} else {
 		key_def = get_key_def( key );
@@ -980,35 +1022,29 @@ na_settings_get_groups( void )
  *
  * we return here a new list, with newly allocated KeyValue structs
  * which hold the new value of each modified key
+ *
+ * both contents are indexed by (group,key) while they are loaded, so
+ * that each key is searched for in the other content in constant time
  */
 static GList *
-content_diff( GList *old, GList *new )
+content_diff( GList *old, GHashTable *old_index, GList *new, GHashTable *new_index )
 {
 	GList *diffs, *io, *in;
 	KeyValue *kold, *knew, *kdiff;
-	gboolean found;
 
 	diffs = NULL;
 
 	for( io = old ; io ; io = io->next ){
 		kold = ( KeyValue * ) io->data;
-		found = FALSE;
-		for( in = new ; in && !found ; in = in->next ){
-			knew = ( KeyValue * ) in->data;
-			if( !strcmp( kold->group, knew->group ) && ( gpointer ) kold->def == ( gpointer ) knew->def ){
-				found = TRUE;
-				if( !na_boxed_are_equal( kold->boxed, knew->boxed )){
-					/* a key has been modified */
-					kdiff = g_new0( KeyValue, 1 );
-					kdiff->group = g_strdup( knew->group );
-					kdiff->def = knew->def;
-					kdiff->mandatory = knew->mandatory;
-					kdiff->boxed = na_boxed_copy( knew->boxed );
-					diffs = g_list_prepend( diffs, kdiff );
-				}
+		knew = ( KeyValue * ) g_hash_table_lookup( new_index, kold );
+
+		if( knew ){
+			if( !na_boxed_are_equal( kold->boxed, knew->boxed )){
+				/* a key has been modified */
+				diffs = g_list_prepend( diffs, copy_key_value( knew, knew->mandatory ));
 			}
-		}
-		if( !found ){
+
+		} else {
 			/* a key has disappeared */
 			kdiff = g_new0( KeyValue, 1 );
 			kdiff->group = g_strdup( kold->group );
@@ -1019,43 +1055,70 @@ content_diff( GList *old, GList *new )
 		}
 	}
 
+	/* keys which are new, in the order of the new content */
 	for( in = new ; in ; in = in->next ){
-		knew = ( KeyValue * ) in->data;
-		found = FALSE;
-		for( io = old ; io && !found ; io = io->next ){
-			kold = ( KeyValue * ) io->data;
-			if( !strcmp( kold->group, knew->group ) && ( gpointer ) kold->def == ( gpointer ) knew->def ){
-				found = TRUE;
-			}
-		}
-		if( !found ){
-			/* a key is new */
-			kdiff = g_new0( KeyValue, 1 );
-			kdiff->group = g_strdup( knew->group );
-			kdiff->def = knew->def;
-			kdiff->mandatory = knew->mandatory;
-			kdiff->boxed = na_boxed_copy( knew->boxed );
-			diffs = g_list_prepend( diffs, kdiff );
+		if( !g_hash_table_lookup( old_index, in->data )){
+			diffs = g_list_prepend( diffs, copy_key_value( in->data, (( KeyValue * ) in->data )->mandatory ));
 		}
 	}
 
 	return( diffs );
 }
 
+/*
+ * an index of a content list, whose KeyValue structs are both the keys
+ * and the values; the content list keeps the ownership of its structs
+ */
+static GHashTable *
+content_index_new( void )
+{
+	return( g_hash_table_new(( GHashFunc ) content_hash, ( GEqualFunc ) content_equal ));
+}
+
+static guint
+content_hash( const KeyValue *value )
+{
+	return( g_str_hash( value->group ) ^ g_direct_hash( value->def ));
+}
+
+static gboolean
+content_equal( const KeyValue *a, const KeyValue *b )
+{
+	return( a->def == b->def && !strcmp( a->group, b->group ));
+}
+
+static KeyValue *
+copy_key_value( const KeyValue *value, gboolean mandatory )
+{
+	KeyValue *copy;
+
+	copy = g_new0( KeyValue, 1 );
+	copy->group = g_strdup( value->group );
+	copy->def = value->def;
+	copy->mandatory = mandatory;
+	copy->boxed = na_boxed_copy( value->boxed );
+
+	return( copy );
+}
+
 /* add the content of a configuration files to those already loaded
  *
  * when the two configuration files have been read, then the content of
  * _the_ configuration has been loaded, while preserving the mandatory
  * keys
+ *
+ * @index indexes @content by (group,key), and is updated along with it,
+ * so that an already loaded key is found in constant time
  */
 static GList *
-content_load_keys( GList *content, KeyFile *keyfile )
+content_load_keys( GList *content, GHashTable *index, KeyFile *keyfile )
 {
 	static const gchar *thisfn = "na_settings_content_load_keys";
 	GError *error;
 	gchar **groups, **ig;
 	gchar **keys, **ik;
 	KeyValue *key_value;
+	KeyValue probe;
 	KeyDef *key_def;
 
 	error = NULL;
@@ -1077,12 +1140,14 @@ content_load_keys( GList *content, KeyFile *keyfile )
 			while( *ik ){
 				key_def = get_key_def( *ik );
 				if( key_def ){
-					key_value = peek_key_value_from_content( content, *ig, *ik );
-					if( !key_value ){
+					probe.def = key_def;
+					probe.group = *ig;
+					if( !g_hash_table_lookup( index, &probe )){
 						key_value = read_key_value_from_key_file( keyfile, *ig, *ik, key_def );
 						if( key_value ){
 							key_value->mandatory = keyfile->mandatory;
 							content = g_list_prepend( content, key_value );
+							g_hash_table_insert( index, key_value, key_value );
 						}
 					}
 				}
@@ -1101,16 +1166,18 @@ static KeyDef *
 get_key_def( const gchar *key )
 {
 	static const gchar *thisfn = "na_settings_get_key_def";
-	KeyDef *found = NULL;
-	KeyDef *idef;
+	KeyDef *found;
+	const KeyDef *idef;
 
-	idef = ( KeyDef * ) st_def_keys;
-	while( idef->key && !found ){
-		if( !strcmp( idef->key, key )){
-			found = idef;
+	if( !st_key_defs ){
+		st_key_defs = g_hash_table_new( g_str_hash, g_str_equal );
+		for( idef = st_def_keys ; idef->key ; idef++ ){
+			g_hash_table_insert( st_key_defs, ( gpointer ) idef->key, ( gpointer ) idef );
 		}
-		idef++;
 	}
+
+	found = ( KeyDef * ) g_hash_table_lookup( st_key_defs, key );
+
 	if( !found ){
 		g_warning( "%s: no KeyDef found for key=%s", thisfn, key );
 	}
@@ -1172,11 +1239,13 @@ on_keyfile_changed_timeout( void )
 {
 	static const gchar *thisfn = "na_settings_on_keyfile_changed_timeout";
 	GList *new_content;
+	GHashTable *new_index;
 	GList *modifs;
 	GList *ic, *im;
 	const KeyValue *changed;
 	const Consumer *consumer;
-	gchar *group_prefix, *key;
+	gchar *group_prefix;
+	GList *consumers;
 #ifdef NA_MAINTAINER_MODE
 	gchar *value;
 #endif
@@ -1184,9 +1253,16 @@ on_keyfile_changed_timeout( void )
 	/* last individual notification is older that the st_burst_timeout
 	 * we may so suppose that the burst is terminated
 	 */
-	new_content = content_load_keys( NULL, st_settings->private->mandatory );
-	new_content = content_load_keys( new_content, st_settings->private->user );
-	modifs = content_diff( st_settings->private->content, new_content );
+	new_index = content_index_new();
+	new_content = content_load_keys( NULL, new_index, st_settings->private->mandatory );
+	new_content = content_load_keys( new_content, new_index, st_settings->private->user );
+	modifs = content_diff(
+			st_settings->private->content, st_settings->private->content_index, new_content, new_index );
+
+	/* consumers are expected to read the new values
+	 */
+	g_hash_table_destroy( st_settings->private->snapshot );
+	st_settings->private->snapshot = snapshot_new( new_content );
 
 #ifdef NA_MAINTAINER_MODE
 	g_debug( "%s: %d found update(s)", thisfn, g_list_length( modifs ));
@@ -1199,24 +1275,34 @@ on_keyfile_changed_timeout( void )
 #endif
 
 	/* for each modification found,
-	 * - check if a consumer has registered for this key, and triggers callback if apply
+	 * - triggers the callback of the consumers which have registered for this key
 	 * - send a notification message
 	 */
+	group_prefix = g_strdup_printf( "%s ", NA_IPREFS_IO_PROVIDER_GROUP );
+
 	for( im = modifs ; im ; im = im->next ){
 		changed = ( const KeyValue * ) im->data;
 
-		for( ic = st_settings->private->consumers ; ic ; ic = ic->next ){
+		consumers = ( GList * ) g_hash_table_lookup( st_settings->private->consumers_by_key, changed->def->key );
+
+		for( ic = consumers ; ic ; ic = ic->next ){
 			consumer = ( const Consumer * ) ic->data;
-			group_prefix = NULL;
+			( *( NASettingsKeyCallback ) consumer->callback )(
+					changed->group,
+					changed->def->key,
+					na_boxed_get_pointer( changed->boxed ),
+					changed->mandatory,
+					consumer->user_data );
+		}
 
-			if( !strcmp( consumer->monitored_key, NA_IPREFS_IO_PROVIDERS_READ_STATUS )){
-				group_prefix = g_strdup_printf( "%s ", NA_IPREFS_IO_PROVIDER_GROUP );
-				key = NA_IPREFS_IO_PROVIDER_READABLE;
-			} else {
-				key = consumer->monitored_key;
-			}
+		/* the composite key monitors the 'readable' key of all i/o providers
+		 */
+		if( !strcmp( changed->def->key, NA_IPREFS_IO_PROVIDER_READABLE ) && g_str_has_prefix( changed->group, group_prefix )){
+
+			consumers = ( GList * ) g_hash_table_lookup( st_settings->private->consumers_by_key, NA_IPREFS_IO_PROVIDERS_READ_STATUS );
 
-			if(( !group_prefix || g_str_has_prefix( changed->group, group_prefix )) && !strcmp( changed->def->key, key )){
+			for( ic = consumers ; ic ; ic = ic->next ){
+				consumer = ( const Consumer * ) ic->data;
 				( *( NASettingsKeyCallback ) consumer->callback )(
 						changed->group,
 						changed->def->key,
@@ -1224,8 +1310,6 @@ on_keyfile_changed_timeout( void )
 						changed->mandatory,
 						consumer->user_data );
 			}
-
-			g_free( group_prefix );
 		}
 
 		g_debug( "%s: sending signal for group=%s, key=%s", thisfn, changed->group, changed->def->key );
@@ -1234,10 +1318,14 @@ on_keyfile_changed_timeout( void )
 				changed->group, changed->def->key, changed->boxed, changed->mandatory );
 	}
 
+	g_free( group_prefix );
+
 	g_debug( "%s: releasing content", thisfn );
+	g_hash_table_destroy( st_settings->private->content_index );
 	g_list_foreach( st_settings->private->content, ( GFunc ) release_key_value, NULL );
 	g_list_free( st_settings->private->content );
 	st_settings->private->content = new_content;
+	st_settings->private->content_index = new_index;
 
 	g_debug( "%s: releasing modifs", thisfn );
 	g_list_foreach( modifs, ( GFunc ) release_key_value, NULL );
@@ -1251,32 +1339,18 @@ on_key_changed_final_handler( NASettings *settings, gchar *group, gchar *key, NA
 	na_boxed_dump( new_value );
 }
 
-static KeyValue *
-peek_key_value_from_content( GList *content, const gchar *group, const gchar *key )
-{
-	KeyValue *value, *found;
-	GList *ic;
-
-	found = NULL;
-	for( ic = content ; ic && !found ; ic = ic->next ){
-		value = ( KeyValue * ) ic->data;
-		if( !strcmp( value->group, group ) && !strcmp( value->def->key, key )){
-			found = value;
-		}
-	}
-
-	return( found );
-}
-
 /* group may be NULL
+ *
+ * the returned KeyValue is owned by the snapshot, and should not be
+ * released by the caller
  */
-static KeyValue *
+static const KeyValue *
 read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	static const gchar *thisfn = "na_settings_read_key_value";
 	KeyDef *key_def;
-	gboolean has_entry;
-	KeyValue *key_value;
+	GHashTable *keys;
+	const KeyValue *key_value;
 
 	key_value = NULL;
 	if( found ){
@@ -1290,27 +1364,19 @@ read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean
 	key_def = get_key_def( key );
 
 	if( key_def ){
-		has_entry = FALSE;
-		key_value = read_key_value_from_key_file( st_settings->private->mandatory, group ? group : key_def->group, key, key_def );
+		keys = ( GHashTable * ) g_hash_table_lookup( st_settings->private->snapshot, group ? group : key_def->group );
+		if( keys ){
+			key_value = ( const KeyValue * ) g_hash_table_lookup( keys, key );
+		}
 		if( key_value ){
-			has_entry = TRUE;
 			if( found ){
 				*found = TRUE;
 			}
-			if( mandatory ){
+			if( mandatory && key_value->mandatory ){
 				*mandatory = TRUE;
 				g_debug( "%s: %s: key is mandatory", thisfn, key );
 			}
 		}
-		if( !has_entry ){
-			key_value = read_key_value_from_key_file( st_settings->private->user, group ? group : key_def->group, key, key_def );
-			if( key_value ){
-				has_entry = TRUE;
-				if( found ){
-					*found = TRUE;
-				}
-			}
-		}
 	}
 
 	return( key_value );
@@ -1374,6 +1440,16 @@ read_key_value_from_key_file( KeyFile *keyfile, const gchar *group, const gchar
 	return( value );
 }
 
+/*
+ * called from instance_finalize
+ * release a list of the consumers index
+ */
+static void
+free_consumers_list( gpointer key, GList *list, void *empty )
+{
+	g_list_free( list );
+}
+
 /*
  * called from instance_finalize
  * release the list of registered consumers
@@ -1451,6 +1527,11 @@ set_key_value( const gchar *group, const gchar *key, const gchar *string )
 		}
 
 		ok &= write_user_key_file();
+
+		key_def = get_key_def( key );
+		if( key_def ){
+			snapshot_update( wgroup, key, key_def );
+		}
 	}
 
 	return( ok );
@@ -1509,3 +1590,73 @@ write_user_key_file( void )
 
 	return( TRUE );
 }
+
+/*
+ * build a new snapshot from the content list
+ * the snapshot owns its own copy of each KeyValue
+ */
+static GHashTable *
+snapshot_new( GList *content )
+{
+	GHashTable *snapshot;
+	GList *ic;
+	const KeyValue *value;
+
+	snapshot = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) g_hash_table_destroy );
+
+	for( ic = content ; ic ; ic = ic->next ){
+		value = ( const KeyValue * ) ic->data;
+		snapshot_set( snapshot, copy_key_value( value, value->mandatory ));
+	}
+
+	return( snapshot );
+}
+
+/*
+ * the snapshot takes ownership of the provided KeyValue, replacing the
+ * previous value of the key if any
+ */
+static void
+snapshot_set( GHashTable *snapshot, KeyValue *value )
+{
+	GHashTable *keys;
+
+	keys = ( GHashTable * ) g_hash_table_lookup( snapshot, value->group );
+
+	if( !keys ){
+		keys = g_hash_table_new_full( g_str_hash, g_str_equal, NULL, ( GDestroyNotify ) release_key_value );
+		g_hash_table_insert( snapshot, g_strdup( value->group ), keys );
+	}
+
+	g_hash_table_replace( keys, ( gpointer ) value->def->key, value );
+}
+
+/*
+ * a key has just been written in the user configuration: reflect it in
+ * the snapshot, unless it has a mandatory value
+ *
+ * the content list is left unchanged, so that the modification will be
+ * notified to the consumers when the file monitor fires
+ */
+static void
+snapshot_update( const gchar *group, const gchar *key, const KeyDef *key_def )
+{
+	GHashTable *keys;
+	const KeyValue *current;
+	KeyValue *value;
+
+	keys = ( GHashTable * ) g_hash_table_lookup( st_settings->private->snapshot, group );
+	current = keys ? ( const KeyValue * ) g_hash_table_lookup( keys, key ) : NULL;
+
+	if( !current || !current->mandatory ){
+		value = read_key_value_from_key_file( st_settings->private->user, group, key, key_def );
+
+		if( value ){
+			value->mandatory = FALSE;
+			snapshot_set( st_settings->private->snapshot, value );
+
+		} else if( current ){
+			g_hash_table_remove( keys, key );
+		}
+	}
+}
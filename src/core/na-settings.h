@@ -86,6 +86,8 @@ G_BEGIN_DECLS
 #define NA_IPREFS_SHOW_IF_RUNNING_URI				"environment-show-if-running-lfu"
 #define NA_IPREFS_TRY_EXEC_WSP						"environment-try-exec-wsp"
 #define NA_IPREFS_TRY_EXEC_URI						"environment-try-exec-lfu"
+#define NA_IPREFS_EXECUTION_MAX_CHILDREN			"execution-max-children"
+#define NA_IPREFS_EXECUTION_MAX_LENGTH				"execution-max-length"
 #define NA_IPREFS_EXPORT_ASK_USER_WSP				"export-ask-user-wsp"
 #define NA_IPREFS_EXPORT_ASK_USER_LAST_FORMAT		"export-ask-user-last-format"
 #define NA_IPREFS_EXPORT_ASK_USER_KEEP_LAST_CHOICE	"export-ask-user-keep-last-choice"
@@ -109,6 +111,7 @@ G_BEGIN_DECLS
 #define NA_IPREFS_ITEMS_CREATE_ROOT_MENU			"items-create-root-menu"
 #define NA_IPREFS_ITEMS_LEVEL_ZERO_ORDER			"items-level-zero-order"
 #define NA_IPREFS_ITEMS_LIST_ORDER_MODE				"items-list-order-mode"
+#define NA_IPREFS_ITEMS_SHARED_SERVICE				"items-shared-service"
 #define NA_IPREFS_MAIN_PANED						"main-paned-width"
 #define NA_IPREFS_MAIN_SAVE_AUTO					"main-save-auto"
 #define NA_IPREFS_MAIN_SAVE_PERIOD					"main-save-period"
@@ -0,0 +1,213 @@
+/*
+ * Nautilus-Actions
+ * A Nautilus extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2014 Pierre Wieser and others (see AUTHORS)
+ *
+ * Nautilus-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Nautilus-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Nautilus-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <errno.h>
+#include <glib/gstdio.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "na-serializer.h"
+#include "na-snapshot.h"
+
+/* the snapshot is:
+ * - the version of the snapshot,
+ * - the loadable set of the writer pivot,
+ * - the pid of the writer,
+ * - the serialized image of the tree.
+ */
+#define SNAPSHOT_TYPE					"(uuxv)"
+
+static gchar   *get_snapshot_path( guint loadable_set );
+static gboolean is_writer_alive( gint64 pid );
+
+/*
+ * na_snapshot_write:
+ * @pivot: the #NAPivot whose tree is to be written.
+ *
+ * (Re)writes the snapshot of the tree of the @pivot.
+ * The file is atomically replaced, so that consumers which have mapped
+ * the previous snapshot are not disturbed.
+ *
+ * Returns: %TRUE if the snapshot has been successfully written.
+ */
+gboolean
+na_snapshot_write( const NAPivot *pivot )
+{
+	static const gchar *thisfn = "na_snapshot_write";
+	GVariant *snapshot;
+	gchar *path, *dir;
+	guint loadable;
+	GError *error;
+	gboolean written;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), FALSE );
+
+	g_object_get( G_OBJECT( pivot ), PIVOT_PROP_LOADABLE, &loadable, NULL );
+	path = get_snapshot_path( loadable );
+	dir = g_path_get_dirname( path );
+	written = FALSE;
+
+	if( g_mkdir_with_parents( dir, 0700 ) == 0 ){
+
+		snapshot = g_variant_ref_sink( g_variant_new( SNAPSHOT_TYPE,
+				NA_SNAPSHOT_VERSION, loadable, ( gint64 ) getpid(),
+				na_serializer_tree_to_variant( na_pivot_get_items( pivot ))));
+
+		error = NULL;
+		written = g_file_set_contents( path,
+				( const gchar * ) g_variant_get_data( snapshot ), g_variant_get_size( snapshot ), &error );
+
+		if( written ){
+			g_debug( "%s: %s: %lu bytes written", thisfn, path, ( gulong ) g_variant_get_size( snapshot ));
+
+		} else {
+			g_warning( "%s: %s", thisfn, error->message );
+			g_error_free( error );
+		}
+
+		g_variant_unref( snapshot );
+
+	} else {
+		g_warning( "%s: %s: %s", thisfn, dir, g_strerror( errno ));
+	}
+
+	g_free( dir );
+	g_free( path );
+
+	return( written );
+}
+
+/*
+ * na_snapshot_remove:
+ * @pivot: the #NAPivot whose tree has been written.
+ *
+ * Removes the snapshot.
+ */
+void
+na_snapshot_remove( const NAPivot *pivot )
+{
+	gchar *path;
+	guint loadable;
+
+	g_return_if_fail( NA_IS_PIVOT( pivot ));
+
+	g_object_get( G_OBJECT( pivot ), PIVOT_PROP_LOADABLE, &loadable, NULL );
+	path = get_snapshot_path( loadable );
+	g_unlink( path );
+	g_free( path );
+}
+
+/*
+ * na_snapshot_get_item:
+ * @pivot: the #NAPivot which requests the item.
+ * @loadable_set: the requested loadable set.
+ * @id: the identifier of the searched item.
+ *
+ * Maps the snapshot which has been written for this @loadable_set, and
+ * only rebuilds the searched item.
+ *
+ * Returns: a newly allocated #NAObjectItem, which should be g_object_unref()
+ * by the caller, or %NULL if there is no usable snapshot or the item
+ * has not been found in it.
+ */
+NAObjectItem *
+na_snapshot_get_item( const NAPivot *pivot, guint loadable_set, const gchar *id )
+{
+	static const gchar *thisfn = "na_snapshot_get_item";
+	NAObjectItem *item;
+	GMappedFile *mapped;
+	GVariant *snapshot, *image;
+	gchar *path;
+	guint32 version, loadable;
+	gint64 pid;
+
+	g_return_val_if_fail( NA_IS_PIVOT( pivot ), NULL );
+
+	item = NULL;
+	path = get_snapshot_path( loadable_set );
+	mapped = g_mapped_file_new( path, FALSE, NULL );
+
+	if( mapped ){
+
+		/* the variant is not trusted: GVariant will so check the
+		 * offsets each time they are dereferenced
+		 */
+		snapshot = g_variant_ref_sink( g_variant_new_from_data(
+				G_VARIANT_TYPE( SNAPSHOT_TYPE ),
+				g_mapped_file_get_contents( mapped ), g_mapped_file_get_length( mapped ),
+				FALSE, ( GDestroyNotify ) g_mapped_file_unref, mapped ));
+
+		g_variant_get( snapshot, "(uux@v)", &version, &loadable, &pid, NULL );
+
+		if( version != NA_SNAPSHOT_VERSION || loadable != loadable_set ){
+			g_debug( "%s: %s: version=%u, loadable=%u: ignored", thisfn, path, version, loadable );
+
+		} else if( !is_writer_alive( pid )){
+			g_debug( "%s: %s: writer pid=%ld is no more alive: ignored", thisfn, path, ( glong ) pid );
+
+		} else {
+			g_variant_get_child( snapshot, 3, "v", &image );
+			item = na_serializer_item_from_variant( pivot, image, id );
+			g_variant_unref( image );
+		}
+
+		g_variant_unref( snapshot );
+	}
+
+	g_free( path );
+
+	return( item );
+}
+
+static gchar *
+get_snapshot_path( guint loadable_set )
+{
+	gchar *fname, *path;
+
+	fname = g_strdup_printf( "items-%u.snapshot", loadable_set );
+#if GLIB_CHECK_VERSION( 2,28,0 )
+	path = g_build_filename( g_get_user_runtime_dir(), PACKAGE, fname, NULL );
+#else
+	path = g_build_filename( g_get_user_cache_dir(), PACKAGE, fname, NULL );
+#endif
+	g_free( fname );
+
+	return( path );
+}
+
+static gboolean
+is_writer_alive( gint64 pid )
+{
+	return( pid > 0 && ( kill(( pid_t ) pid, 0 ) == 0 || errno == EPERM ));
+}
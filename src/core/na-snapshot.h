@@ -0,0 +1,64 @@
+/*
+ * Nautilus-Actions
+ * A Nautilus extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2014 Pierre Wieser and others (see AUTHORS)
+ *
+ * Nautilus-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Nautilus-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Nautilus-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifndef __CORE_NA_SNAPSHOT_H__
+#define __CORE_NA_SNAPSHOT_H__
+
+/* @title: NASnapshot
+ * @short_description: The read-only snapshot of the items tree
+ * @include: core/na-snapshot.h
+ *
+ * The process which has loaded the items tree (usually the Nautilus
+ * menu plugin) may write a snapshot of it in the user runtime directory,
+ * which lives in memory on most systems.
+ *
+ * The snapshot is a serialized, pointer-free and versioned image (see
+ * na-serializer.h), where each entry is reachable through the offset
+ * table of its container. A consumer maps the file read-only, and only
+ * rebuilds the objects it actually needs (e.g. nautilus-actions-run just
+ * rebuilds the action it is asked to execute).
+ *
+ * The snapshot is rewritten each time the tree is reloaded, and ignored
+ * by the consumers as soon as its writer is no more alive.
+ */
+
+#include "na-pivot.h"
+
+G_BEGIN_DECLS
+
+#define NA_SNAPSHOT_VERSION				1
+
+gboolean      na_snapshot_write   ( const NAPivot *pivot );
+void          na_snapshot_remove  ( const NAPivot *pivot );
+
+NAObjectItem *na_snapshot_get_item( const NAPivot *pivot, guint loadable_set, const gchar *id );
+
+G_END_DECLS
+
+#endif /* __CORE_NA_SNAPSHOT_H__ */
@@ -31,10 +31,43 @@
 #include <config.h>
 #endif
 
+#include <api/na-core-utils.h>
 #include <api/na-timeout.h>
 
-static gboolean on_timeout_event_timeout( NATimeout *timeout );
-static gulong   time_val_diff( const GTimeVal *recent, const GTimeVal *old );
+/* the coalescing scheduler
+ *
+ * all NATimeout structures share a single list of pending events, and a
+ * single one-shot timer which is armed on the earliest deadline; no
+ * source is ever polled.
+ *
+ * the scheduling state of a pending event is kept in the list rather
+ * than in the public NATimeout structure, whose layout is part of the
+ * API.
+ *
+ * when an event pushes its deadline later while the timer is already
+ * armed, the timer is left untouched: it will expire without having
+ * anything to dispatch, and only then be re-armed on the new earliest
+ * deadline - this is cheaper than re-arming the timer on each event of
+ * a burst.
+ */
+typedef struct {
+	NATimeout *event;
+	gint64     first_time;
+	gint64     deadline;
+}
+	Pending;
+
+static GList    *st_pending        = NULL;
+static GList    *st_dispatched     = NULL;
+static guint     st_source_id      = 0;
+static gint64    st_source_time    = 0;
+static gboolean  st_dispatching    = FALSE;
+static guint     st_max_factor     = 5;			/* max latency, as a count of timeouts */
+
+static void       schedule( void );
+static gboolean   on_scheduler_timeout( void *empty );
+static Pending   *get_pending( NATimeout *event );
+static Pending   *get_first_expired( gint64 now );
 
 /**
  * na_timeout_event:
@@ -43,55 +76,173 @@ static gulong   time_val_diff( const GTimeVal *recent, const GTimeVal *old );
 void
 na_timeout_event( NATimeout *event )
 {
+	Pending *pending;
+	gint64 now;
+	gint64 timeout_usec;
+
 	g_return_if_fail( event != NULL );
 
+	now = na_core_utils_get_monotonic_time();
+	timeout_usec = 1000 * ( gint64 ) event->timeout;
 	g_get_current_time( &event->last_time );
 
-	if( !event->source_id ){
-		event->source_id = g_timeout_add( event->timeout, ( GSourceFunc ) on_timeout_event_timeout, event );
+	pending = get_pending( event );
+	if( !pending ){
+		pending = g_new0( Pending, 1 );
+		pending->event = event;
+		pending->first_time = now;
+		st_pending = g_list_prepend( st_pending, pending );
+	}
+
+	/* an event recorded while the scheduler is dispatching has been
+	 * triggered by one of the dispatched handlers: handle it in the same
+	 * pass (but only once per pass)
+	 */
+	if( st_dispatching && !g_list_find( st_dispatched, event )){
+		pending->deadline = now;
+
+	} else {
+		pending->deadline = MIN( now + timeout_usec, pending->first_time + st_max_factor * timeout_usec );
+	}
+
+	if( !st_dispatching ){
+		schedule();
+	}
+}
+
+/**
+ * na_timeout_remove:
+ * @timeout: the #NATimeout structure to be removed.
+ *
+ * Cancels a possibly pending event, so that the @timeout structure may
+ * be safely released.
+ *
+ * Since: 3.2.5
+ */
+void
+na_timeout_remove( NATimeout *event )
+{
+	Pending *pending;
+
+	g_return_if_fail( event != NULL );
+
+	pending = get_pending( event );
+	if( pending ){
+		st_pending = g_list_remove( st_pending, pending );
+		g_free( pending );
+	}
+
+	st_dispatched = g_list_remove( st_dispatched, event );
+
+	if( !st_dispatching ){
+		schedule();
 	}
 }
 
 /*
- * this timer is set when we receive the first event of a serie
- * we continue to loop until last event is older that our burst timeout
+ * make sure the timer is armed no later than the earliest deadline
  */
-static gboolean
-on_timeout_event_timeout( NATimeout *timeout )
+static void
+schedule( void )
 {
-	GTimeVal now;
-	gulong diff;
-	gulong timeout_usec;
+	GList *it;
+	gint64 deadline;
+	gint64 delay;
 
-	g_get_current_time( &now );
-	diff = time_val_diff( &now, &timeout->last_time );
-	timeout_usec = 1000*timeout->timeout;
+	if( !st_pending ){
+		if( st_source_id ){
+			g_source_remove( st_source_id );
+			st_source_id = 0;
+		}
+		return;
+	}
 
-	if( diff < timeout_usec ){
-		/* do not stop */
-		return( TRUE );
+	deadline = (( Pending * ) st_pending->data )->deadline;
+	for( it = st_pending->next ; it ; it = it->next ){
+		deadline = MIN( deadline, (( Pending * ) it->data )->deadline );
 	}
 
-	/* last individual notification is older that the 'timeout' parameter
-	 * we may so suppose that the burst is terminated
-	 * and feel authorized to trigger the defined callback
-	 */
-	( *timeout->handler )( timeout->user_data );
+	if( st_source_id && st_source_time <= deadline ){
+		return;
+	}
 
-	/* at the end of the callback execution, reset the event source id.
-	 * and stop the execution of this one
-	 */
-	timeout->source_id = 0;
-	return( FALSE );
+	if( st_source_id ){
+		g_source_remove( st_source_id );
+	}
+
+	delay = MAX( 0, deadline - na_core_utils_get_monotonic_time());
+	st_source_time = deadline;
+	st_source_id = g_timeout_add(( guint )(( delay + 999 ) / 1000 ), ( GSourceFunc ) on_scheduler_timeout, NULL );
 }
 
 /*
- * returns the difference in microseconds.
+ * the timer has expired: trigger the handlers of all expired events,
+ * including those which are chained from the handlers themselves,
+ * then re-arm the timer on the next deadline
  */
-static gulong
-time_val_diff( const GTimeVal *recent, const GTimeVal *old )
+static gboolean
+on_scheduler_timeout( void *empty )
+{
+	Pending *pending;
+	NATimeout *event;
+
+	st_source_id = 0;
+	st_dispatching = TRUE;
+
+	while(( pending = get_first_expired( na_core_utils_get_monotonic_time()))){
+
+		/* the event is no more pending when the handler is triggered,
+		 * so that the handler may itself record a new event
+		 */
+		event = pending->event;
+		st_pending = g_list_remove( st_pending, pending );
+		g_free( pending );
+		st_dispatched = g_list_prepend( st_dispatched, event );
+
+		( *event->handler )( event->user_data );
+	}
+
+	g_list_free( st_dispatched );
+	st_dispatched = NULL;
+	st_dispatching = FALSE;
+
+	schedule();
+
+	return( FALSE );
+}
+
+static Pending *
+get_pending( NATimeout *event )
 {
-	gulong microsec = 1000000 * ( recent->tv_sec - old->tv_sec );
-	microsec += recent->tv_usec  - old->tv_usec;
-	return( microsec );
+	GList *it;
+	Pending *found;
+
+	found = NULL;
+
+	for( it = st_pending ; it && !found ; it = it->next ){
+		if((( Pending * ) it->data )->event == event ){
+			found = ( Pending * ) it->data;
+		}
+	}
+
+	return( found );
+}
+
+static Pending *
+get_first_expired( gint64 now )
+{
+	GList *it;
+	Pending *pending;
+	Pending *first;
+
+	first = NULL;
+
+	for( it = st_pending ; it ; it = it->next ){
+		pending = ( Pending * ) it->data;
+		if( pending->deadline <= now && ( !first || pending->deadline < first->deadline )){
+			first = pending;
+		}
+	}
+
+	return( first );
 }
@@ -31,7 +31,6 @@
 #include <config.h>
 #endif
 
-#include <gio/gunixinputstream.h>
 #include <glib/gi18n.h>
 #include <gtk/gtk.h>
 #include <string.h>
@@ -68,17 +67,125 @@ struct _NATokensPrivate {
 	gchar   *scheme;
 };
 
+/* the output of a child run in 'DisplayOutput' execution mode
+ *
+ * each of the standard output and standard error streams is read as
+ * soon as data is available, and inserted in the text buffer at its mark
+ */
+typedef struct _DisplayOutput DisplayOutput;
+
+typedef struct {
+	DisplayOutput *display;
+	GIOChannel    *channel;
+	guint          source_id;
+	GString       *pending;				/* the bytes which have not been converted yet */
+	gsize          length;				/* count of kept bytes */
+	gboolean       truncated;
+	GtkTextMark   *mark;
+}
+	OutputStream;
+
+struct _DisplayOutput {
+	gchar         *command;
+	GtkTextBuffer *buffer;
+	OutputStream   out;
+	OutputStream   err;
+	gboolean       exited;
+	gboolean       shown;
+	GtkWidget     *dialog;
+	GtkWidget     *view;
+};
+
+/* the max count of bytes kept for each output stream, the max count of
+ * bytes read at once, and the max length of a multibyte character
+ */
+#define OUTPUT_MAX_LENGTH				( 1024*1024 )
+#define OUTPUT_READ_MAX					( 64*1024 )
+#define OUTPUT_CHAR_MAX					4
+
 /*  the structure passed to the callback which waits for the end of the child
  */
 typedef struct {
-	gchar   *command;
-	gboolean is_output_displayed;
-	gint     child_stdout;
-	gint     child_stderr;
+	gchar         *command;
+	gboolean       is_output_displayed;
+	gint           child_stdout;
+	gint           child_stderr;
+	guint          files;				/* count of selected items handled by the command */
+	DisplayOutput *display;
+	gpointer       activation;			/* the (ref'd) Activation the command belongs to */
 }
 	ChildStr;
 
+/* a piece of a word of a pre-parsed command-line: either a literal
+ * text, or the slot of a token
+ */
+typedef struct {
+	gchar   *text;						/* the literal text, or NULL for a slot */
+	gchar    token;						/* the character which follows the '%' sign */
+}
+	ExecPiece;
+
+/* the command-line of a profile, pre-parsed once for all its activations
+ *
+ * the templates are kept in a process-wide cache keyed by the
+ * command-line, as the profile which is activated from the Nautilus
+ * extension is a new duplicate at each popup
+ */
+typedef struct {
+	guint     ref_count;
+	gchar    *exec;						/* the command-line before having been parsed */
+	gboolean  singular;
+	gboolean  compiled;					/* whether the command-line has been pre-parsed */
+	GSList   *words;					/* a list of words, each being a list of ExecPiece structs */
+}
+	ExecTemplate;
+
+/* the max count of cached templates; the cache is just emptied when it
+ * is full, as it would only be so after many edits of the profiles
+ */
+#define EXEC_TEMPLATE_CACHE_MAX			256
+
+/* an activation of a profile, whose commands are waiting to be run
+ */
+typedef struct {
+	guint         ref_count;			/* the scheduler and each running child */
+	NATokens     *tokens;
+	ExecTemplate *template;				/* the pre-parsed command-line of the profile */
+	gchar        *execution_mode;
+	gchar        *wdir;					/* the parsed working directory */
+	gboolean      singular;
+	guint         count;				/* count of selected items */
+	guint         batch;				/* max count of items per plural command, zero if not batched */
+	guint         max_length;			/* max length of a plural command-line */
+	guint         next;					/* index of the next item to be run */
+	gboolean      done;
+	guint         running;				/* count of currently running children */
+}
+	Activation;
+
+/* the execution scheduler, which is shared by all the activations of
+ * the running process
+ */
+typedef struct {
+	GQueue *waiting;					/* the queue of Activation structs */
+	guint   running;					/* total count of currently running children */
+	guint   done;						/* progress in count of selected items */
+	guint   total;
+}
+	Scheduler;
+
 static GObjectClass *st_parent_class = NULL;
+static Scheduler     st_scheduler    = { NULL, 0, 0, 0 };
+
+/* the terminal pattern is read once, and then each time it is modified
+ */
+static gchar        *st_terminal_pattern = NULL;
+static gboolean      st_terminal_read    = FALSE;
+static gboolean      st_terminal_watched = FALSE;
+
+/* the cache of pre-parsed command-lines
+ */
+static GHashTable   *st_exec_templates   = NULL;
 
 static GType     register_type( void );
 static void      class_init( NATokensClass *klass );
@@ -86,15 +193,42 @@ static void      instance_init( GTypeInstance *instance, gpointer klass );
 static void      instance_dispose( GObject *object );
 static void      instance_finalize( GObject *object );
 
+static void      scheduler_run( void );
+static gchar   **activation_next_argv( Activation *activation, guint *files, gchar **command );
+static gchar   **activation_get_argv( Activation *activation, const NATokens *tokens, guint i, gchar **command );
+static void      activation_unref( Activation *activation );
+static gsize     argv_length( gchar **argv );
+static gchar    *argv_to_command( gchar **argv );
+static ExecTemplate *exec_template_get( const NAObjectProfile *profile );
+static gboolean  exec_template_compile( ExecTemplate *template );
+static void      exec_template_push_literal( GSList **pieces, GString *literal, gboolean *started );
+static void      exec_template_push_word( ExecTemplate *template, GSList **pieces, GString *literal, gboolean *started );
+static gchar   **exec_template_fill( const ExecTemplate *template, const NATokens *tokens, guint i );
+static void      exec_template_fill_word( GSList *pieces, const NATokens *tokens, guint i, GPtrArray *argv );
+static GString  *exec_template_word_append( GString *word, const gchar *text );
+static GSList   *exec_template_token_list( const NATokens *tokens, gchar token );
+static void      exec_template_free_words( ExecTemplate *template );
+static void      exec_template_unref( ExecTemplate *template );
+static NATokens *tokens_new_slice( const NATokens *tokens, guint first, guint count );
+static GSList   *slist_slice( GSList *list, guint first, guint count );
 static void      child_watch_fn( GPid pid, gint status, ChildStr *child_str );
-static void      display_output( const gchar *command, int fd_stdout, int fd_stderr );
-static gchar    *display_output_get_content( int fd );
-static void      execute_action_command( gchar *command, const NAObjectProfile *profile, const NATokens *tokens );
+static DisplayOutput *display_output_new( const gchar *command, gint fd_stdout, gint fd_stderr );
+static void      display_output_stream_init( DisplayOutput *display, OutputStream *stream, gint fd, gint offset );
+static gboolean  display_output_on_readable( GIOChannel *channel, GIOCondition condition, OutputStream *stream );
+static void      display_output_stream_append( OutputStream *stream, const gchar *data, gsize count );
+static void      display_output_stream_convert( OutputStream *stream, gboolean flush );
+static void      display_output_stream_insert( OutputStream *stream, const gchar *text );
+static void      display_output_show( DisplayOutput *display );
+static void      display_output_on_destroy( GtkWidget *dialog, DisplayOutput *display );
+static void      display_output_check_end( DisplayOutput *display );
+static gboolean  execute_action_command( gchar **argv, const gchar *command, Activation *activation, guint files );
+static gchar    *get_command_execution( const gchar *command, const gchar *execution_mode );
 static gchar    *get_command_execution_display_output( const gchar *command );
 static gchar    *get_command_execution_embedded( const gchar *command );
 static gchar    *get_command_execution_normal( const gchar *command );
 static gchar    *get_command_execution_terminal( const gchar *command );
-static gboolean  is_singular_exec( const NATokens *tokens, const gchar *exec );
+static void      on_terminal_pattern_changed( const gchar *group, const gchar *key, gconstpointer new_value, gboolean mandatory, void *user_data );
+static gboolean  is_singular_exec( const gchar *exec );
 static gchar    *parse_singular( const NATokens *tokens, const gchar *input, guint i, gboolean utf8, gboolean quoted );
 static GString  *quote_string( GString *input, const gchar *name, gboolean quoted );
 static GString  *quote_string_list( GString *input, GSList *names, gboolean quoted );
@@ -374,257 +508,1263 @@ na_tokens_parse_for_display( const NATokens *tokens, const gchar *string, gboole
  * @profile: the #NAObjectProfile to be executed.
  *
  * Execute the given action, regarding the context described by @tokens.
+ *
+ * The commands are not run at once, but queued to an execution scheduler
+ * which limits the count of simultaneously running children of each
+ * activation to the 'execution-max-children' preference, so that the
+ * commands of one activation do not delay those of the others. They are
+ * only built when they are about to be run, so that a large selection
+ * does not fill the memory.
+ *
+ * When the command is of plural form, and the 'execution-max-length'
+ * preference is set, the selection is split in as many commands as
+ * needed so that each command-line stays shorter than this length.
+ *
+ * The command-line of the profile is only parsed at its first
+ * activation, and is then kept with the profile as a template whose
+ * slots are just filled with the values of the selection.
  */
 void
 na_tokens_execute_action( const NATokens *tokens, const NAObjectProfile *profile )
 {
-	gchar *path, *parameters, *exec;
-	gboolean singular;
-	guint i;
-	gchar *command;
+	static const gchar *thisfn = "na_tokens_execute_action";
+	Activation *activation;
+	gchar *wdir;
+	gchar **argv;
+	guint max_length;
+	gsize length;
 
-	path = na_object_get_path( profile );
-	parameters = na_object_get_parameters( profile );
-	exec = g_strdup_printf( "%s %s", path, parameters );
-	g_free( parameters );
-	g_free( path );
+	activation = g_new0( Activation, 1 );
+	activation->ref_count = 1;
+	activation->template = exec_template_get( profile );
+	activation->singular = activation->template->singular;
+	activation->count = tokens->private->count;
 
-	singular = is_singular_exec( tokens, exec );
+	/* a singular form command is executed one time for each element of
+	 * the selection, i.e. not at all if the selection is empty
+	 */
+	if( activation->singular && !activation->count ){
+		activation_unref( activation );
+		return;
+	}
 
-	if( singular ){
-		for( i = 0 ; i < tokens->private->count ; ++i ){
-			command = parse_singular( tokens, exec, i, FALSE, TRUE );
-			execute_action_command( command, profile, tokens );
-			g_free( command );
+	activation->tokens = g_object_ref(( gpointer ) tokens );
+	activation->execution_mode = na_object_get_execution_mode( profile );
+
+	wdir = na_object_get_working_dir( profile );
+	activation->wdir = parse_singular( tokens, wdir, 0, FALSE, FALSE );
+	g_free( wdir );
+
+	if( !activation->singular && activation->count > 1 ){
+		max_length = na_settings_get_uint( NA_IPREFS_EXECUTION_MAX_LENGTH, NULL, NULL );
+
+		if( max_length ){
+			argv = activation_get_argv( activation, tokens, 0, NULL );
+			length = argv_length( argv );
+			g_strfreev( argv );
+
+			if( length > max_length ){
+				activation->max_length = max_length;
+				activation->batch = MAX( 1, ( guint )(( guint64 ) activation->count * max_length / length ));
+			}
 		}
+	}
 
-	} else {
-		command = parse_singular( tokens, exec, 0, FALSE, TRUE );
-		execute_action_command( command, profile, tokens );
-		g_free( command );
+	g_debug( "%s: exec=%s, singular=%s, count=%u, batch=%u",
+			thisfn, activation->template->exec, activation->singular ? "True":"False", activation->count, activation->batch );
+
+	if( !st_scheduler.waiting ){
+		st_scheduler.waiting = g_queue_new();
 	}
+	g_queue_push_tail( st_scheduler.waiting, activation );
+	st_scheduler.total += activation->count;
 
-	g_free( exec );
+	scheduler_run();
 }
 
-static void
-child_watch_fn( GPid pid, gint status, ChildStr *child_str )
+/*
+ * na_tokens_get_execution_progress:
+ * @done: [out][allow-none]: set to the count of selected items whose
+ *  command has been run until its end.
+ * @total: [out][allow-none]: set to the total count of selected items
+ *  which have been queued for execution.
+ *
+ * Reports the progress of the execution scheduler. The counts are reset
+ * each time the scheduler becomes idle.
+ *
+ * Returns: %TRUE if some commands are still waiting to be run.
+ *
+ * Since: 3.2.5
+ */
+gboolean
+na_tokens_get_execution_progress( guint *done, guint *total )
 {
-	static const gchar *thisfn = "na_tokens_child_watch_fn";
-
-	g_debug( "%s: pid=%u, status=%d", thisfn, ( guint ) pid, status );
-	g_spawn_close_pid( pid );
-	if( child_str->is_output_displayed ){
-		display_output( child_str->command, child_str->child_stdout, child_str->child_stderr );
+	if( done ){
+		*done = st_scheduler.done;
 	}
-	g_free( child_str->command );
-	g_free( child_str );
+	if( total ){
+		*total = st_scheduler.total;
+	}
+
+	return( st_scheduler.waiting && !g_queue_is_empty( st_scheduler.waiting ));
 }
 
+/*
+ * for each waiting activation, run as many commands as its max count of
+ * children allows
+ *
+ * the cap is applied per activation: a child counts as running until it
+ * exits, and long-lived children (e.g. GUI applications) would else
+ * prevent any further activation from being run
+ */
 static void
-display_output( const gchar *command, int fd_stdout, int fd_stderr )
+scheduler_run( void )
 {
-	GtkWidget *dialog;
-	gchar *std_output, *std_error;
+	static const gchar *thisfn = "na_tokens_scheduler_run";
+	guint max_children;
+	Activation *activation;
+	GList *it, *next;
+	gchar **argv;
+	gchar *command;
+	guint files;
+
+	max_children = na_settings_get_uint( NA_IPREFS_EXECUTION_MAX_CHILDREN, NULL, NULL );
+
+	for( it = st_scheduler.waiting ? st_scheduler.waiting->head : NULL ; it ; it = next ){
+		next = it->next;
+		activation = ( Activation * ) it->data;
 
-	dialog = gtk_message_dialog_new_with_markup(
-			NULL, GTK_DIALOG_MODAL, GTK_MESSAGE_INFO, GTK_BUTTONS_OK, "<b>%s</b>", _( "Output of the run command" ));
-	g_object_set( G_OBJECT( dialog ) , "title", PACKAGE_NAME, NULL );
+		while( !activation->done && ( !max_children || activation->running < max_children )){
+			argv = activation_next_argv( activation, &files, &command );
 
-	std_output = display_output_get_content( fd_stdout );
-	std_error = display_output_get_content( fd_stderr );
+			if( argv && execute_action_command( argv, command, activation, files )){
+				activation->running += 1;
+				st_scheduler.running += 1;
+			} else {
+				st_scheduler.done += files;
+			}
+
+			g_strfreev( argv );
+			g_free( command );
+		}
 
-	gtk_message_dialog_format_secondary_markup( GTK_MESSAGE_DIALOG( dialog ),
-			"<b>%s</b>\n%s\n\n<b>%s</b>\n%s\n\n<b>%s</b>\n%s\n\n",
-					_( "Run command:" ), command,
-					_( "Standard output:" ), std_output,
-					_( "Standard error:" ), std_error );
+		if( activation->done ){
+			g_queue_delete_link( st_scheduler.waiting, it );
+			activation_unref( activation );
+		}
+	}
 
-	gtk_dialog_run( GTK_DIALOG( dialog ));
-	gtk_widget_destroy( dialog );
+	g_debug( "%s: done=%u/%u, running=%u, waiting=%u",
+			thisfn, st_scheduler.done, st_scheduler.total, st_scheduler.running,
+			st_scheduler.waiting ? g_queue_get_length( st_scheduler.waiting ) : 0 );
 
-	g_free( std_output );
-	g_free( std_error );
+	/* reset the progress counts when the scheduler becomes idle
+	 */
+	if( !st_scheduler.running && ( !st_scheduler.waiting || g_queue_is_empty( st_scheduler.waiting ))){
+		st_scheduler.done = 0;
+		st_scheduler.total = 0;
+	}
 }
 
-static gchar *
-display_output_get_content( int fd )
+/*
+ * build the argument vector of the next command of the activation
+ *
+ * @files is set to the count of selected items which are handled by
+ * this command, and @command to its command-line, as it is displayed to
+ * the user
+ */
+static gchar **
+activation_next_argv( Activation *activation, guint *files, gchar **command )
 {
-	static const gchar *thisfn = "na_tokens_display_output_get_content";
-	GInputStream *stream;
-	GString *string;
-	gchar buf[1024];
-	GError *error;
-	gchar *msg;
+	gchar **argv;
+	NATokens *slice;
+	guint count;
 
-	string = g_string_new( "" );
-	memset( buf, '\0', sizeof( buf ));
+	if( activation->singular ){
+		argv = activation_get_argv( activation, activation->tokens, activation->next, command );
+		*files = 1;
 
-	if( fd > 0 ){
-		stream = g_unix_input_stream_new( fd, TRUE );
-		error = NULL;
+	} else if( !activation->batch ){
+		argv = activation_get_argv( activation, activation->tokens, 0, command );
+		*files = activation->count;
 
-		while( g_input_stream_read( stream, buf, sizeof( buf )-1, NULL, &error )){
-			string = g_string_append( string, buf );
-			memset( buf, '\0', sizeof( buf ));
-		}
-		if( error ){
-			g_warning( "%s: g_input_stream_read: %s", thisfn, error->message );
-			g_error_free( error );
+	/* xargs-like: the batch is halved while the command-line is too long
+	 */
+	} else {
+		count = MIN( activation->batch, activation->count - activation->next );
+
+		while( TRUE ){
+			slice = tokens_new_slice( activation->tokens, activation->next, count );
+			argv = activation_get_argv( activation, slice, 0, command );
+			g_object_unref( slice );
+
+			if( count == 1 || argv_length( argv ) <= activation->max_length ){
+				break;
+			}
+
+			g_strfreev( argv );
+			g_free( *command );
+			count = MAX( 1, count / 2 );
 		}
-		g_input_stream_close( stream, NULL, NULL );
+
+		*files = count;
 	}
 
-	msg = g_locale_to_utf8( string->str, -1, NULL, NULL, NULL );
-	g_string_free( string, TRUE );
+	activation->next += *files;
+	activation->done = ( activation->next >= activation->count );
 
-	return( msg );
+	return( argv );
 }
 
 /*
- * Execution environment:
- * - Normal: just execute the specified command
- * - Terminal: use the user preference to have a terminal which stays openeded
- * - Embedded: id. Terminal
- * - DisplayOutput: execute in a shell
+ * build the argument vector of the command for the @i-th item of the
+ * selection described by @tokens
+ *
+ * when the command is run in 'Normal' mode, and the command-line of the
+ * profile has been pre-parsed, the slots of the template are just
+ * filled; else the command-line is parsed, and possibly inserted in a
+ * terminal or shell command-line, which is then itself parsed
+ *
+ * if not %NULL, @command is set to the command-line, quoting included,
+ * as it is displayed to the user; it should be g_free() by the caller
+ *
+ * Returns: a newly allocated argument vector, or %NULL.
  */
-static void
-execute_action_command( gchar *command, const NAObjectProfile *profile, const NATokens *tokens )
+static gchar **
+activation_get_argv( Activation *activation, const NATokens *tokens, guint i, gchar **command )
 {
-	static const gchar *thisfn = "nautilus_actions_execute_action_command";
-	GError *error;
-	gchar *execution_mode, *run_command;
+	static const gchar *thisfn = "na_tokens_activation_get_argv";
 	gchar **argv;
-	gint argc;
-	gchar *wdir, *wdir_nq;
-	GPid child_pid;
-	ChildStr *child_str;
-
-	g_debug( "%s: profile=%p", thisfn, ( void * ) profile );
+	gchar *parsed, *run_command;
+	GError *error;
 
-	error = NULL;
+	argv = NULL;
 	run_command = NULL;
-	child_str = g_new0( ChildStr, 1 );
-	child_pid = ( GPid ) 0;
-	execution_mode = na_object_get_execution_mode( profile );
 
-	if( !strcmp( execution_mode, "Normal" )){
-		run_command = get_command_execution_normal( command );
+	if( activation->template->compiled && !strcmp( activation->execution_mode, "Normal" )){
+		argv = exec_template_fill( activation->template, tokens, i );
+		if( !argv ){
+			g_warning( "%s: %s: empty command-line", thisfn, activation->template->exec );
 
-	} else if( !strcmp( execution_mode, "Terminal" )){
-		run_command = get_command_execution_terminal( command );
+		} else if( command ){
+			run_command = argv_to_command( argv );
+		}
 
-	} else if( !strcmp( execution_mode, "Embedded" )){
-		run_command = get_command_execution_embedded( command );
+	} else {
+		parsed = parse_singular( tokens, activation->template->exec, i, FALSE, TRUE );
+		run_command = get_command_execution( parsed, activation->execution_mode );
 
-	} else if( !strcmp( execution_mode, "DisplayOutput" )){
-		child_str->is_output_displayed = TRUE;
-		run_command = get_command_execution_display_output( command );
+		if( run_command ){
+			g_debug( "%s: run_command=%s", thisfn, run_command );
+			error = NULL;
+
+			if( !g_shell_parse_argv( run_command, NULL, &argv, &error )){
+				g_warning( "%s: g_shell_parse_argv: %s", thisfn, error->message );
+				g_error_free( error );
+				argv = NULL;
+			}
+		}
+
+		g_free( parsed );
+	}
 
+	if( command ){
+		*command = run_command;
 	} else {
-		g_warning( "%s: unknown execution mode: %s", thisfn, execution_mode );
+		g_free( run_command );
 	}
 
-	if( run_command ){
-		child_str->command = g_strdup( run_command );
+	return( argv );
+}
 
-		if( !g_shell_parse_argv( run_command, &argc, &argv, &error )){
-			g_warning( "%s: g_shell_parse_argv: %s", thisfn, error->message );
-			g_error_free( error );
+static void
+activation_unref( Activation *activation )
+{
+	activation->ref_count -= 1;
+	if( activation->ref_count ){
+		return;
+	}
+
+	if( activation->tokens ){
+		g_object_unref( activation->tokens );
+	}
+	if( activation->template ){
+		exec_template_unref( activation->template );
+	}
+
+	g_free( activation->wdir );
+	g_free( activation->execution_mode );
+	g_free( activation );
+}
+
+/*
+ * the length of the command-line, as counted by the system
+ */
+static gsize
+argv_length( gchar **argv )
+{
+	gsize length;
 
+	for( length = 0 ; argv && *argv ; ++argv ){
+		length += strlen( *argv ) + 1;
+	}
+
+	return( length );
+}
+
+/*
+ * the command-line which gives back @argv when parsed, only quoting the
+ * arguments which need it
+ */
+static gchar *
+argv_to_command( gchar **argv )
+{
+	GString *command;
+	gchar *quoted;
+
+	command = g_string_new( "" );
+
+	for( ; argv && *argv ; ++argv ){
+		if( command->len ){
+			g_string_append_c( command, ' ' );
+		}
+		if( !strlen( *argv ) || strpbrk( *argv, " \t\n'\"\\$`#&|;<>()*?[]{}~" )){
+			quoted = g_shell_quote( *argv );
+			g_string_append( command, quoted );
+			g_free( quoted );
 		} else {
-			wdir = na_object_get_working_dir( profile );
-			wdir_nq = parse_singular( tokens, wdir, 0, FALSE, FALSE );
-			g_debug( "%s: run_command=%s, wdir=%s", thisfn, run_command, wdir_nq );
-
-			/* it appears that at least mplayer does not support g_spawn_async_with_pipes
-			 * (at least when not run in '-quiet' mode) while, e.g., totem and vlc rightly
-			 * support this function
-			 * So only use g_spawn_async_with_pipes when we really need to get back
-			 * the content of output and error streams
-			 * See https://bugzilla.gnome.org/show_bug.cgi?id=644289.
-			 */
-			if( child_str->is_output_displayed ){
-				g_spawn_async_with_pipes(
-						wdir_nq,
-						argv,
-						NULL,
-						G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD,
-						NULL,
-						NULL,
-						&child_pid,
-						NULL,
-						&child_str->child_stdout,
-						&child_str->child_stderr,
-						&error );
+			g_string_append( command, *argv );
+		}
+	}
+
+	return( g_string_free( command, FALSE ));
+}
+
+/*
+ * returns the template of the command-line of the profile, building it
+ * if it is not in the cache yet
+ *
+ * the returned template has been referenced, and should be
+ * exec_template_unref() by the caller
+ */
+static ExecTemplate *
+exec_template_get( const NAObjectProfile *profile )
+{
+	static const gchar *thisfn = "na_tokens_exec_template_get";
+	ExecTemplate *template;
+	gchar *path, *parameters, *exec;
+
+	path = na_object_get_path( profile );
+	parameters = na_object_get_parameters( profile );
+	exec = g_strdup_printf( "%s %s", path, parameters );
+	g_free( parameters );
+	g_free( path );
+
+	if( !st_exec_templates ){
+		st_exec_templates = g_hash_table_new_full( g_str_hash, g_str_equal, NULL, ( GDestroyNotify ) exec_template_unref );
+	}
+
+	template = ( ExecTemplate * ) g_hash_table_lookup( st_exec_templates, exec );
 
+	if( template ){
+		g_free( exec );
+
+	} else {
+		template = g_new0( ExecTemplate, 1 );
+		template->ref_count = 1;
+		template->exec = exec;
+		template->singular = is_singular_exec( template->exec );
+		template->compiled = exec_template_compile( template );
+
+		g_debug( "%s: profile=%p, exec=%s, compiled=%s",
+				thisfn, ( void * ) profile, template->exec, template->compiled ? "True":"False" );
+
+		if( g_hash_table_size( st_exec_templates ) >= EXEC_TEMPLATE_CACHE_MAX ){
+			g_hash_table_remove_all( st_exec_templates );
+		}
+
+		/* the key is owned by the template */
+		g_hash_table_insert( st_exec_templates, template->exec, template );
+	}
+
+	template->ref_count += 1;
+
+	return( template );
+}
+
+/*
+ * splits the command-line in words, with the same rules than
+ * g_shell_parse_argv(), each word being a list of literal texts and
+ * slots of tokens
+ *
+ * Returns: %TRUE if the command-line has been pre-parsed, %FALSE if it
+ * is not valid, or if a token is escaped or inside quotes (as the
+ * substituted value is then parsed again): the command-line has then to
+ * be parsed at each activation.
+ */
+static gboolean
+exec_template_compile( ExecTemplate *template )
+{
+	GSList *pieces;
+	GString *literal;
+	gboolean started;
+	gboolean compiled;
+	ExecPiece *piece;
+	gchar quote;
+	const gchar *p;
+
+	pieces = NULL;
+	literal = g_string_new( "" );
+	started = FALSE;
+	compiled = TRUE;
+	quote = '\0';
+
+	for( p = template->exec ; *p && compiled ; ++p ){
+
+		/* inside single quotes, everything is literal
+		 */
+		if( quote == '\'' ){
+			if( *p == '\'' ){
+				quote = '\0';
+			} else if( *p == '%' ){
+				compiled = FALSE;
 			} else {
-				g_spawn_async(
-						wdir_nq,
-						argv,
-						NULL,
-						G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD,
-						NULL,
-						NULL,
-						&child_pid,
-						&error );
+				g_string_append_c( literal, *p );
 			}
 
-			if( error ){
-				g_warning( "%s: g_spawn_async: %s", thisfn, error->message );
-				g_error_free( error );
-				child_pid = ( GPid ) 0;
-
+		/* inside double quotes, a backslash only escapes some characters
+		 */
+		} else if( quote == '"' ){
+			if( *p == '"' ){
+				quote = '\0';
+			} else if( *p == '%' ){
+				compiled = FALSE;
+			} else if( *p == '\\' && p[1] && strchr( "\"\\`$\n", p[1] )){
+				++p;
+				if( *p != '\n' ){
+					g_string_append_c( literal, *p );
+				}
 			} else {
-				g_child_watch_add( child_pid, ( GChildWatchFunc ) child_watch_fn, child_str );
+				g_string_append_c( literal, *p );
 			}
 
-			g_free( wdir );
-			g_free( wdir_nq );
-			g_strfreev( argv );
-		}
+		} else {
+			switch( *p ){
+				case ' ':
+				case '\t':
+				case '\n':
+					exec_template_push_word( template, &pieces, literal, &started );
+					break;
+
+				/* a '#' which begins a word starts a comment, which
+				 * runs until the end of the line
+				 */
+				case '#':
+					if( !started && !pieces ){
+						while( p[1] && p[1] != '\n' ){
+							++p;
+						}
+					} else {
+						g_string_append_c( literal, *p );
+						started = TRUE;
+					}
+					break;
+
+				case '\'':
+				case '"':
+					quote = *p;
+					started = TRUE;
+					break;
+
+				/* an escaped newline is a line continuation
+				 */
+				case '\\':
+					if( !p[1] || p[1] == '%' ){
+						compiled = FALSE;
+					} else {
+						++p;
+						if( *p != '\n' ){
+							g_string_append_c( literal, *p );
+							started = TRUE;
+						}
+					}
+					break;
+
+				case '%':
+					exec_template_push_literal( &pieces, literal, &started );
+					if( p[1] ){
+						++p;
+						piece = g_new0( ExecPiece, 1 );
+						piece->token = *p;
+						pieces = g_slist_prepend( pieces, piece );
+					}
+					break;
 
-		g_free( run_command );
+				default:
+					g_string_append_c( literal, *p );
+					started = TRUE;
+					break;
+			}
+		}
 	}
 
-	g_free( execution_mode );
+	exec_template_push_word( template, &pieces, literal, &started );
+	template->words = g_slist_reverse( template->words );
+	g_string_free( literal, TRUE );
 
-	if( child_pid == ( GPid ) 0 ){
-		g_free( child_str->command );
-		g_free( child_str );
+	if( quote || !template->words ){
+		compiled = FALSE;
+	}
+	if( !compiled ){
+		exec_template_free_words( template );
 	}
-}
 
-static gchar *
-get_command_execution_display_output( const gchar *command )
-{
-	static const gchar *bin_sh = "/bin/sh -c COMMAND";
-	return( na_tokens_command_for_terminal( bin_sh, command ));
+	return( compiled );
 }
 
-static gchar *
-get_command_execution_embedded( const gchar *command )
+static void
+exec_template_push_literal( GSList **pieces, GString *literal, gboolean *started )
 {
-	return( get_command_execution_terminal( command ));
+	ExecPiece *piece;
+
+	if( *started ){
+		piece = g_new0( ExecPiece, 1 );
+		piece->text = g_strdup( literal->str );
+		*pieces = g_slist_prepend( *pieces, piece );
+
+		g_string_truncate( literal, 0 );
+		*started = FALSE;
+	}
 }
 
-static gchar *
-get_command_execution_normal( const gchar *command )
+static void
+exec_template_push_word( ExecTemplate *template, GSList **pieces, GString *literal, gboolean *started )
 {
-	return( g_strdup( command ));
+	exec_template_push_literal( pieces, literal, started );
+
+	if( *pieces ){
+		template->words = g_slist_prepend( template->words, g_slist_reverse( *pieces ));
+		*pieces = NULL;
+	}
 }
 
-static gchar *
-get_command_execution_terminal( const gchar *command )
+/*
+ * fills the slots of the template with the values of the @i-th item of
+ * the selection, giving the same argument vector than
+ * g_shell_parse_argv() would have given on the parsed command-line
+ *
+ * Returns: a newly allocated argument vector, or %NULL if it is empty.
+ */
+static gchar **
+exec_template_fill( const ExecTemplate *template, const NATokens *tokens, guint i )
 {
-	gchar *run_command;
-	gchar *pattern;
+	GPtrArray *argv;
+	GSList *iw;
 
-	pattern = na_settings_get_string( NA_IPREFS_TERMINAL_PATTERN, NULL, NULL );
-	run_command = na_tokens_command_for_terminal( pattern, command );
-	g_free( pattern );
+	argv = g_ptr_array_new();
 
-	return( run_command );
+	for( iw = template->words ; iw ; iw = iw->next ){
+		exec_template_fill_word(( GSList * ) iw->data, tokens, i, argv );
+	}
+
+	if( !argv->len ){
+		g_ptr_array_free( argv, TRUE );
+		return( NULL );
+	}
+
+	g_ptr_array_add( argv, NULL );
+
+	return(( gchar ** ) g_ptr_array_free( argv, FALSE ));
+}
+
+/*
+ * a word of the template gives zero, one or several arguments
+ *
+ * as parse_singular() quotes the values, an empty value gives an empty
+ * argument, but for the mimetypes, the count and the port, which are
+ * never quoted; each value of a plural token starts a new argument
+ */
+static void
+exec_template_fill_word( GSList *pieces, const NATokens *tokens, guint i, GPtrArray *argv )
+{
+	GString *word;
+	GSList *ip, *iv;
+	ExecPiece *piece;
+	const gchar *nth;
+	gboolean first;
+
+	word = NULL;
+
+	for( ip = pieces ; ip ; ip = ip->next ){
+		piece = ( ExecPiece * ) ip->data;
+
+		if( piece->text ){
+			word = exec_template_word_append( word, piece->text );
+			continue;
+		}
+
+		switch( piece->token ){
+			case 'b':
+			case 'd':
+			case 'f':
+			case 'm':
+			case 'u':
+			case 'w':
+			case 'x':
+				nth = ( const gchar * ) g_slist_nth_data( exec_template_token_list( tokens, piece->token ), i );
+				if( nth && ( piece->token != 'm' || strlen( nth ))){
+					word = exec_template_word_append( word, nth );
+				}
+				break;
+
+			case 'B':
+			case 'D':
+			case 'F':
+			case 'M':
+			case 'U':
+			case 'W':
+			case 'X':
+				first = TRUE;
+				for( iv = exec_template_token_list( tokens, piece->token ) ; iv ; iv = iv->next ){
+					nth = ( const gchar * ) iv->data;
+					if( piece->token == 'M' && !strlen( nth )){
+						continue;
+					}
+					if( !first ){
+						g_ptr_array_add( argv, g_string_free( word, FALSE ));
+						word = NULL;
+					}
+					word = exec_template_word_append( word, nth );
+					first = FALSE;
+				}
+				break;
+
+			case 'c':
+				word = exec_template_word_append( word, "" );
+				g_string_append_printf( word, "%d", tokens->private->count );
+				break;
+
+			case 'h':
+				if( tokens->private->hostname ){
+					word = exec_template_word_append( word, tokens->private->hostname );
+				}
+				break;
+
+			case 'n':
+				if( tokens->private->username ){
+					word = exec_template_word_append( word, tokens->private->username );
+				}
+				break;
+
+			case 'p':
+				if( tokens->private->port > 0 ){
+					word = exec_template_word_append( word, "" );
+					g_string_append_printf( word, "%d", tokens->private->port );
+				}
+				break;
+
+			case 's':
+				if( tokens->private->scheme ){
+					word = exec_template_word_append( word, tokens->private->scheme );
+				}
+				break;
+
+			case '%':
+				word = exec_template_word_append( word, "%" );
+				break;
+
+			/* no-op operators, and unknown tokens
+			 */
+		}
+	}
+
+	if( word ){
+		g_ptr_array_add( argv, g_string_free( word, FALSE ));
+	}
+}
+
+static GString *
+exec_template_word_append( GString *word, const gchar *text )
+{
+	return( word ? g_string_append( word, text ) : g_string_new( text ));
+}
+
+/*
+ * returns the list of values which is substituted to the token
+ */
+static GSList *
+exec_template_token_list( const NATokens *tokens, gchar token )
+{
+	GSList *list;
+
+	list = NULL;
+
+	switch( g_ascii_tolower( token )){
+		case 'b':
+			list = tokens->private->basenames;
+			break;
+
+		case 'd':
+			list = tokens->private->basedirs;
+			break;
+
+		case 'f':
+			list = tokens->private->filenames;
+			break;
+
+		case 'm':
+			list = tokens->private->mimetypes;
+			break;
+
+		case 'u':
+			list = tokens->private->uris;
+			break;
+
+		case 'w':
+			list = tokens->private->basenames_woext;
+			break;
+
+		case 'x':
+			list = tokens->private->exts;
+			break;
+	}
+
+	return( list );
+}
+
+static void
+exec_template_free_words( ExecTemplate *template )
+{
+	GSList *iw, *ip;
+
+	for( iw = template->words ; iw ; iw = iw->next ){
+		for( ip = ( GSList * ) iw->data ; ip ; ip = ip->next ){
+			g_free((( ExecPiece * ) ip->data )->text );
+			g_free( ip->data );
+		}
+		g_slist_free(( GSList * ) iw->data );
+	}
+
+	g_slist_free( template->words );
+	template->words = NULL;
+}
+
+static void
+exec_template_unref( ExecTemplate *template )
+{
+	template->ref_count -= 1;
+
+	if( !template->ref_count ){
+		exec_template_free_words( template );
+		g_free( template->exec );
+		g_free( template );
+	}
+}
+
+/*
+ * returns a new #NATokens object which only holds @count items of the
+ * selection, starting with the @first one
+ */
+static NATokens *
+tokens_new_slice( const NATokens *tokens, guint first, guint count )
+{
+	NATokens *slice;
+
+	slice = g_object_new( NA_TYPE_TOKENS, NULL );
+	slice->private->count = count;
+
+	slice->private->uris = slist_slice( tokens->private->uris, first, count );
+	slice->private->filenames = slist_slice( tokens->private->filenames, first, count );
+	slice->private->basedirs = slist_slice( tokens->private->basedirs, first, count );
+	slice->private->basenames = slist_slice( tokens->private->basenames, first, count );
+	slice->private->basenames_woext = slist_slice( tokens->private->basenames_woext, first, count );
+	slice->private->exts = slist_slice( tokens->private->exts, first, count );
+	slice->private->mimetypes = slist_slice( tokens->private->mimetypes, first, count );
+
+	slice->private->hostname = g_strdup( tokens->private->hostname );
+	slice->private->username = g_strdup( tokens->private->username );
+	slice->private->port = tokens->private->port;
+	slice->private->scheme = g_strdup( tokens->private->scheme );
+
+	return( slice );
+}
+
+static GSList *
+slist_slice( GSList *list, guint first, guint count )
+{
+	GSList *slice, *it;
+	guint i;
+
+	slice = NULL;
+
+	for( it = g_slist_nth( list, first ), i = 0 ; it && i < count ; it = it->next, ++i ){
+		slice = g_slist_prepend( slice, g_strdup(( const gchar * ) it->data ));
+	}
+
+	return( g_slist_reverse( slice ));
+}
+
+static void
+child_watch_fn( GPid pid, gint status, ChildStr *child_str )
+{
+	static const gchar *thisfn = "na_tokens_child_watch_fn";
+
+	g_debug( "%s: pid=%u, status=%d", thisfn, ( guint ) pid, status );
+	g_spawn_close_pid( pid );
+
+	/* let the waiting commands be run before displaying the output
+	 * of this one in a modal dialog
+	 */
+	(( Activation * ) child_str->activation )->running -= 1;
+	activation_unref(( Activation * ) child_str->activation );
+	st_scheduler.running -= 1;
+	st_scheduler.done += child_str->files;
+	scheduler_run();
+
+	if( child_str->display ){
+		child_str->display->exited = TRUE;
+		display_output_check_end( child_str->display );
+	}
+	g_free( child_str->command );
+	g_free( child_str );
+}
+
+/*
+ * the output of the child is read as it arrives, so that the child
+ * never blocks on a full pipe, and is displayed in a non-modal dialog
+ * which is opened when the first bytes are received (or when the child
+ * terminates without having written anything)
+ */
+static DisplayOutput *
+display_output_new( const gchar *command, gint fd_stdout, gint fd_stderr )
+{
+	DisplayOutput *display;
+	GtkTextIter iter;
+	gint out_offset, err_offset;
+
+	display = g_new0( DisplayOutput, 1 );
+	display->command = g_strdup( command );
+	display->buffer = gtk_text_buffer_new( NULL );
+	gtk_text_buffer_create_tag( display->buffer, "bold", "weight", PANGO_WEIGHT_BOLD, NULL );
+
+	gtk_text_buffer_get_end_iter( display->buffer, &iter );
+	gtk_text_buffer_insert_with_tags_by_name( display->buffer, &iter, _( "Run command:" ), -1, "bold", NULL );
+	gtk_text_buffer_insert( display->buffer, &iter, "\n", -1 );
+	gtk_text_buffer_insert( display->buffer, &iter, command, -1 );
+	gtk_text_buffer_insert( display->buffer, &iter, "\n\n", -1 );
+	gtk_text_buffer_insert_with_tags_by_name( display->buffer, &iter, _( "Standard output:" ), -1, "bold", NULL );
+	gtk_text_buffer_insert( display->buffer, &iter, "\n", -1 );
+	out_offset = gtk_text_iter_get_offset( &iter );
+	gtk_text_buffer_insert( display->buffer, &iter, "\n\n", -1 );
+	gtk_text_buffer_insert_with_tags_by_name( display->buffer, &iter, _( "Standard error:" ), -1, "bold", NULL );
+	gtk_text_buffer_insert( display->buffer, &iter, "\n", -1 );
+	err_offset = gtk_text_iter_get_offset( &iter );
+
+	display_output_stream_init( display, &display->out, fd_stdout, out_offset );
+	display_output_stream_init( display, &display->err, fd_stderr, err_offset );
+
+	return( display );
+}
+
+/*
+ * the text received on the stream is inserted at its mark, which has a
+ * right gravity so that it stays after the inserted text
+ */
+static void
+display_output_stream_init( DisplayOutput *display, OutputStream *stream, gint fd, gint offset )
+{
+	GtkTextIter iter;
+
+	stream->display = display;
+	stream->pending = g_string_new( "" );
+
+	gtk_text_buffer_get_iter_at_offset( display->buffer, &iter, offset );
+	stream->mark = gtk_text_buffer_create_mark( display->buffer, NULL, &iter, FALSE );
+
+	if( fd > 0 ){
+		stream->channel = g_io_channel_unix_new( fd );
+		g_io_channel_set_close_on_unref( stream->channel, TRUE );
+		g_io_channel_set_encoding( stream->channel, NULL, NULL );
+		g_io_channel_set_flags( stream->channel, G_IO_FLAG_NONBLOCK, NULL );
+		stream->source_id = g_io_add_watch( stream->channel,
+				G_IO_IN | G_IO_PRI | G_IO_HUP | G_IO_ERR,
+				( GIOFunc ) display_output_on_readable, stream );
+	}
+}
+
+/*
+ * read what is available, up to OUTPUT_READ_MAX bytes, so that a very
+ * chatty child does not freeze the user interface
+ */
+static gboolean
+display_output_on_readable( GIOChannel *channel, GIOCondition condition, OutputStream *stream )
+{
+	static const gchar *thisfn = "na_tokens_display_output_on_readable";
+	gchar buf[4096];
+	gsize count, total;
+	GIOStatus status;
+	GError *error;
+
+	total = 0;
+	error = NULL;
+
+	do {
+		status = g_io_channel_read_chars( channel, buf, sizeof( buf ), &count, &error );
+		if( count ){
+			display_output_stream_append( stream, buf, count );
+			total += count;
+		}
+	} while( status == G_IO_STATUS_NORMAL && total < OUTPUT_READ_MAX );
+
+	if( status == G_IO_STATUS_NORMAL || status == G_IO_STATUS_AGAIN ){
+		return( TRUE );
+	}
+
+	if( error ){
+		g_warning( "%s: g_io_channel_read_chars: %s", thisfn, error->message );
+		g_error_free( error );
+	}
+
+	/* end of file or error: flush the remaining bytes
+	 */
+	display_output_stream_convert( stream, TRUE );
+	g_io_channel_unref( stream->channel );
+	stream->channel = NULL;
+	stream->source_id = 0;
+	display_output_check_end( stream->display );
+
+	return( FALSE );
+}
+
+/*
+ * only the first OUTPUT_MAX_LENGTH bytes are kept, the remaining ones
+ * being read and ignored
+ */
+static void
+display_output_stream_append( OutputStream *stream, const gchar *data, gsize count )
+{
+	GtkTextIter iter;
+	gsize kept;
+
+	if( stream->truncated ){
+		return;
+	}
+
+	kept = MIN( count, OUTPUT_MAX_LENGTH - stream->length );
+	g_string_append_len( stream->pending, data, kept );
+	stream->length += kept;
+	display_output_stream_convert( stream, kept < count );
+
+	if( kept < count ){
+		stream->truncated = TRUE;
+		gtk_text_buffer_get_iter_at_mark( stream->display->buffer, &iter, stream->mark );
+		gtk_text_buffer_insert_with_tags_by_name( stream->display->buffer, &iter,
+				_( "[... output truncated ...]" ), -1, "bold", NULL );
+	}
+}
+
+/*
+ * convert the pending bytes to UTF-8, keeping a partial character at
+ * the end of the input until the next bytes arrive, unless @flush is
+ * set; illegal sequences are replaced with the Unicode replacement
+ * character
+ */
+static void
+display_output_stream_convert( OutputStream *stream, gboolean flush )
+{
+	gchar *text;
+	gsize converted, remaining, bytes_read;
+	GError *error;
+
+	converted = 0;
+
+	while( converted < stream->pending->len ){
+		remaining = stream->pending->len - converted;
+		bytes_read = 0;
+		error = NULL;
+		text = g_locale_to_utf8( stream->pending->str + converted, remaining, &bytes_read, NULL, &error );
+
+		/* an illegal sequence: convert the valid bytes before it */
+		if( !text && bytes_read ){
+			text = g_locale_to_utf8( stream->pending->str + converted, bytes_read, NULL, NULL, NULL );
+		}
+		if( text ){
+			display_output_stream_insert( stream, text );
+			g_free( text );
+		}
+		if( error ){
+			g_error_free( error );
+		}
+		converted += bytes_read;
+
+		if( converted < stream->pending->len ){
+			if( !flush && stream->pending->len - converted < OUTPUT_CHAR_MAX ){
+				break;
+			}
+			display_output_stream_insert( stream, "\xef\xbf\xbd" );
+			converted += 1;
+		}
+	}
+
+	g_string_erase( stream->pending, 0, converted );
+}
+
+static void
+display_output_stream_insert( OutputStream *stream, const gchar *text )
+{
+	GtkTextIter iter;
+
+	if( text && strlen( text )){
+		gtk_text_buffer_get_iter_at_mark( stream->display->buffer, &iter, stream->mark );
+		gtk_text_buffer_insert( stream->display->buffer, &iter, text, -1 );
+		display_output_show( stream->display );
+
+		if( stream->display->view ){
+			gtk_text_view_scroll_mark_onscreen( GTK_TEXT_VIEW( stream->display->view ), stream->mark );
+		}
+	}
+}
+
+/*
+ * open the dialog, unless it has already been opened
+ */
+static void
+display_output_show( DisplayOutput *display )
+{
+	GtkWidget *content, *label, *scrolled;
+	gchar *markup;
+
+	if( display->shown ){
+		return;
+	}
+
+	display->shown = TRUE;
+	display->dialog = gtk_dialog_new_with_buttons(
+			PACKAGE_NAME, NULL, 0, GTK_STOCK_CLOSE, GTK_RESPONSE_CLOSE, NULL );
+	gtk_window_set_default_size( GTK_WINDOW( display->dialog ), 600, 400 );
+
+	content = gtk_dialog_get_content_area( GTK_DIALOG( display->dialog ));
+
+	label = gtk_label_new( NULL );
+	markup = g_markup_printf_escaped( "<b>%s</b>", _( "Output of the run command" ));
+	gtk_label_set_markup( GTK_LABEL( label ), markup );
+	g_free( markup );
+	gtk_box_pack_start( GTK_BOX( content ), label, FALSE, FALSE, 4 );
+
+	scrolled = gtk_scrolled_window_new( NULL, NULL );
+	gtk_scrolled_window_set_policy( GTK_SCROLLED_WINDOW( scrolled ), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC );
+	gtk_box_pack_start( GTK_BOX( content ), scrolled, TRUE, TRUE, 0 );
+
+	display->view = gtk_text_view_new_with_buffer( display->buffer );
+	gtk_text_view_set_editable( GTK_TEXT_VIEW( display->view ), FALSE );
+	gtk_text_view_set_wrap_mode( GTK_TEXT_VIEW( display->view ), GTK_WRAP_WORD_CHAR );
+	gtk_container_add( GTK_CONTAINER( scrolled ), display->view );
+
+	g_signal_connect( display->dialog, "response", G_CALLBACK( gtk_widget_destroy ), NULL );
+	g_signal_connect( display->dialog, "destroy", G_CALLBACK( display_output_on_destroy ), display );
+
+	gtk_widget_show_all( display->dialog );
+}
+
+/*
+ * the dialog may be closed by the user while the child is still running
+ */
+static void
+display_output_on_destroy( GtkWidget *dialog, DisplayOutput *display )
+{
+	display->dialog = NULL;
+	display->view = NULL;
+}
+
+/*
+ * the display is released when the child has terminated and both its
+ * output streams have been read until their end; the dialog keeps its
+ * own reference on the text buffer
+ */
+static void
+display_output_check_end( DisplayOutput *display )
+{
+	if( display->exited && !display->out.channel && !display->err.channel ){
+
+		display_output_show( display );
+
+		if( display->dialog ){
+			g_signal_handlers_disconnect_by_func( display->dialog, display_output_on_destroy, display );
+		}
+
+		g_string_free( display->out.pending, TRUE );
+		g_string_free( display->err.pending, TRUE );
+		g_object_unref( display->buffer );
+		g_free( display->command );
+		g_free( display );
+	}
+}
+
+/*
+ * spawns the command, whose argument vector has been built according to
+ * the execution mode; @command is the command-line as displayed to the
+ * user
+ *
+ * Returns: %TRUE if the child has been spawned, and is so watched.
+ */
+static gboolean
+execute_action_command( gchar **argv, const gchar *command, Activation *activation, guint files )
+{
+	static const gchar *thisfn = "nautilus_actions_execute_action_command";
+	GError *error;
+	GPid child_pid;
+	ChildStr *child_str;
+
+	error = NULL;
+	child_str = g_new0( ChildStr, 1 );
+	child_str->files = files;
+	child_str->is_output_displayed = !strcmp( activation->execution_mode, "DisplayOutput" );
+	child_str->command = command ? g_strdup( command ) : g_strjoinv( " ", argv );
+	child_pid = ( GPid ) 0;
+
+	g_debug( "%s: execution_mode=%s, files=%u, command=%s, wdir=%s",
+			thisfn, activation->execution_mode, files, child_str->command, activation->wdir );
+
+	/* it appears that at least mplayer does not support g_spawn_async_with_pipes
+	 * (at least when not run in '-quiet' mode) while, e.g., totem and vlc rightly
+	 * support this function
+	 * So only use g_spawn_async_with_pipes when we really need to get back
+	 * the content of output and error streams
+	 * See https://bugzilla.gnome.org/show_bug.cgi?id=644289.
+	 */
+	if( child_str->is_output_displayed ){
+		g_spawn_async_with_pipes(
+				activation->wdir,
+				argv,
+				NULL,
+				G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD,
+				NULL,
+				NULL,
+				&child_pid,
+				NULL,
+				&child_str->child_stdout,
+				&child_str->child_stderr,
+				&error );
+
+	} else {
+		g_spawn_async(
+				activation->wdir,
+				argv,
+				NULL,
+				G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD,
+				NULL,
+				NULL,
+				&child_pid,
+				&error );
+	}
+
+	if( error ){
+		g_warning( "%s: g_spawn_async: %s", thisfn, error->message );
+		g_error_free( error );
+		child_pid = ( GPid ) 0;
+
+	} else {
+		if( child_str->is_output_displayed ){
+			child_str->display = display_output_new( child_str->command, child_str->child_stdout, child_str->child_stderr );
+		}
+		activation->ref_count += 1;
+		child_str->activation = activation;
+		g_child_watch_add( child_pid, ( GChildWatchFunc ) child_watch_fn, child_str );
+	}
+
+	if( child_pid == ( GPid ) 0 ){
+		g_free( child_str->command );
+		g_free( child_str );
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * Execution environment:
+ * - Normal: just execute the specified command
+ * - Terminal: use the user preference to have a terminal which stays openeded
+ * - Embedded: id. Terminal
+ * - DisplayOutput: execute in a shell
+ *
+ * Returns: the command-line to be run, as a newly allocated string which
+ * should be g_free() by the caller, or %NULL.
+ */
+static gchar *
+get_command_execution( const gchar *command, const gchar *execution_mode )
+{
+	static const gchar *thisfn = "na_tokens_get_command_execution";
+	gchar *run_command;
+
+	run_command = NULL;
+
+	if( !strcmp( execution_mode, "Normal" )){
+		run_command = get_command_execution_normal( command );
+
+	} else if( !strcmp( execution_mode, "Terminal" )){
+		run_command = get_command_execution_terminal( command );
+
+	} else if( !strcmp( execution_mode, "Embedded" )){
+		run_command = get_command_execution_embedded( command );
+
+	} else if( !strcmp( execution_mode, "DisplayOutput" )){
+		run_command = get_command_execution_display_output( command );
+
+	} else {
+		g_warning( "%s: unknown execution mode: %s", thisfn, execution_mode );
+	}
+
+	return( run_command );
+}
+
+static gchar *
+get_command_execution_display_output( const gchar *command )
+{
+	static const gchar *bin_sh = "/bin/sh -c COMMAND";
+	return( na_tokens_command_for_terminal( bin_sh, command ));
+}
+
+static gchar *
+get_command_execution_embedded( const gchar *command )
+{
+	return( get_command_execution_terminal( command ));
+}
+
+static gchar *
+get_command_execution_normal( const gchar *command )
+{
+	return( g_strdup( command ));
+}
+
+/*
+ * the terminal pattern is only read again from the settings after it
+ * has been modified
+ */
+static gchar *
+get_command_execution_terminal( const gchar *command )
+{
+	if( !st_terminal_read ){
+		if( !st_terminal_watched ){
+			na_settings_register_key_callback(
+					NA_IPREFS_TERMINAL_PATTERN,
+					G_CALLBACK( on_terminal_pattern_changed ),
+					NULL );
+			st_terminal_watched = TRUE;
+		}
+
+		g_free( st_terminal_pattern );
+		st_terminal_pattern = na_settings_get_string( NA_IPREFS_TERMINAL_PATTERN, NULL, NULL );
+		st_terminal_read = TRUE;
+	}
+
+	return( na_tokens_command_for_terminal( st_terminal_pattern, command ));
+}
+
+static void
+on_terminal_pattern_changed( const gchar *group, const gchar *key, gconstpointer new_value, gboolean mandatory, void *user_data )
+{
+	st_terminal_read = FALSE;
 }
 
 /**
@@ -655,14 +1795,13 @@ na_tokens_command_for_terminal( const gchar *pattern, const gchar *command )
 
 /*
  * na_tokens_is_singular_exec:
- * @tokens: the current #NATokens object.
  * @exec: the to be executed command-line before having been parsed
  *
  * Returns: %TRUE if the first relevant parameter found in @exec
  * command-line is of singular form, %FALSE else.
  */
 static gboolean
-is_singular_exec( const NATokens *tokens, const gchar *exec )
+is_singular_exec( const gchar *exec )
 {
 	gboolean singular;
 	gboolean found;
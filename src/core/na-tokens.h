@@ -108,15 +108,16 @@ typedef struct {
 }
 	NATokensClass;
 
-GType     na_tokens_get_type            ( void );
+GType     na_tokens_get_type              ( void );
 
-NATokens *na_tokens_new_for_example     ( void );
-NATokens *na_tokens_new_from_selection  ( GList *selection );
+NATokens *na_tokens_new_for_example       ( void );
+NATokens *na_tokens_new_from_selection    ( GList *selection );
 
-gchar    *na_tokens_parse_for_display   ( const NATokens *tokens, const gchar *string, gboolean utf8 );
-void      na_tokens_execute_action      ( const NATokens *tokens, const NAObjectProfile *profile );
+gchar    *na_tokens_parse_for_display     ( const NATokens *tokens, const gchar *string, gboolean utf8 );
+void      na_tokens_execute_action        ( const NATokens *tokens, const NAObjectProfile *profile );
+gboolean  na_tokens_get_execution_progress( guint *done, guint *total );
 
-gchar    *na_tokens_command_for_terminal( const gchar *pattern, const gchar *command );
+gchar    *na_tokens_command_for_terminal  ( const gchar *pattern, const gchar *command );
 
 G_END_DECLS
 
@@ -63,6 +63,8 @@ static void     instance_finalize( GObject *object );
 
 static gboolean are_preferences_locked( const NAUpdater *updater );
 static gboolean is_level_zero_writable( const NAUpdater *updater );
+static void     check_items_writability( const NAUpdater *updater, GList *tree );
+static GList   *check_items_writability_rec( GList *flat, GList *tree );
 static void     set_writability_status( NAObjectItem *item, const NAUpdater *updater );
 
 GType
@@ -266,8 +268,10 @@ na_updater_check_item_writability_status( const NAUpdater *updater, const NAObje
 		writable = TRUE;
 		reason = NA_IIO_PROVIDER_STATUS_WRITABLE;
 
-		/* Writability status of the item has been determined at load time
-		 * (cf. e.g. io-desktop/nadp-reader.c:read_done_item_is_writable()).
+		/* Read-only status of the item has been determined at load time,
+		 * either by the i/o provider itself while reading the item, or in
+		 * one batch when the updater loads the tree
+		 * (cf. e.g. io-desktop/nadp-writer.c:nadp_iio_provider_check_items_writability()).
 		 * Though I'm plenty conscious that this status is subject to many
 		 * changes during the life of the item (e.g. by modifying permissions
 		 * on the underlying store), it is just more efficient to not reevaluate
@@ -523,12 +527,59 @@ na_updater_load_items( NAUpdater *updater )
 
 		na_pivot_load_items( NA_PIVOT( updater ));
 		tree = na_pivot_get_items( NA_PIVOT( updater ));
+		check_items_writability( updater, tree );
 		g_list_foreach( tree, ( GFunc ) set_writability_status, ( gpointer ) updater );
 	}
 
 	return( tree );
 }
 
+/*
+ * only the updater cares about the read-only status of the items:
+ * have each i/o provider check it in one pass for all its items
+ */
+static void
+check_items_writability( const NAUpdater *updater, GList *tree )
+{
+	GList *flat, *it, *items;
+	const GList *ip;
+	NAIOProvider *provider;
+
+	flat = g_list_reverse( check_items_writability_rec( NULL, tree ));
+
+	for( ip = na_io_provider_get_io_providers_list( NA_PIVOT( updater )) ; ip ; ip = ip->next ){
+		provider = NA_IO_PROVIDER( ip->data );
+		items = NULL;
+		for( it = flat ; it ; it = it->next ){
+			if( na_object_get_provider( it->data ) == provider ){
+				items = g_list_prepend( items, it->data );
+			}
+		}
+		if( items ){
+			items = g_list_reverse( items );
+			na_io_provider_check_items_writability( provider, items );
+			g_list_free( items );
+		}
+	}
+
+	g_list_free( flat );
+}
+
+static GList *
+check_items_writability_rec( GList *flat, GList *tree )
+{
+	GList *it;
+
+	for( it = tree ; it ; it = it->next ){
+		flat = g_list_prepend( flat, it->data );
+		if( NA_IS_OBJECT_MENU( it->data )){
+			flat = check_items_writability_rec( flat, na_object_get_items( it->data ));
+		}
+	}
+
+	return( flat );
+}
+
 static void
 set_writability_status( NAObjectItem *item, const NAUpdater *updater )
 {
@@ -622,3 +673,65 @@ na_updater_delete_item( const NAUpdater *updater, const NAObjectItem *item, GSLi
 
 	return( ret );
 }
+
+/*
+ * na_updater_write_batch_begin:
+ * @updater: this #NAUpdater instance.
+ *
+ * Lets the I/O providers know that several items are going to be
+ * written, so that they are able to commit them all at once in
+ * na_updater_write_batch_end().
+ */
+void
+na_updater_write_batch_begin( const NAUpdater *updater )
+{
+	const GList *ip;
+
+	g_return_if_fail( NA_IS_UPDATER( updater ));
+
+	if( !updater->private->dispose_has_run ){
+
+		for( ip = na_io_provider_get_io_providers_list( NA_PIVOT( updater )) ; ip ; ip = ip->next ){
+			na_io_provider_write_batch_begin( NA_IO_PROVIDER( ip->data ));
+		}
+	}
+}
+
+/*
+ * na_updater_write_batch_end:
+ * @updater: this #NAUpdater instance.
+ * @failed: set to the list of the items which had been successfully
+ * written, but have not been committed; this list should be
+ * na_object_free_items() by the caller.
+ * @messages: the I/O providers can allocate and store here their error
+ * messages.
+ *
+ * Have the I/O providers commit the items written since
+ * na_updater_write_batch_begin().
+ *
+ * Returns: NA_IIO_PROVIDER_CODE_OK if all the I/O providers have
+ * successfully committed their items, or the first error code.
+ */
+guint
+na_updater_write_batch_end( const NAUpdater *updater, GList **failed, GSList **messages )
+{
+	guint ret, code;
+	const GList *ip;
+
+	g_return_val_if_fail( NA_IS_UPDATER( updater ), NA_IIO_PROVIDER_CODE_PROGRAM_ERROR );
+
+	ret = NA_IIO_PROVIDER_CODE_OK;
+	*failed = NULL;
+
+	if( !updater->private->dispose_has_run ){
+
+		for( ip = na_io_provider_get_io_providers_list( NA_PIVOT( updater )) ; ip ; ip = ip->next ){
+			code = na_io_provider_write_batch_end( NA_IO_PROVIDER( ip->data ), failed, messages );
+			if( ret == NA_IIO_PROVIDER_CODE_OK ){
+				ret = code;
+			}
+		}
+	}
+
+	return( ret );
+}
@@ -92,6 +92,9 @@ GList     *na_updater_load_items ( NAUpdater *updater );
 guint      na_updater_write_item ( const NAUpdater *updater, NAObjectItem *item, GSList **messages );
 guint      na_updater_delete_item( const NAUpdater *updater, const NAObjectItem *item, GSList **messages );
 
+void       na_updater_write_batch_begin( const NAUpdater *updater );
+guint      na_updater_write_batch_end  ( const NAUpdater *updater, GList **failed, GSList **messages );
+
 G_END_DECLS
 
 #endif /* __CORE_NA_UPDATER_H__ */
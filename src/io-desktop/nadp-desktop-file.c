@@ -31,9 +31,13 @@
 #include <config.h>
 #endif
 
+#include <errno.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <gio/gio.h>
+#include <glib/gstdio.h>
 
 #include <api/na-core-utils.h>
 
@@ -69,6 +73,7 @@ static gchar           *path2id( const gchar *path );
 static gchar           *uri2id( const gchar *uri );
 static gboolean         check_key_file( NadpDesktopFile *ndf );
 static void             remove_encoding_part( NadpDesktopFile *ndf );
+static gboolean         write_fd( int fd, const gchar *data, gsize length );
 
 GType
 nadp_desktop_file_get_type( void )
@@ -273,7 +278,6 @@ nadp_desktop_file_new_from_uri( const gchar *uri )
 {
 	static const gchar *thisfn = "nadp_desktop_file_new_from_uri";
 	NadpDesktopFile *ndf;
-	GError *error;
 	gchar *data;
 	gsize length;
 
@@ -293,10 +297,39 @@ nadp_desktop_file_new_from_uri( const gchar *uri )
 		return( NULL );
 	}
 
+	ndf = nadp_desktop_file_new_from_data( uri, data, length );
+	g_free( data );
+
+	return( ndf );
+}
+
+/**
+ * nadp_desktop_file_new_from_data:
+ * @uri: the URI the desktop file has been loaded from.
+ * @data: the content of the file.
+ * @length: the length of @data.
+ *
+ * Retuns: a newly allocated #NadpDesktopFile object, or %NULL.
+ *
+ * This is used when the caller has already read the file, e.g. when
+ * importing it.
+ */
+NadpDesktopFile *
+nadp_desktop_file_new_from_data( const gchar *uri, const gchar *data, gsize length )
+{
+	static const gchar *thisfn = "nadp_desktop_file_new_from_data";
+	NadpDesktopFile *ndf;
+	GError *error;
+
+	g_return_val_if_fail( uri && g_utf8_strlen( uri, -1 ), NULL );
+
+	if( !length || !data ){
+		return( NULL );
+	}
+
 	error = NULL;
 	ndf = ndf_new( uri );
 	g_key_file_load_from_data( ndf->private->key_file, data, length, G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS, &error );
-	g_free( data );
 
 	if( error ){
 		if( error->code != G_KEY_FILE_ERROR_GROUP_NOT_FOUND ){
@@ -1216,6 +1249,113 @@ nadp_desktop_file_write( NadpDesktopFile *ndf )
 	return( FALSE );
 }
 
+/**
+ * nadp_desktop_file_write_to_temp:
+ * @ndf: the #NadpDesktopFile instance.
+ *
+ * Writes the key file to a new temporary file, in the same directory
+ * than the target one, so that it may be later atomically renamed over
+ * it. The data are flushed to the disk before returning.
+ *
+ * Returns: the path of the temporary file, as a newly allocated string
+ * which should be g_free() by the caller, or %NULL if an error has
+ * occurred.
+ */
+gchar *
+nadp_desktop_file_write_to_temp( NadpDesktopFile *ndf )
+{
+	static const gchar *thisfn = "nadp_desktop_file_write_to_temp";
+	gchar *path, *dir, *bname, *tmp_path;
+	gchar *data;
+	gsize length;
+	struct stat st;
+	int fd;
+	gboolean ok;
+
+	g_return_val_if_fail( NADP_IS_DESKTOP_FILE( ndf ), NULL );
+
+	if( ndf->private->dispose_has_run ){
+		return( NULL );
+	}
+
+	path = g_filename_from_uri( ndf->private->uri, NULL, NULL );
+	if( !path ){
+		g_warning( "%s: %s: not a local file", thisfn, ndf->private->uri );
+		return( NULL );
+	}
+
+	dir = g_path_get_dirname( path );
+	bname = g_path_get_basename( path );
+	tmp_path = g_strdup_printf( "%s/.%s.XXXXXX", dir, bname );
+	g_free( bname );
+	g_free( dir );
+
+	fd = g_mkstemp( tmp_path );
+	if( fd == -1 ){
+		g_warning( "%s: %s: %s", thisfn, tmp_path, g_strerror( errno ));
+		g_free( tmp_path );
+		g_free( path );
+		return( NULL );
+	}
+
+	/* keep the permissions of the file we are going to replace
+	 */
+	if( fchmod( fd, g_stat( path, &st ) == 0 ? st.st_mode & 07777 : 0644 ) == -1 ){
+		g_debug( "%s: fchmod: %s", thisfn, g_strerror( errno ));
+	}
+	g_free( path );
+
+	if( ndf->private->key_file ){
+		remove_encoding_part( ndf );
+	}
+
+	data = g_key_file_to_data( ndf->private->key_file, &length, NULL );
+	ok = write_fd( fd, data, length );
+	g_free( data );
+
+	if( ok && fsync( fd ) == -1 ){
+		g_warning( "%s: fsync: %s", thisfn, g_strerror( errno ));
+		ok = FALSE;
+	}
+
+	if( close( fd ) == -1 ){
+		g_warning( "%s: close: %s", thisfn, g_strerror( errno ));
+		ok = FALSE;
+	}
+
+	if( !ok ){
+		g_unlink( tmp_path );
+		g_free( tmp_path );
+		tmp_path = NULL;
+	}
+
+	g_debug( "%s: uri=%s, tmp_path=%s", thisfn, ndf->private->uri, tmp_path );
+
+	return( tmp_path );
+}
+
+static gboolean
+write_fd( int fd, const gchar *data, gsize length )
+{
+	static const gchar *thisfn = "nadp_desktop_file_write_fd";
+	gssize written;
+
+	while( length > 0 ){
+		written = write( fd, data, length );
+		if( written == -1 ){
+			if( errno == EINTR ){
+				continue;
+			}
+			g_warning( "%s: write: %s", thisfn, g_strerror( errno ));
+			return( FALSE );
+		}
+		data += written;
+		length -= written;
+	}
+
+	return( TRUE );
+}
+
 static void
 remove_encoding_part( NadpDesktopFile *ndf )
 {
@@ -78,11 +78,13 @@ GType            nadp_desktop_file_get_type         ( void );
 NadpDesktopFile *nadp_desktop_file_new              ( void );
 NadpDesktopFile *nadp_desktop_file_new_from_path    ( const gchar *path );
 NadpDesktopFile *nadp_desktop_file_new_from_uri     ( const gchar *uri );
+NadpDesktopFile *nadp_desktop_file_new_from_data    ( const gchar *uri, const gchar *data, gsize length );
 NadpDesktopFile *nadp_desktop_file_new_for_write    ( const gchar *path );
 
 GKeyFile        *nadp_desktop_file_get_key_file     ( const NadpDesktopFile *ndf );
 gchar           *nadp_desktop_file_get_key_file_uri ( const NadpDesktopFile *ndf );
 gboolean         nadp_desktop_file_write            ( NadpDesktopFile *ndf );
+gchar           *nadp_desktop_file_write_to_temp    ( NadpDesktopFile *ndf );
 
 gchar           *nadp_desktop_file_get_file_type    ( const NadpDesktopFile *ndf );
 gchar           *nadp_desktop_file_get_id           ( const NadpDesktopFile *ndf );
@@ -31,8 +31,13 @@
 #include <config.h>
 #endif
 
-#include <glib/gi18n.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <string.h>
+#include <unistd.h>
+
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
 
 #include <api/na-core-utils.h>
 #include <api/na-ifactory-provider.h>
@@ -53,6 +58,16 @@ struct _NadpDesktopProviderClassPrivate {
 static GType         st_module_type = 0;
 static GObjectClass *st_parent_class = NULL;
 static guint         st_burst_timeout = 100;		/* burst timeout in msec */
+static guint         st_self_delay    = 2;			/* in sec. */
+
+/* a file written in a batch, waiting for being renamed
+ */
+typedef struct {
+	gchar        *tmp_path;
+	gchar        *path;
+	NAObjectItem *item;
+}
+	StagedFile;
 
 static void   class_init( NadpDesktopProviderClass *klass );
 static void   instance_init( GTypeInstance *instance, gpointer klass );
@@ -77,6 +92,9 @@ static void  *iexporter_get_formats( const NAIExporter *exporter );
 static void   iexporter_free_formats( const NAIExporter *exporter, GList *format_list );
 
 static void   on_monitor_timeout( NadpDesktopProvider *provider );
+static gboolean batch_commit( NadpDesktopProvider *provider, GList **failed );
+static gboolean is_self_written( NadpDesktopProvider *provider, const gchar *path );
+static gboolean is_self_written_expired( const gchar *path, gint64 *deadline, gint64 *now );
 
 GType
 nadp_desktop_provider_get_type( void )
@@ -175,7 +193,9 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->timeout.timeout = st_burst_timeout;
 	self->private->timeout.handler = ( NATimeoutFunc ) on_monitor_timeout;
 	self->private->timeout.user_data = self;
-	self->private->timeout.source_id = 0;
+	self->private->batch_level = 0;
+	self->private->staged = NULL;
+	self->private->self_written = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, g_free );
 }
 
 static void
@@ -192,8 +212,16 @@ instance_dispose( GObject *object )
 
 		g_debug( "%s: object=%p (%s)", thisfn, ( void * ) object, G_OBJECT_TYPE_NAME( object ));
 
+		/* do not lose the files which have been written in an unclosed batch
+		 */
+		if( self->private->staged ){
+			g_warning( "%s: committing %d pending file(s)", thisfn, g_list_length( self->private->staged ));
+			batch_commit( self, NULL );
+		}
+
 		self->private->dispose_has_run = TRUE;
 
+		na_timeout_remove( &self->private->timeout );
 		nadp_desktop_provider_release_monitors( self );
 
 		/* chain up to the parent class */
@@ -215,6 +243,8 @@ instance_finalize( GObject *object )
 
 	self = NADP_DESKTOP_PROVIDER( object );
 
+	g_hash_table_destroy( self->private->self_written );
+
 	g_free( self->private );
 
 	/* chain call to parent class */
@@ -239,6 +269,9 @@ iio_provider_iface_init( NAIIOProviderInterface *iface )
 	iface->write_item = nadp_iio_provider_write_item;
 	iface->delete_item = nadp_iio_provider_delete_item;
 	iface->duplicate_data = nadp_iio_provider_duplicate_data;
+	iface->check_items_writability = nadp_iio_provider_check_items_writability;
+	iface->write_batch_begin = nadp_iio_provider_write_batch_begin;
+	iface->write_batch_end = nadp_iio_provider_write_batch_end;
 }
 
 static guint
@@ -361,17 +394,30 @@ nadp_desktop_provider_add_monitor( NadpDesktopProvider *provider, const gchar *d
 /**
  * nadp_desktop_provider_on_monitor_event:
  * @provider: this #NadpDesktopProvider object.
+ * @file: the #GFile the event is about.
  *
  * Factorize events received from GIO when monitoring desktop directories.
+ *
+ * Events about the files we have ourselves just written or deleted are
+ * ignored.
  */
 void
-nadp_desktop_provider_on_monitor_event( NadpDesktopProvider *provider )
+nadp_desktop_provider_on_monitor_event( NadpDesktopProvider *provider, GFile *file )
 {
+	gchar *path;
+	gboolean ignore;
+
 	g_return_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ));
 
 	if( !provider->private->dispose_has_run ){
 
-		na_timeout_event( &provider->private->timeout );
+		path = file ? g_file_get_path( file ) : NULL;
+		ignore = path && is_self_written( provider, path );
+		g_free( path );
+
+		if( !ignore ){
+			na_timeout_event( &provider->private->timeout );
+		}
 	}
 }
 
@@ -394,6 +440,241 @@ nadp_desktop_provider_release_monitors( NadpDesktopProvider *provider )
 	}
 }
 
+/**
+ * nadp_desktop_provider_batch_begin:
+ * @provider: this #NadpDesktopProvider object.
+ *
+ * Starts a new batch of writes: up to the corresponding
+ * nadp_desktop_provider_batch_end(), the .desktop files are written to
+ * temporary files, and only renamed when the batch is ended.
+ *
+ * Batches may be nested, the files being renamed when the outermost
+ * one is ended.
+ */
+void
+nadp_desktop_provider_batch_begin( NadpDesktopProvider *provider )
+{
+	g_return_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ));
+
+	if( !provider->private->dispose_has_run ){
+
+		provider->private->batch_level += 1;
+	}
+}
+
+/**
+ * nadp_desktop_provider_batch_write:
+ * @provider: this #NadpDesktopProvider object.
+ * @ndf: the #NadpDesktopFile to be written.
+ * @item: the #NAObjectItem which is written to @ndf.
+ *
+ * Writes the @ndf to the disk, either staging it in a temporary file
+ * if a batch has been started, or immediately else.
+ *
+ * Returns: %TRUE if the file has been successfully written or staged,
+ * %FALSE else. A staged file may still fail to be committed when the
+ * batch is ended: the @item is then reported by
+ * nadp_desktop_provider_batch_end().
+ */
+gboolean
+nadp_desktop_provider_batch_write( NadpDesktopProvider *provider, NadpDesktopFile *ndf, const NAObjectItem *item )
+{
+	static const gchar *thisfn = "nadp_desktop_provider_batch_write";
+	gboolean written;
+	gchar *uri, *path, *tmp_path;
+	StagedFile *staged;
+
+	g_return_val_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ), FALSE );
+	g_return_val_if_fail( NADP_IS_DESKTOP_FILE( ndf ), FALSE );
+
+	written = FALSE;
+
+	if( !provider->private->dispose_has_run ){
+
+		uri = nadp_desktop_file_get_key_file_uri( ndf );
+		path = g_filename_from_uri( uri, NULL, NULL );
+		g_free( uri );
+
+		if( !path ){
+			written = nadp_desktop_file_write( ndf );
+
+		} else {
+			nadp_desktop_provider_set_self_written( provider, path );
+
+			if( !provider->private->batch_level ){
+				written = nadp_desktop_file_write( ndf );
+				g_free( path );
+
+			} else {
+				tmp_path = nadp_desktop_file_write_to_temp( ndf );
+
+				if( tmp_path ){
+					g_debug( "%s: staging %s", thisfn, path );
+					nadp_desktop_provider_set_self_written( provider, tmp_path );
+					staged = g_new0( StagedFile, 1 );
+					staged->tmp_path = tmp_path;
+					staged->path = path;
+					staged->item = g_object_ref(( gpointer ) item );
+					provider->private->staged = g_list_prepend( provider->private->staged, staged );
+					written = TRUE;
+
+				} else {
+					g_free( path );
+				}
+			}
+		}
+	}
+
+	return( written );
+}
+
+/**
+ * nadp_desktop_provider_batch_end:
+ * @provider: this #NadpDesktopProvider object.
+ * @failed: a pointer to a list to which are prepended, with a new
+ *  reference, the items whose staged file has not been renamed.
+ *
+ * Ends a batch of writes. When this is the outermost batch, the staged
+ * files are renamed to their target path, and each concerned directory
+ * is then flushed once to the disk.
+ *
+ * Returns: %TRUE if all the staged files have been successfully
+ * renamed, %FALSE else.
+ */
+gboolean
+nadp_desktop_provider_batch_end( NadpDesktopProvider *provider, GList **failed )
+{
+	gboolean ok;
+
+	g_return_val_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ), FALSE );
+
+	ok = TRUE;
+
+	if( !provider->private->dispose_has_run && provider->private->batch_level ){
+
+		provider->private->batch_level -= 1;
+
+		if( !provider->private->batch_level ){
+			ok = batch_commit( provider, failed );
+		}
+	}
+
+	return( ok );
+}
+
+/**
+ * nadp_desktop_provider_set_self_written:
+ * @provider: this #NadpDesktopProvider object.
+ * @path: the path of a file we are going to write or delete.
+ *
+ * Records that the monitor events about this file which will be received
+ * in the next few seconds have been generated by ourselves, and so should
+ * be ignored.
+ */
+void
+nadp_desktop_provider_set_self_written( NadpDesktopProvider *provider, const gchar *path )
+{
+	gint64 now;
+	gint64 *deadline;
+
+	g_return_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ));
+
+	if( !provider->private->dispose_has_run ){
+
+		now = na_core_utils_get_monotonic_time();
+		g_hash_table_foreach_remove( provider->private->self_written, ( GHRFunc ) is_self_written_expired, &now );
+
+		deadline = g_new0( gint64, 1 );
+		*deadline = now + st_self_delay * G_USEC_PER_SEC;
+		g_hash_table_insert( provider->private->self_written, g_strdup( path ), deadline );
+	}
+}
+
+/*
+ * rename the staged files, then fsync each of the concerned directories
+ *
+ * the items whose file has not been renamed are prepended to @failed,
+ * which may be %NULL
+ */
+static gboolean
+batch_commit( NadpDesktopProvider *provider, GList **failed )
+{
+	static const gchar *thisfn = "nadp_desktop_provider_batch_commit";
+	gboolean ok;
+	GList *it;
+	StagedFile *staged;
+	GSList *dirs, *id;
+	gchar *dir;
+	int fd;
+
+	ok = TRUE;
+	dirs = NULL;
+	provider->private->staged = g_list_reverse( provider->private->staged );
+
+	g_debug( "%s: provider=%p, count=%d",
+			thisfn, ( void * ) provider, g_list_length( provider->private->staged ));
+
+	for( it = provider->private->staged ; it ; it = it->next ){
+		staged = ( StagedFile * ) it->data;
+
+		if( g_rename( staged->tmp_path, staged->path ) == -1 ){
+			g_warning( "%s: %s: %s", thisfn, staged->path, g_strerror( errno ));
+			g_unlink( staged->tmp_path );
+			ok = FALSE;
+
+			if( failed ){
+				*failed = g_list_prepend( *failed, g_object_ref( staged->item ));
+			}
+
+		} else {
+			dir = g_path_get_dirname( staged->path );
+			if( g_slist_find_custom( dirs, dir, ( GCompareFunc ) strcmp )){
+				g_free( dir );
+			} else {
+				dirs = g_slist_prepend( dirs, dir );
+			}
+		}
+
+		g_object_unref( staged->item );
+		g_free( staged->tmp_path );
+		g_free( staged->path );
+		g_free( staged );
+	}
+
+	g_list_free( provider->private->staged );
+	provider->private->staged = NULL;
+
+	for( id = dirs ; id ; id = id->next ){
+		fd = g_open(( const gchar * ) id->data, O_RDONLY, 0 );
+		if( fd == -1 ){
+			g_debug( "%s: %s: %s", thisfn, ( const gchar * ) id->data, g_strerror( errno ));
+		} else {
+			fsync( fd );
+			close( fd );
+		}
+	}
+
+	na_core_utils_slist_free( dirs );
+
+	return( ok );
+}
+
+static gboolean
+is_self_written( NadpDesktopProvider *provider, const gchar *path )
+{
+	gint64 *deadline;
+
+	deadline = ( gint64 * ) g_hash_table_lookup( provider->private->self_written, path );
+
+	return( deadline && *deadline > na_core_utils_get_monotonic_time());
+}
+
+static gboolean
+is_self_written_expired( const gchar *path, gint64 *deadline, gint64 *now )
+{
+	return( *deadline <= *now );
+}
+
 static void
 on_monitor_timeout( NadpDesktopProvider *provider )
 {
@@ -40,6 +40,8 @@
  * should only be used through the NAIIOProvider interface.
  */
 
+#include <gio/gio.h>
+
 #include <api/na-object-item.h>
 #include <api/na-timeout.h>
 
@@ -58,9 +60,12 @@ G_BEGIN_DECLS
  */
 typedef struct _NadpDesktopProviderPrivate {
 	/*< private >*/
-	gboolean  dispose_has_run;
-	GList    *monitors;
-	NATimeout timeout;
+	gboolean    dispose_has_run;
+	GList      *monitors;
+	NATimeout   timeout;
+	guint       batch_level;
+	GList      *staged;
+	GHashTable *self_written;
 }
 	NadpDesktopProviderPrivate;
 
@@ -88,9 +93,14 @@ typedef struct {
 GType nadp_desktop_provider_get_type     ( void );
 void  nadp_desktop_provider_register_type( GTypeModule *module );
 
-void  nadp_desktop_provider_add_monitor     ( NadpDesktopProvider *provider, const gchar *dir );
-void  nadp_desktop_provider_on_monitor_event( NadpDesktopProvider *provider );
-void  nadp_desktop_provider_release_monitors( NadpDesktopProvider *provider );
+void     nadp_desktop_provider_add_monitor     ( NadpDesktopProvider *provider, const gchar *dir );
+void     nadp_desktop_provider_on_monitor_event( NadpDesktopProvider *provider, GFile *file );
+void     nadp_desktop_provider_release_monitors( NadpDesktopProvider *provider );
+
+void     nadp_desktop_provider_batch_begin     ( NadpDesktopProvider *provider );
+gboolean nadp_desktop_provider_batch_write     ( NadpDesktopProvider *provider, NadpDesktopFile *ndf, const NAObjectItem *item );
+gboolean nadp_desktop_provider_batch_end       ( NadpDesktopProvider *provider, GList **failed );
+void     nadp_desktop_provider_set_self_written( NadpDesktopProvider *provider, const gchar *path );
 
 G_END_DECLS
 
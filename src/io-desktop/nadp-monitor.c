@@ -246,5 +246,5 @@ nadp_monitor_new( const NadpDesktopProvider *provider, const gchar *path )
 static void
 on_monitor_changed( GFileMonitor *monitor, GFile *file, GFile *other_file, GFileMonitorEvent event_type, NadpMonitor *my_monitor )
 {
-	nadp_desktop_provider_on_monitor_event( my_monitor->private->provider );
+	nadp_desktop_provider_on_monitor_event( my_monitor->private->provider, file );
 }
@@ -71,11 +71,11 @@ static NAIFactoryObject *item_from_desktop_path( const NadpDesktopProvider *prov
 static NAIFactoryObject *item_from_desktop_file( const NadpDesktopProvider *provider, NadpDesktopFile *ndf, GSList **messages );
 static void              desktop_weak_notify( NadpDesktopFile *ndf, GObject *item );
 static void              free_desktop_paths( GList *paths );
+static gboolean          is_xml_data( const gchar *data, gsize length );
 
 static void              read_start_read_subitems_key( const NAIFactoryProvider *provider, NAObjectItem *item, NadpReaderData *reader_data, GSList **messages );
 static void              read_start_profile_attach_profile( const NAIFactoryProvider *provider, NAObjectProfile *profile, NadpReaderData *reader_data, GSList **messages );
 
-static gboolean          read_done_item_is_writable( const NAIFactoryProvider *provider, NAObjectItem *item, NadpReaderData *reader_data, GSList **messages );
 static void              read_done_action_read_profiles( const NAIFactoryProvider *provider, NAObjectAction *action, NadpReaderData *data, GSList **messages );
 static void              read_done_action_load_profile( const NAIFactoryProvider *provider, NadpReaderData *reader_data, const gchar *profile_id, GSList **messages );
 
@@ -374,15 +374,24 @@ nadp_reader_iimporter_import_from_uri( const NAIImporter *instance, void *parms_
 	g_return_val_if_fail( NADP_IS_DESKTOP_PROVIDER( instance ), IMPORTER_CODE_PROGRAM_ERROR );
 
 	parms = ( NAIImporterImportFromUriParmsv2 * ) parms_ptr;
+	code = IMPORTER_CODE_NOT_WILLING_TO;
+
+	/* when the caller has already read the file, reuse its data,
+	 * just rejecting XML documents without trying to parse them
+	 */
+	if( parms->content >= 3 && parms->data ){
+		ndf = is_xml_data( parms->data, parms->length )
+				? NULL
+				: nadp_desktop_file_new_from_data( parms->uri, parms->data, parms->length );
 
-	if( !na_core_utils_file_is_loadable( parms->uri )){
+	} else if( !na_core_utils_file_is_loadable( parms->uri )){
 		code = IMPORTER_CODE_NOT_LOADABLE;
 		return( code );
-	}
 
-	code = IMPORTER_CODE_NOT_WILLING_TO;
+	} else {
+		ndf = nadp_desktop_file_new_from_uri( parms->uri );
+	}
 
-	ndf = nadp_desktop_file_new_from_uri( parms->uri );
 	if( ndf ){
 		parms->imported = ( NAObjectItem * ) item_from_desktop_file(
 				( const NadpDesktopProvider * ) NADP_DESKTOP_PROVIDER( instance ),
@@ -413,6 +422,20 @@ nadp_reader_iimporter_import_from_uri( const NAIImporter *instance, void *parms_
 	return( code );
 }
 
+/*
+ * a key file never begins with '<', while a XML document does
+ * (BOM and leading spaces apart)
+ */
+static gboolean
+is_xml_data( const gchar *data, gsize length )
+{
+	gsize i;
+
+	i = na_core_utils_str_skip_bom_and_spaces( data, length );
+
+	return( i < length && data[i] == '<' );
+}
+
 /*
  * at this time, the object has been allocated and its id has been set
  * read here the subitems key, which may be 'Profiles' or 'ItemsList'
@@ -584,7 +607,6 @@ void
 nadp_reader_ifactory_provider_read_done( const NAIFactoryProvider *reader, void *reader_data, const NAIFactoryObject *serializable, GSList **messages )
 {
 	static const gchar *thisfn = "nadp_reader_ifactory_provider_read_done";
-	gboolean writable;
 
 	g_return_if_fail( NA_IS_IFACTORY_PROVIDER( reader ));
 	g_return_if_fail( NADP_IS_DESKTOP_PROVIDER( reader ));
@@ -599,11 +621,9 @@ nadp_reader_ifactory_provider_read_done( const NAIFactoryProvider *reader, void
 				( void * ) serializable, G_OBJECT_TYPE_NAME( serializable ),
 				( void * ) messages );
 
-		if( NA_IS_OBJECT_ITEM( serializable )){
-			writable = read_done_item_is_writable( reader, NA_OBJECT_ITEM( serializable ), ( NadpReaderData * ) reader_data, messages );
-			na_object_set_readonly( serializable, !writable );
-		}
-
+		/* the read-only status of the item is not checked here, as only
+		 * NACT needs it: see nadp_iio_provider_check_items_writability()
+		 */
 		if( NA_IS_OBJECT_ACTION( serializable )){
 			read_done_action_read_profiles( reader, NA_OBJECT_ACTION( serializable ), ( NadpReaderData * ) reader_data, messages );
 		}
@@ -612,21 +632,6 @@ nadp_reader_ifactory_provider_read_done( const NAIFactoryProvider *reader, void
 	}
 }
 
-static gboolean
-read_done_item_is_writable( const NAIFactoryProvider *provider, NAObjectItem *item, NadpReaderData *reader_data, GSList **messages )
-{
-	NadpDesktopFile *ndf;
-	gchar *uri;
-	gboolean writable;
-
-	ndf = reader_data->ndf;
-	uri = nadp_desktop_file_get_key_file_uri( ndf );
-	writable = nadp_utils_uri_is_writable( uri );
-	g_free( uri );
-
-	return( writable );
-}
-
 /*
  * Read and attach profiles in the specified order
  * - profiles which may exist in .desktop files, but are not referenced
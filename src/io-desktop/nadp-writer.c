@@ -33,6 +33,10 @@
 
 #include <errno.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <glib/gstdio.h>
 
 #include <api/na-core-utils.h>
 #include <api/na-data-types.h>
@@ -66,6 +70,7 @@ static ExportFormatFn st_export_format_fn[] = {
 static guint           write_item( const NAIIOProvider *provider, const NAObjectItem *item, NadpDesktopFile *ndf, GSList **messages );
 
 static void            desktop_weak_notify( NadpDesktopFile *ndf, GObject *item );
+static gboolean        is_path_writable( GHashTable *cache, const gchar *path );
 
 static void            write_start_write_type( NadpDesktopFile *ndp, NAObjectItem *item );
 static void            write_done_write_subitems_list( NadpDesktopFile *ndp, NAObjectItem *item );
@@ -239,7 +244,7 @@ write_item( const NAIIOProvider *provider, const NAObjectItem *item, NadpDesktop
 
 	na_ifactory_provider_write_item( NA_IFACTORY_PROVIDER( provider ), ndf, NA_IFACTORY_OBJECT( item ), messages );
 
-	if( !nadp_desktop_file_write( ndf )){
+	if( !nadp_desktop_provider_batch_write( self, ndf, item )){
 		ret = NA_IIO_PROVIDER_CODE_WRITE_ERROR;
 	}
 
@@ -253,7 +258,7 @@ nadp_iio_provider_delete_item( const NAIIOProvider *provider, const NAObjectItem
 	guint ret;
 	NadpDesktopProvider *self;
 	NadpDesktopFile *ndf;
-	gchar *uri;
+	gchar *uri, *path;
 
 	g_debug( "%s: provider=%p (%s), item=%p (%s), messages=%p",
 			thisfn,
@@ -278,6 +283,11 @@ nadp_iio_provider_delete_item( const NAIIOProvider *provider, const NAObjectItem
 	if( ndf ){
 		g_return_val_if_fail( NADP_IS_DESKTOP_FILE( ndf ), ret );
 		uri = nadp_desktop_file_get_key_file_uri( ndf );
+		path = g_filename_from_uri( uri, NULL, NULL );
+		if( path ){
+			nadp_desktop_provider_set_self_written( self, path );
+			g_free( path );
+		}
 		if( nadp_utils_uri_delete( uri )){
 			ret = NA_IIO_PROVIDER_CODE_OK;
 		}
@@ -344,6 +354,128 @@ nadp_iio_provider_duplicate_data( const NAIIOProvider *provider, NAObjectItem *d
 	return( NA_IIO_PROVIDER_CODE_OK );
 }
 
+/*
+ * Implementation of NAIIOProvider::write_batch_begin
+ */
+void
+nadp_iio_provider_write_batch_begin( const NAIIOProvider *provider )
+{
+	g_return_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ));
+
+	nadp_desktop_provider_batch_begin( NADP_DESKTOP_PROVIDER( provider ));
+}
+
+/*
+ * Implementation of NAIIOProvider::write_batch_end
+ */
+guint
+nadp_iio_provider_write_batch_end( const NAIIOProvider *provider, GList **failed, GSList **messages )
+{
+	guint ret;
+
+	ret = NA_IIO_PROVIDER_CODE_PROGRAM_ERROR;
+
+	g_return_val_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ), ret );
+
+	ret = NA_IIO_PROVIDER_CODE_OK;
+
+	if( !nadp_desktop_provider_batch_end( NADP_DESKTOP_PROVIDER( provider ), failed )){
+		ret = NA_IIO_PROVIDER_CODE_WRITE_ERROR;
+	}
+
+	return( ret );
+}
+
+/*
+ * Implementation of NAIIOProvider::check_items_writability
+ *
+ * The read-only status of the items is only needed by NACT: rather
+ * than querying each .desktop file at read time, we check here all the
+ * items in one pass.
+ * A file is writable depending of its directory (which also stands for
+ * the underlying filesystem), its owner and its permissions: the result
+ * of the access check is so cached for each such combination.
+ */
+void
+nadp_iio_provider_check_items_writability( const NAIIOProvider *provider, GList *items )
+{
+	static const gchar *thisfn = "nadp_iio_provider_check_items_writability";
+	GHashTable *cache;
+	GList *it;
+	NadpDesktopFile *ndf;
+	gchar *uri, *path;
+	gboolean writable;
+
+	g_return_if_fail( NADP_IS_DESKTOP_PROVIDER( provider ));
+
+	if( NADP_DESKTOP_PROVIDER( provider )->private->dispose_has_run ){
+		return;
+	}
+
+	cache = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+
+	for( it = items ; it ; it = it->next ){
+		writable = FALSE;
+		ndf = ( NadpDesktopFile * ) na_object_get_provider_data( it->data );
+
+		if( ndf && NADP_IS_DESKTOP_FILE( ndf )){
+			uri = nadp_desktop_file_get_key_file_uri( ndf );
+			path = uri ? g_filename_from_uri( uri, NULL, NULL ) : NULL;
+
+			if( path ){
+				writable = is_path_writable( cache, path );
+				g_free( path );
+
+			} else {
+				writable = nadp_utils_uri_is_writable( uri );
+			}
+
+			g_free( uri );
+		}
+
+		na_object_set_readonly( it->data, !writable );
+	}
+
+	g_debug( "%s: provider=%p, count=%d, checks=%d",
+			thisfn, ( void * ) provider, g_list_length( items ), g_hash_table_size( cache ));
+
+	g_hash_table_destroy( cache );
+}
+
+static gboolean
+is_path_writable( GHashTable *cache, const gchar *path )
+{
+	static const gchar *thisfn = "nadp_writer_is_path_writable";
+	struct stat st;
+	gchar *dir, *key;
+	gpointer value;
+	gboolean writable;
+
+	if( g_stat( path, &st ) == -1 ){
+		g_debug( "%s: %s: %s", thisfn, path, g_strerror( errno ));
+		return( FALSE );
+	}
+
+	dir = g_path_get_dirname( path );
+	key = g_strdup_printf( "%s:%lu:%lu:%o",
+			dir, ( gulong ) st.st_uid, ( gulong ) st.st_gid, ( guint )( st.st_mode & 07777 ));
+	g_free( dir );
+
+	if( g_hash_table_lookup_extended( cache, key, NULL, &value )){
+		writable = GPOINTER_TO_UINT( value );
+		g_free( key );
+
+	} else {
+		writable = ( g_access( path, W_OK ) == 0 );
+		if( !writable ){
+			g_debug( "%s: %s is not writable", thisfn, path );
+		}
+		g_hash_table_insert( cache, key, GUINT_TO_POINTER( writable ));
+	}
+
+	return( writable );
+}
+
 /**
  * nadp_writer_iexporter_export_to_buffer:
  * @instance: this #NAIExporter instance.
@@ -42,6 +42,9 @@ gboolean nadp_iio_provider_is_able_to_write    ( const NAIIOProvider *provider )
 guint    nadp_iio_provider_write_item          ( const NAIIOProvider *provider, const NAObjectItem *item, GSList **messages );
 guint    nadp_iio_provider_delete_item         ( const NAIIOProvider *provider, const NAObjectItem *item, GSList **messages );
 guint    nadp_iio_provider_duplicate_data      ( const NAIIOProvider *provider, NAObjectItem *dest, const NAObjectItem *source, GSList **messages );
+void     nadp_iio_provider_check_items_writability( const NAIIOProvider *provider, GList *items );
+void     nadp_iio_provider_write_batch_begin   ( const NAIIOProvider *provider );
+guint    nadp_iio_provider_write_batch_end     ( const NAIIOProvider *provider, GList **failed, GSList **messages );
 
 guint    nadp_writer_iexporter_export_to_buffer( const NAIExporter *instance, NAIExporterBufferParmsv2 *parms );
 guint    nadp_writer_iexporter_export_to_file  ( const NAIExporter *instance, NAIExporterFileParmsv2 *parms );
@@ -72,8 +72,7 @@ static guint    ifactory_provider_get_version( const NAIFactoryProvider *provide
 #ifdef NA_ENABLE_DEPRECATED
 static GList   *install_monitors( NagpGConfProvider *provider );
 static void     config_path_changed_cb( GConfClient *client, guint cnxn_id, GConfEntry *entry, NagpGConfProvider *provider );
-static gboolean config_path_changed_trigger_interface( NagpGConfProvider *provider );
-static gulong   time_val_diff( const GTimeVal *recent, const GTimeVal *old );
+static void     config_path_changed_trigger_interface( NagpGConfProvider *provider );
 #endif
 
 GType
@@ -157,6 +156,10 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->gconf = gconf_client_get_default();
 
 #ifdef NA_ENABLE_DEPRECATED
+	self->private->timeout.timeout = st_burst_timeout;
+	self->private->timeout.handler = ( NATimeoutFunc ) config_path_changed_trigger_interface;
+	self->private->timeout.user_data = self;
+
 	self->private->monitors = install_monitors( self );
 #endif
 }
@@ -180,6 +183,7 @@ instance_dispose( GObject *object )
 #ifdef NA_ENABLE_DEPRECATED
 		/* release the GConf monitoring */
 		na_gconf_monitor_release_monitors( self->private->monitors );
+		na_timeout_remove( &self->private->timeout );
 #endif
 
 		/* release the GConf connexion */
@@ -338,8 +342,8 @@ install_monitors( NagpGConfProvider *provider )
  *   triggered for each new/modified/deleted _entry_
  * - as we want trigger the NAIIOProvider interface only once for each
  *   update operation (i.e. once for each flow of individual notifications),
- *   then we install a timer in order to wait for all
- *   entries have been modified
+ *   then we record the event in our NATimeout structure in order to wait
+ *   for all entries have been modified
  * - when a [burst_timeout] reasonable delay has elapsed without having
  *   received any new individual notification, then we can assume that
  *   we have reached the end of the flow and that we can now trigger
@@ -357,58 +361,22 @@ config_path_changed_cb( GConfClient *client, guint cnxn_id, GConfEntry *entry, N
 
 	if( !provider->private->dispose_has_run ){
 
-		g_get_current_time( &provider->private->last_event );
-
-		if( !provider->private->event_source_id ){
-			provider->private->event_source_id =
-				g_timeout_add(
-						st_burst_timeout,
-						( GSourceFunc ) config_path_changed_trigger_interface,
-						provider );
-		}
+		na_timeout_event( &provider->private->timeout );
 	}
 }
 
 /*
- * this timer is set when we receive the first event of a serie
- * we continue to loop until last event is older that the st_burst_timeout
- * delay (in msec)
- * there is no race condition here as we are not multithreaded
- * or .. is there ?
+ * this handler is triggered by the NATimeout scheduler when the last
+ * individual notification is older that the st_burst_timeout delay (in msec)
  */
-static gboolean
+static void
 config_path_changed_trigger_interface( NagpGConfProvider *provider )
 {
 	static const gchar *thisfn = "nagp_gconf_provider_config_path_changed_trigger_interface";
-	GTimeVal now;
-	gulong diff;
-	gulong timeout_usec = 1000*st_burst_timeout;
-
-	g_get_current_time( &now );
-	diff = time_val_diff( &now, &provider->private->last_event );
-	if( diff < timeout_usec ){
-		return( TRUE );
-	}
 
-	/* last individual notification is older that the st_burst_timeout
-	 * so triggers the NAIIOProvider interface and destroys this timeout
-	 */
 	g_debug( "%s: triggering NAIIOProvider interface for provider=%p (%s)",
 			thisfn, ( void * ) provider, G_OBJECT_TYPE_NAME( provider ));
 
 	na_iio_provider_item_changed( NA_IIO_PROVIDER( provider ));
-	provider->private->event_source_id = 0;
-	return( FALSE );
-}
-
-/*
- * returns the difference in microseconds.
- */
-static gulong
-time_val_diff( const GTimeVal *recent, const GTimeVal *old )
-{
-	gulong microsec = 1000000 * ( recent->tv_sec - old->tv_sec );
-	microsec += recent->tv_usec  - old->tv_usec;
-	return( microsec );
 }
 #endif /* NA_ENABLE_DEPRECATED */
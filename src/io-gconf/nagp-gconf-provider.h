@@ -46,6 +46,8 @@
 #include <glib-object.h>
 #include <gconf/gconf-client.h>
 
+#include <api/na-timeout.h>
+
 G_BEGIN_DECLS
 
 #define NAGP_GCONF_PROVIDER_TYPE				( nagp_gconf_provider_get_type())
@@ -62,8 +64,7 @@ typedef struct _NagpGConfProviderPrivate {
 	gboolean     dispose_has_run;
 	GConfClient *gconf;
 	GList       *monitors;
-	guint        event_source_id;
-	GTimeVal     last_event;
+	NATimeout    timeout;
 }
 	NagpGConfProviderPrivate;
 
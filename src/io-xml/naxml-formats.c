@@ -90,6 +90,20 @@ static NaxmlExportFormat naxml_formats[] = {
 				"- or via the gconftool-2 --load command-line tool." ),
 			"export-dump.png" },
 
+	/* GCONF_DUMP: same than GCONF_ENTRY, but all exported items are
+	 * written in one single dump file
+	 */
+	{ NAXML_FORMAT_GCONF_DUMP,
+			N_( "Export all items as a _single GConf dump file" ),
+			N_( "All the exported items are written together into one " \
+				"GConf dump file, which is suitable to move a whole set of " \
+				"items from a machine to another one.\n" \
+				"The exported dump file may later be imported via :\n" \
+				"- Import assistant of the Nautilus-Actions Configuration Tool,\n" \
+				"- drag-n-drop into the Nautilus-Actions Configuration Tool,\n" \
+				"- or via the gconftool-2 --load command-line tool." ),
+			"export-dump.png" },
+
 	{ NULL }
 };
 
@@ -39,6 +39,7 @@ G_BEGIN_DECLS
 #define NAXML_FORMAT_GCONF_SCHEMA_V1			"GConfSchemaV1"
 #define NAXML_FORMAT_GCONF_SCHEMA_V2			"GConfSchemaV2"
 #define NAXML_FORMAT_GCONF_ENTRY				"GConfEntry"
+#define NAXML_FORMAT_GCONF_DUMP					"GConfDump"
 
 GList *naxml_formats_get_formats ( const NAIExporter *exporter );
 void   naxml_formats_free_formats( GList *format_list );
@@ -31,6 +31,8 @@
 #include <config.h>
 #endif
 
+#include <libxml/parser.h>
+
 #include <api/na-extension.h>
 
 #include "naxml-provider.h"
@@ -109,4 +111,8 @@ na_extension_shutdown( void )
 	static const gchar *thisfn = "naxml_module_na_extension_shutdown";
 
 	g_debug( "%s", thisfn );
+
+	/* the reader doesn't cleanup the parser after each imported file
+	 */
+	xmlCleanupParser();
 }
@@ -31,8 +31,10 @@
 #include <config.h>
 #endif
 
+#include <gio/gio.h>
 #include <glib/gi18n.h>
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 #include <string.h>
 
 #include <api/na-core-utils.h>
@@ -64,6 +66,7 @@ typedef struct {
 	guint   ( *fn_list_parms )     ( NAXMLReader *, xmlNode * );
 	guint   ( *fn_element_parms )  ( NAXMLReader *, xmlNode * );
 	guint   ( *fn_element_content )( NAXMLReader *, xmlNode * );
+	gchar * ( *fn_element_id )     ( NAXMLReader *, xmlNode * );
 	gchar * ( *fn_get_value )      ( NAXMLReader *, xmlNode *, const NADataDef *def );
 }
 	RootNodeStr;
@@ -71,6 +74,11 @@ typedef struct {
 /* private instance data
  * main naxml_reader_import_from_uri() function is called once for each file
  * to import. We thus have one NAXMLReader object per import operation.
+ *
+ * The file is streamed: element nodes are copied one at a time into a
+ * per-item document, which is released as soon as the item has been built.
+ * The memory footprint so only depends of the size of the biggest item,
+ * whatever be the count of items in the file.
  */
 struct _NAXMLReaderPrivate {
 	gboolean                         dispose_has_run;
@@ -87,6 +95,8 @@ struct _NAXMLReaderPrivate {
 	GList                           *dealt;
 	RootNodeStr                     *root_node_str;
 	gchar                           *item_id;
+	xmlDoc                          *item_doc;
+	GList                           *items;
 
 	/* following values are reset and reused while iterating on each
 	 * element nodes of the imported item (cf. reset_node_data())
@@ -108,6 +118,7 @@ static void          instance_finalize( GObject *object );
 static NAXMLReader  *reader_new( void );
 
 static guint         schema_parse_schema_content( NAXMLReader *reader, xmlNode *node );
+static gchar        *schema_get_element_id( NAXMLReader *reader, xmlNode *node );
 static void          schema_check_for_id( NAXMLReader *reader, xmlNode *iter );
 static void          schema_check_for_type( NAXMLReader *reader, xmlNode *iter );
 static gchar        *schema_read_value( NAXMLReader *reader, xmlNode *node, const NADataDef *def );
@@ -128,6 +139,7 @@ static RootNodeStr st_root_node_str[] = {
 			NULL,
 			NULL,
 			schema_parse_schema_content,
+			schema_get_element_id,
 			schema_read_value },
 
 	{ NAXML_KEY_DUMP_ROOT,
@@ -139,12 +151,14 @@ static RootNodeStr st_root_node_str[] = {
 			dump_parse_list_parms,
 			NULL,
 			dump_parse_entry_content,
+			NULL,
 			dump_read_value },
 
 	{ NULL }
 };
 
 #define ERR_ITEM_ID_NOT_FOUND		_( "Item ID not found." )
+#define ERR_ITEMS_IGNORED			_( "%d more items found in the document, ignored." )
 #define ERR_MENU_UNWAITED			_( "Unwaited key path %s while importing a menu." )
 #define ERR_NODE_ALREADY_FOUND		_( "Element %s at line %d already found, ignored." )
 #define ERR_NODE_INVALID_ID			_( "Invalid item ID: waited for %s, found %s at line %d." )
@@ -163,8 +177,14 @@ static void          read_done_action_load_profile( NAXMLReader *reader, const g
 static void          read_done_profile_set_localized_label( NAXMLReader *reader, NAObjectProfile *profile );
 
 static guint         reader_parse_xmldoc( NAXMLReader *reader );
-static guint         iter_on_root_children( NAXMLReader *reader, xmlNode *root );
-static guint         iter_on_list_children( NAXMLReader *reader, xmlNode *first );
+static guint         iter_on_root_children( NAXMLReader *reader, xmlTextReader *stream );
+static guint         iter_on_list_children( NAXMLReader *reader, xmlTextReader *stream );
+static xmlNode      *copy_element_node( NAXMLReader *reader, xmlTextReader *stream );
+static guint         item_done( NAXMLReader *reader );
+static void          item_reset( NAXMLReader *reader );
+static int           stream_next_element( xmlTextReader *stream, int depth, gboolean check_current );
+static gboolean      is_streamable( const gchar *uri );
+static gboolean      is_xml_data( const gchar *data, gsize length );
 
 static gchar        *slist_to_string( GSList *slist );
 static gchar        *build_key_node_list( NAXMLKeyStr *strlist );
@@ -265,8 +285,9 @@ instance_dispose( GObject *object )
 
 		self->private->dispose_has_run = TRUE;
 
-		g_list_free( self->private->nodes );
-		g_list_free( self->private->dealt );
+		item_reset( self );
+		na_object_free_items( self->private->items );
+		self->private->items = NULL;
 
 		/* chain up to the parent class */
 		if( G_OBJECT_CLASS( st_parent_class )->dispose ){
@@ -326,6 +347,7 @@ naxml_reader_import_from_uri( const NAIImporter *instance, void *parms_ptr )
 	NAXMLReader *reader;
 	NAIImporterImportFromUriParmsv2* parms;
 	guint code;
+	GList *it;
 
 	g_debug( "%s: instance=%p, parms=%p", thisfn, ( void * ) instance, parms_ptr );
 
@@ -334,7 +356,16 @@ naxml_reader_import_from_uri( const NAIImporter *instance, void *parms_ptr )
 	parms = ( NAIImporterImportFromUriParmsv2 * ) parms_ptr;
 	parms->imported = NULL;
 
-	if( !na_core_utils_file_is_loadable( parms->uri )){
+	/* when the caller has already read the file, just check that its
+	 * content may be XML before trying to parse it
+	 */
+	if( parms->content >= 3 && parms->data ){
+		if( !is_xml_data( parms->data, parms->length )){
+			na_core_utils_slist_add_message( &parms->messages, ERR_NOT_IOXML );
+			return( IMPORTER_CODE_NOT_WILLING_TO );
+		}
+
+	} else if( !is_streamable( parms->uri )){
 		return( IMPORTER_CODE_NOT_LOADABLE );
 	}
 
@@ -348,16 +379,34 @@ naxml_reader_import_from_uri( const NAIImporter *instance, void *parms_ptr )
 		na_core_utils_slist_add_message( &reader->private->parms->messages, ERR_NOT_IOXML );
 	}
 
-	g_object_unref( reader );
-
+	/* the first item is returned in 'imported', others in 'more_imported'
+	 * if the caller is able to deal with them
+	 */
 	if( code == IMPORTER_CODE_OK ){
-		na_object_dump( parms->imported );
+		reader->private->items = g_list_reverse( reader->private->items );
+		parms->imported = NA_OBJECT_ITEM( reader->private->items->data );
+		reader->private->items = g_list_delete_link( reader->private->items, reader->private->items );
 
-	} else if( parms->imported ){
-		g_object_unref( parms->imported );
-		parms->imported = NULL;
+		if( reader->private->items ){
+			if( parms->content >= 2 ){
+				parms->more_imported = reader->private->items;
+
+			} else {
+				na_core_utils_slist_add_message( &parms->messages,
+						ERR_ITEMS_IGNORED, g_list_length( reader->private->items ));
+				na_object_free_items( reader->private->items );
+			}
+			reader->private->items = NULL;
+		}
+
+		na_object_dump( parms->imported );
+		for( it = parms->more_imported ; it ; it = it->next ){
+			na_object_dump( it->data );
+		}
 	}
 
+	g_object_unref( reader );
+
 	return( code );
 }
 
@@ -370,123 +419,153 @@ naxml_reader_import_from_uri( const NAIImporter *instance, void *parms_ptr )
  * At import time, it is worthless to say that there is, e.g. a badly formed
  * xml file, as we are not even sure that we are trying to import a .xml.
  * So just keep ride of error messages here.
+ *
+ * The document is read through a xmlTextReader stream, so that it is
+ * never fully loaded in memory; when the caller has already read the
+ * file, the stream is built on top of its data.
  */
 static guint
 reader_parse_xmldoc( NAXMLReader *reader )
 {
+	xmlTextReader *stream;
 	RootNodeStr *istr;
 	gboolean found;
 	guint code;
 
-	xmlDoc *doc = xmlParseFile( reader->private->parms->uri );
-
-	if( !doc ){
-		xmlErrorPtr error = xmlGetLastError();
-		xmlResetError( error );
-		code = IMPORTER_CODE_NOT_WILLING_TO;
+	code = IMPORTER_CODE_NOT_WILLING_TO;
 
+	if( reader->private->parms->content >= 3 && reader->private->parms->data ){
+		stream = xmlReaderForMemory(
+				reader->private->parms->data, ( int ) reader->private->parms->length,
+				reader->private->parms->uri, NULL, XML_PARSE_NOERROR | XML_PARSE_NOWARNING | XML_PARSE_NONET );
 	} else {
-		xmlNode *root_node = xmlDocGetRootElement( doc );
+		stream = xmlReaderForFile( reader->private->parms->uri, NULL, XML_PARSE_NOERROR | XML_PARSE_NOWARNING | XML_PARSE_NONET );
+	}
+
+	if( stream ){
+
+		if( stream_next_element( stream, 0, FALSE ) == 1 ){
 
-		istr = st_root_node_str;
-		found = FALSE;
+			istr = st_root_node_str;
+			found = FALSE;
 
-		while( istr->root_key && !found ){
-			if( !strxcmp( root_node->name, istr->root_key )){
-				found = TRUE;
-				reader->private->root_node_str = istr;
-				code = iter_on_root_children( reader, root_node );
+			while( istr->root_key && !found ){
+				if( !strxcmp( xmlTextReaderConstName( stream ), istr->root_key )){
+					found = TRUE;
+					reader->private->root_node_str = istr;
+					code = iter_on_root_children( reader, stream );
+				}
+				istr++;
 			}
-			istr++;
-		}
 
-		if( !found ){
-			gchar *node_list = build_root_node_list();
-			g_free( node_list );
-			na_core_utils_slist_free( reader->private->parms->messages );
-			reader->private->parms->messages = NULL;
-			code = IMPORTER_CODE_NOT_WILLING_TO;
+			if( !found ){
+				na_core_utils_slist_free( reader->private->parms->messages );
+				reader->private->parms->messages = NULL;
+			}
 		}
 
-		xmlFreeDoc (doc);
+		xmlFreeTextReader( stream );
+	}
+
+	if( code != IMPORTER_CODE_OK ){
+		if( reader->private->parms->imported ){
+			g_object_unref( reader->private->parms->imported );
+			reader->private->parms->imported = NULL;
+		}
+		na_object_free_items( reader->private->items );
+		reader->private->items = NULL;
 	}
 
-	xmlCleanupParser();
 	return( code );
 }
 
 /*
- * Parse an XML tree when importing an URI.
+ * Parse an XML stream when importing an URI.
  *
  * We are almost sure here that the imported file is a well-formed XML
  * document, with a known root document node. Starting from here,we should
  * no more return a 'unwilling to' code, but an error one.
  *
- * Check that:
- * - must have one child on the named 'first_child' key (others are warned)
- * - then iter on child nodes of this previous first named which must be
- * 'next_child'
- * e.g. for a <gconfentryfile> root node, we must have one and only one
- * <entrylist> child.
+ * Check that the first level of children (e.g. for a <gconfentryfile>
+ * root node, the <entrylist> children) are all named 'list_key', others
+ * are warned.
+ *
+ * A document may contain several lists, e.g. a dump of several items;
+ * each list ends the item it defines.
  */
 static guint
-iter_on_root_children( NAXMLReader *reader, xmlNode *root )
+iter_on_root_children( NAXMLReader *reader, xmlTextReader *stream )
 {
 	static const gchar *thisfn = "naxml_reader_iter_on_root_children";
-	xmlNodePtr iter;
-	gboolean found;
 	guint code;
+	int ret;
 
-	g_debug( "%s: reader=%p, root=%p", thisfn, ( void * ) reader, ( void * ) root );
+	g_debug( "%s: reader=%p, stream=%p", thisfn, ( void * ) reader, ( void * ) stream );
 
 	code = IMPORTER_CODE_OK;
 
 	/* deal with properties attached to the root node
+	 * note that only the attributes of the node are available here
 	 */
 	if( reader->private->root_node_str->fn_root_parms ){
-		code = ( *reader->private->root_node_str->fn_root_parms )( reader, root );
+		code = ( *reader->private->root_node_str->fn_root_parms )( reader, xmlTextReaderCurrentNode( stream ));
 	}
 
 	/* iter through the first level of children (list)
-	 * we must have only one occurrence of this first 'list' child
 	 */
-	found = FALSE;
-	for( iter = root->children ; iter && code == IMPORTER_CODE_OK ; iter = iter->next ){
+	ret = xmlTextReaderIsEmptyElement( stream ) ? 0 : stream_next_element( stream, 1, FALSE );
 
-		if( iter->type != XML_ELEMENT_NODE ){
-			continue;
-		}
+	while( ret == 1 && code == IMPORTER_CODE_OK ){
 
-		if( strxcmp( iter->name, reader->private->root_node_str->list_key )){
+		if( strxcmp( xmlTextReaderConstName( stream ), reader->private->root_node_str->list_key )){
 			na_core_utils_slist_add_message( &reader->private->parms->messages,
 					ERR_NODE_UNKNOWN,
-					( const char * ) iter->name, iter->line, reader->private->root_node_str->list_key );
-			continue;
-		}
+					( const char * ) xmlTextReaderConstName( stream ),
+					xmlTextReaderGetParserLineNumber( stream ),
+					reader->private->root_node_str->list_key );
+
+			/* skip the unknown subtree up to its next sibling */
+			ret = xmlTextReaderNext( stream );
+			if( ret == 1 ){
+				ret = stream_next_element( stream, 1, TRUE );
+			}
 
-		if( found ){
-			na_core_utils_slist_add_message( &reader->private->parms->messages, ERR_NODE_ALREADY_FOUND, ( const char * ) iter->name, iter->line );
-			continue;
+		} else {
+			/* we are left on the end of the list */
+			code = iter_on_list_children( reader, stream );
+			ret = stream_next_element( stream, 1, FALSE );
 		}
+	}
 
-		found = TRUE;
-		code = iter_on_list_children( reader, iter );
+	/* a parse error is detected at some time during the stream: we are
+	 * not even sure that the file was actually intended for us
+	 */
+	if( ret < 0 ){
+		code = IMPORTER_CODE_NOT_WILLING_TO;
+	}
+
+	/* check that we have at least one item
+	 */
+	if( code == IMPORTER_CODE_OK && !reader->private->items ){
+		na_core_utils_slist_add_message( &reader->private->parms->messages, ERR_ITEM_ID_NOT_FOUND );
+		code = IMPORTER_CODE_NO_ITEM_ID;
 	}
 
 	return( code );
 }
 
 /*
- * Parse an XML tree when importing an URI.
+ * Parse an XML stream when importing an URI.
  *
  * iter on 'schema/entry' element nodes
  * each node should correspond to an elementary data of the imported item
  * other nodes are warned (and ignored)
  *
- * we have to iterate a first time through all nodes to be sure to find
- * a potential 'type' indication - this is needed in order to allocate an
- * action or a menu - if not found at the end of this first pass, we default
- * to allocate an action
+ * each node is expanded and copied to the current item document; we have
+ * to iterate through all nodes of the item to be sure to find a potential
+ * 'type' indication - this is needed in order to allocate an action or a
+ * menu - if not found at the end of the item, we default to allocate an
+ * action
  *
  * this first pass is also used to check nodes
  *
@@ -504,97 +583,276 @@ iter_on_root_children( NAXMLReader *reader, xmlNode *root )
  *      as the item may not be allocated yet, we cannot check that data
  *      is actually relevant with the to-be-imported item
  *
- * each schema 'applyto' node let us identify a data and its value
+ * each schema 'applyto' node let us identify a data and its value; when
+ * this identifier changes, the previous item is done and a new one starts
  */
 static guint
-iter_on_list_children( NAXMLReader *reader, xmlNode *list )
+iter_on_list_children( NAXMLReader *reader, xmlTextReader *stream )
 {
 	static const gchar *thisfn = "naxml_reader_iter_on_list_children";
 	guint code;
-	xmlNode *iter;
+	xmlNode *node;
+	gchar *id;
+	int ret;
 
-	g_debug( "%s: reader=%p, list=%p", thisfn, ( void * ) reader, ( void * ) list );
+	g_debug( "%s: reader=%p, stream=%p", thisfn, ( void * ) reader, ( void * ) stream );
 
 	code = IMPORTER_CODE_OK;
 
 	/* deal with properties attached to the list node
 	 */
 	if( reader->private->root_node_str->fn_list_parms ){
-		code = ( *reader->private->root_node_str->fn_list_parms )( reader, list );
+		code = ( *reader->private->root_node_str->fn_list_parms )( reader, xmlTextReaderCurrentNode( stream ));
 	}
 
 	/* each occurrence should correspond to an elementary data
 	 * we run first to determine the type, and allocate the object
 	 * we then rely on NAIFactoryProvider to actually read the data
 	 */
-	for( iter = list->children ; iter && code == IMPORTER_CODE_OK ; iter = iter->next ){
+	ret = xmlTextReaderIsEmptyElement( stream ) ? 0 : stream_next_element( stream, 2, FALSE );
 
-		if( iter->type != XML_ELEMENT_NODE ){
-			continue;
-		}
+	while( ret == 1 && code == IMPORTER_CODE_OK ){
 
-		if( strxcmp( iter->name, reader->private->root_node_str->element_key )){
+		if( strxcmp( xmlTextReaderConstName( stream ), reader->private->root_node_str->element_key )){
 			na_core_utils_slist_add_message( &reader->private->parms->messages,
 					ERR_NODE_UNKNOWN,
-					( const char * ) iter->name, iter->line, reader->private->root_node_str->element_key );
-			continue;
-		}
+					( const char * ) xmlTextReaderConstName( stream ),
+					xmlTextReaderGetParserLineNumber( stream ),
+					reader->private->root_node_str->element_key );
 
-		reset_node_data( reader );
+		} else {
+			node = copy_element_node( reader, stream );
+
+			if( node ){
+				if( reader->private->root_node_str->fn_element_id ){
+					id = ( *reader->private->root_node_str->fn_element_id )( reader, node );
+					if( id && reader->private->item_id && strcmp( id, reader->private->item_id )){
+						xmlUnlinkNode( node );
+						xmlFreeNode( node );
+						code = item_done( reader );
+						node = copy_element_node( reader, stream );
+					}
+					g_free( id );
+				}
 
-		if( reader->private->root_node_str->fn_element_parms ){
-			code = ( *reader->private->root_node_str->fn_element_parms )( reader, iter );
-			if( code != IMPORTER_CODE_OK ){
-				continue;
-			}
-		}
+				reset_node_data( reader );
 
-		if( reader->private->root_node_str->fn_element_content ){
-			code = ( *reader->private->root_node_str->fn_element_content )( reader, iter );
-			if( code != IMPORTER_CODE_OK ){
-				continue;
+				if( code == IMPORTER_CODE_OK && reader->private->root_node_str->fn_element_parms ){
+					code = ( *reader->private->root_node_str->fn_element_parms )( reader, node );
+				}
+
+				if( code == IMPORTER_CODE_OK && reader->private->root_node_str->fn_element_content ){
+					code = ( *reader->private->root_node_str->fn_element_content )( reader, node );
+				}
+
+				if( code == IMPORTER_CODE_OK && reader->private->node_ok ){
+					reader->private->nodes = g_list_prepend( reader->private->nodes, node );
+				}
 			}
 		}
 
-		if( reader->private->node_ok ){
-			reader->private->nodes = g_list_prepend( reader->private->nodes, iter );
+		/* skip the subtree up to its next sibling */
+		ret = xmlTextReaderNext( stream );
+		if( ret == 1 ){
+			ret = stream_next_element( stream, 2, TRUE );
 		}
 	}
 
-	/* if we do not have any error, check that we have at least a not empty id
+	/* the end of the list also ends the current item
 	 */
 	if( code == IMPORTER_CODE_OK ){
+		code = item_done( reader );
+	}
+
+	return( code );
+}
+
+/*
+ * expand the current element node of the stream, and copy it into the
+ * document of the current item (which is allocated if needed)
+ */
+static xmlNode *
+copy_element_node( NAXMLReader *reader, xmlTextReader *stream )
+{
+	xmlNode *expanded, *node;
+
+	node = NULL;
+	expanded = xmlTextReaderExpand( stream );
+
+	if( expanded ){
+		if( !reader->private->item_doc ){
+			reader->private->item_doc = xmlNewDoc( BAD_CAST( "1.0" ));
+			xmlDocSetRootElement( reader->private->item_doc,
+					xmlNewNode( NULL, BAD_CAST( reader->private->root_node_str->list_key )));
+		}
+
+		node = xmlDocCopyNode( expanded, reader->private->item_doc, 1 );
+		xmlAddChild( xmlDocGetRootElement( reader->private->item_doc ), node );
+	}
+
+	return( node );
+}
+
+/*
+ * all the nodes of the current item have been read: actually load the
+ * data, and release the nodes
+ */
+static guint
+item_done( NAXMLReader *reader )
+{
+	guint code;
+
+	code = IMPORTER_CODE_OK;
+
+	/* nothing to do if the list was empty
+	 */
+	if( reader->private->item_id || reader->private->nodes || reader->private->parms->imported ){
+
+		/* check that we have at least a not empty id
+		 */
 		if( !reader->private->item_id || !strlen( reader->private->item_id )){
 			na_core_utils_slist_add_message( &reader->private->parms->messages, ERR_ITEM_ID_NOT_FOUND );
 			code = IMPORTER_CODE_NO_ITEM_ID;
 		}
-	}
 
-	/* if type not found, then suppose that we have an action
-	 */
-	if( code == IMPORTER_CODE_OK ){
+		/* if type not found, then suppose that we have an action
+		 */
+		if( code == IMPORTER_CODE_OK ){
 
-		if( !reader->private->type_found ){
-			reader->private->parms->imported = NA_OBJECT_ITEM( na_object_action_new());
+			if( !reader->private->type_found ){
+				reader->private->parms->imported = NA_OBJECT_ITEM( na_object_action_new());
+			}
 		}
-	}
 
-	/* now load the data
-	 */
-	if( code == IMPORTER_CODE_OK ){
+		/* now load the data
+		 */
+		if( code == IMPORTER_CODE_OK ){
+
+			na_object_set_id( reader->private->parms->imported, reader->private->item_id );
+
+			na_ifactory_provider_read_item(
+					NA_IFACTORY_PROVIDER( reader->private->importer ),
+					reader,
+					NA_IFACTORY_OBJECT( reader->private->parms->imported ),
+					&reader->private->parms->messages );
 
-		na_object_set_id( reader->private->parms->imported, reader->private->item_id );
+			reader->private->items = g_list_prepend( reader->private->items, reader->private->parms->imported );
+			reader->private->parms->imported = NULL;
 
-		na_ifactory_provider_read_item(
-				NA_IFACTORY_PROVIDER( reader->private->importer ),
-				reader,
-				NA_IFACTORY_OBJECT( reader->private->parms->imported ),
-				&reader->private->parms->messages );
+		} else if( reader->private->parms->imported ){
+			g_object_unref( reader->private->parms->imported );
+			reader->private->parms->imported = NULL;
+		}
 	}
 
+	item_reset( reader );
+
 	return( code );
 }
 
+static void
+item_reset( NAXMLReader *reader )
+{
+	g_list_free( reader->private->nodes );
+	reader->private->nodes = NULL;
+
+	g_list_free( reader->private->dealt );
+	reader->private->dealt = NULL;
+
+	if( reader->private->item_doc ){
+		xmlFreeDoc( reader->private->item_doc );
+		reader->private->item_doc = NULL;
+	}
+
+	g_free( reader->private->item_id );
+	reader->private->item_id = NULL;
+
+	reader->private->type_found = FALSE;
+}
+
+/*
+ * as the document is streamed, we do not need to limit its size as
+ * na_core_utils_file_is_loadable() does: just check that this is a not
+ * empty regular file
+ */
+static gboolean
+is_streamable( const gchar *uri )
+{
+	static const gchar *thisfn = "naxml_reader_is_streamable";
+	GFile *file;
+	GFileInfo *info;
+	GError *error;
+	gboolean isok;
+
+	error = NULL;
+	isok = FALSE;
+	file = g_file_new_for_uri( uri );
+	info = g_file_query_info( file,
+			G_FILE_ATTRIBUTE_STANDARD_SIZE "," G_FILE_ATTRIBUTE_STANDARD_TYPE,
+			G_FILE_QUERY_INFO_NONE, NULL, &error );
+
+	if( !info ){
+		g_debug( "%s: %s", thisfn, error->message );
+		g_error_free( error );
+
+	} else {
+		isok = ( g_file_info_get_file_type( info ) == G_FILE_TYPE_REGULAR &&
+				g_file_info_get_attribute_uint64( info, G_FILE_ATTRIBUTE_STANDARD_SIZE ) > 0 );
+		g_object_unref( info );
+	}
+
+	g_object_unref( file );
+
+	return( isok );
+}
+
+/*
+ * an XML document starts with a '<', after an eventual UTF-8 byte order
+ * mark and some spaces
+ */
+static gboolean
+is_xml_data( const gchar *data, gsize length )
+{
+	gsize i;
+
+	i = na_core_utils_str_skip_bom_and_spaces( data, length );
+
+	return( i < length && data[i] == '<' );
+}
+
+/*
+ * advance the stream up to the next element node at the given depth,
+ * stopping when leaving the parent element
+ * if @check_current is %TRUE, the current node is first examined (e.g.
+ * just after xmlTextReaderNext() has positioned the stream)
+ *
+ * Returns: 1 if positioned on an element node at @depth, 0 at the end
+ * of the parent element or of the document, -1 on parse error.
+ */
+static int
+stream_next_element( xmlTextReader *stream, int depth, gboolean check_current )
+{
+	int ret;
+
+	ret = check_current ? 1 : xmlTextReaderRead( stream );
+
+	while( ret == 1 ){
+
+		if( xmlTextReaderDepth( stream ) < depth ){
+			return( 0 );
+		}
+
+		if( xmlTextReaderDepth( stream ) == depth &&
+				xmlTextReaderNodeType( stream ) == XML_READER_TYPE_ELEMENT ){
+			return( 1 );
+		}
+
+		ret = xmlTextReaderRead( stream );
+	}
+
+	return( ret );
+}
+
 void
 naxml_reader_read_start( const NAIFactoryProvider *provider, void *reader_data, const NAIFactoryObject *object, GSList **messages  )
 {
@@ -1051,6 +1309,38 @@ schema_check_for_id( NAXMLReader *reader, xmlNode *iter )
 	g_free( id );
 }
 
+/*
+ * returns the item id of a 'schema' element, as found in its 'applyto'
+ * key, or NULL
+ */
+static gchar *
+schema_get_element_id( NAXMLReader *reader, xmlNode *schema )
+{
+	xmlNode *applyto;
+	xmlChar *text;
+	gchar **path_elts;
+	gchar *id;
+	guint idx;
+
+	id = NULL;
+	applyto = search_for_child_node( schema, NAXML_KEY_SCHEMA_NODE_APPLYTO );
+
+	if( applyto ){
+		text = xmlNodeGetContent( applyto );
+		path_elts = g_strsplit(( const gchar * ) text, "/", -1 );
+		idx = reader->private->root_node_str->key_length-2;
+
+		if( g_strv_length( path_elts ) > idx ){
+			id = g_strdup( path_elts[idx] );
+		}
+
+		g_strfreev( path_elts );
+		xmlFree( text );
+	}
+
+	return( id );
+}
+
 /*
  * check 'applyto' key for 'Type'
  */
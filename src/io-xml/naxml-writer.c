@@ -34,6 +34,7 @@
 #include <gio/gio.h>
 #include <libintl.h>
 #include <libxml/tree.h>
+#include <libxml/xmlIO.h>
 #include <string.h>
 
 #include <api/na-core-utils.h>
@@ -89,8 +90,17 @@ struct ExportFormatFn {
 	gchar  *element_node;
 	void ( *write_data_fn )( NAXMLWriter *, const NAObjectId *, const NADataBoxed *, const NADataDef * );
 	void ( *write_type_fn )( NAXMLWriter *, const NAObjectItem *, const NADataDef *, const gchar * );
+	gboolean multi;						/* whether several items may be written in one file */
 };
 
+/* the context of the libxml output buffer when streaming an archive
+ */
+typedef struct {
+	GOutputStream *stream;
+	GError        *error;
+}
+	ArchiveOutput;
+
 static GObjectClass *st_parent_class = NULL;
 
 static GType           register_type( void );
@@ -124,6 +134,9 @@ static ExportFormatFn *find_export_format_fn_from_quark( GQuark format );
 static gchar          *get_output_fname( const NAObjectItem *item, const gchar *folder, const gchar *format );
 static void            output_xml_to_file( const gchar *xml, const gchar *filename, GSList **msg );
 static guint           writer_to_buffer( NAXMLWriter *writer );
+static guint           writer_to_archive( NAXMLWriter *writer, GList *more, const gchar *filename, GSList **msg );
+static void            archive_write_item( NAXMLWriter *writer, xmlOutputBufferPtr out, NAObjectItem *item );
+static int             archive_write( ArchiveOutput *output, const char *buffer, int len );
 
 static ExportFormatFn st_export_format_fn[] = {
 
@@ -151,6 +164,15 @@ static ExportFormatFn st_export_format_fn[] = {
 					write_data_dump,
 					write_type_dump },
 
+	{ NAXML_FORMAT_GCONF_DUMP,
+					NAXML_KEY_DUMP_ROOT,
+					NAXML_KEY_DUMP_LIST,
+					write_list_attribs_dump,
+					NAXML_KEY_DUMP_NODE,
+					write_data_dump,
+					write_type_dump,
+					TRUE },
+
 	{ NULL }
 };
 
@@ -326,6 +348,10 @@ naxml_writer_export_to_buffer( const NAIExporter *instance, NAIExporterBufferPar
  * @parms: a #NAIExporterFileParmsv2 structure.
  *
  * Export the specified 'item' to a newly created file.
+ *
+ * If the format is able to hold several items, and the caller has
+ * provided more items to be exported, then all these items are streamed
+ * into the same file, and the 'more_exported' list is reset to %NULL.
  */
 guint
 naxml_writer_export_to_file( const NAIExporter *instance, NAIExporterFileParmsv2 *parms )
@@ -367,6 +393,26 @@ naxml_writer_export_to_file( const NAIExporter *instance, NAIExporterFileParmsv2
 		if( !writer->private->fn_str ){
 			code = NA_IEXPORTER_CODE_INVALID_FORMAT;
 
+		} else if( writer->private->fn_str->multi ){
+			filename = get_output_fname( parms->exported, parms->folder, format2 );
+
+			if( filename ){
+				code = writer_to_archive( writer,
+						parms->version >= 2 && parms->content >= 2 ? parms->more_exported : NULL,
+						filename, parms->messages ? &writer->private->messages : NULL );
+
+				if( code == NA_IEXPORTER_CODE_OK ){
+					parms->basename = g_path_get_basename( filename );
+					if( parms->version >= 2 && parms->content >= 2 ){
+						parms->more_exported = NULL;
+					}
+				}
+				if( parms->messages ){
+					parms->messages = writer->private->messages;
+				}
+				g_free( filename );
+			}
+
 		} else {
 			code = writer_to_buffer( writer );
 
@@ -847,6 +893,10 @@ get_output_fname( const NAObjectItem *item, const gchar *folder, const gchar *fo
 		canonical_fname = g_strdup_printf( "%s-%s", NA_IS_OBJECT_ACTION( item ) ? "action" : "menu", item_id );
 		canonical_ext = g_strdup( "xml" );
 
+	} else if( !strcmp( format, NAXML_FORMAT_GCONF_DUMP )){
+		canonical_fname = g_strdup_printf( "%s-dump", PACKAGE_TARNAME );
+		canonical_ext = g_strdup( "xml" );
+
 	} else {
 		g_warning( "%s: unknown format: %s", thisfn, format );
 	}
@@ -965,3 +1015,144 @@ writer_to_buffer( NAXMLWriter *writer )
 
 	return( code );
 }
+
+/*
+ * writer_to_archive:
+ * @writer: this #NAXMLWriter instance, whose 'exported' item is the
+ *  first item to be written.
+ * @more: a list of other items to be written to the same file.
+ * @filename: the URI of the output file.
+ * @msg: a GSList to append messages.
+ *
+ * Streams all items into one dump document: each item is built in its
+ * own small document, whose list node is written to the output stream
+ * before the document be freed. The memory footprint so only depends
+ * on the size of the biggest item, and the output file is written in
+ * one sequential pass.
+ */
+static guint
+writer_to_archive( NAXMLWriter *writer, GList *more, const gchar *filename, GSList **msg )
+{
+	static const gchar *thisfn = "naxml_writer_to_archive";
+	guint code;
+	GFile *file;
+	GFileOutputStream *stream;
+	GError *error;
+	ArchiveOutput output;
+	xmlOutputBufferPtr out;
+	GList *it;
+	NAObjectItem *first;
+	gchar *errmsg;
+	gchar *str;
+
+	g_debug( "%s: writer=%p, more=%p (count=%d), filename=%s",
+			thisfn, ( void * ) writer, ( void * ) more, g_list_length( more ), filename );
+
+	code = NA_IEXPORTER_CODE_OK;
+	error = NULL;
+	file = g_file_new_for_uri( filename );
+
+	stream = g_file_replace( file, NULL, FALSE, G_FILE_CREATE_NONE, NULL, &error );
+	if( error ){
+		errmsg = g_strdup_printf( "%s: g_file_replace: %s", thisfn, error->message );
+		g_warning( "%s", errmsg );
+		if( msg ){
+			*msg = g_slist_append( *msg, errmsg );
+		} else {
+			g_free( errmsg );
+		}
+		g_error_free( error );
+		if( stream ){
+			g_object_unref( stream );
+		}
+		g_object_unref( file );
+		return( NA_IEXPORTER_CODE_UNABLE_TO_WRITE );
+	}
+
+	output.stream = G_OUTPUT_STREAM( stream );
+	output.error = NULL;
+	out = xmlOutputBufferCreateIO(( xmlOutputWriteCallback ) archive_write, NULL, &output, NULL );
+
+	str = g_strdup_printf( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<%s>\n", writer->private->fn_str->root_node );
+	xmlOutputBufferWriteString( out, str );
+	g_free( str );
+
+	first = writer->private->exported;
+
+	archive_write_item( writer, out, first );
+
+	for( it = more ; it && !output.error ; it = it->next ){
+		if( NA_IS_OBJECT_ITEM( it->data )){
+			archive_write_item( writer, out, NA_OBJECT_ITEM( it->data ));
+		}
+	}
+
+	str = g_strdup_printf( "</%s>\n", writer->private->fn_str->root_node );
+	xmlOutputBufferWriteString( out, str );
+	g_free( str );
+
+	xmlOutputBufferClose( out );
+	writer->private->exported = first;
+
+	if( !output.error ){
+		g_output_stream_close( G_OUTPUT_STREAM( stream ), NULL, &output.error );
+	}
+
+	if( output.error ){
+		errmsg = g_strdup_printf( "%s: %s", thisfn, output.error->message );
+		g_warning( "%s", errmsg );
+		if( msg ){
+			*msg = g_slist_append( *msg, errmsg );
+		} else {
+			g_free( errmsg );
+		}
+		g_error_free( output.error );
+		code = NA_IEXPORTER_CODE_UNABLE_TO_WRITE;
+	}
+
+	g_object_unref( stream );
+	g_object_unref( file );
+
+	return( code );
+}
+
+/*
+ * build the document of one item, and only output its list node
+ */
+static void
+archive_write_item( NAXMLWriter *writer, xmlOutputBufferPtr out, NAObjectItem *item )
+{
+	xmlDocPtr doc;
+
+	writer->private->exported = item;
+	writer->private->list_node = NULL;
+	doc = build_xml_doc( writer );
+
+	if( writer->private->list_node ){
+		xmlNodeDumpOutput( out, doc, writer->private->list_node, 1, 1, "UTF-8" );
+		xmlOutputBufferWriteString( out, "\n" );
+	}
+
+	xmlFreeDoc( doc );
+	writer->private->doc = NULL;
+	writer->private->list_node = NULL;
+}
+
+/*
+ * libxml output callback: write the serialized chunk to the GIO stream
+ */
+static int
+archive_write( ArchiveOutput *output, const char *buffer, int len )
+{
+	gsize written;
+
+	if( output->error ){
+		return( -1 );
+	}
+
+	if( !g_output_stream_write_all( output->stream, buffer, len, &written, NULL, &output->error )){
+		return( -1 );
+	}
+
+	return( len );
+}
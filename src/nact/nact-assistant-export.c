@@ -84,6 +84,21 @@ struct _NactAssistantExportPrivate {
 	gchar        *uri;
 	GList        *selected_items;
 	GList        *results;
+
+	/* the export job, run by chunks from an idle callback
+	 */
+	guint         job_source_id;
+	GList        *job_items;
+	GList        *job_next;
+	GList        *job_next_item;
+	gchar        *job_format;
+	gboolean      job_ask;
+	gboolean      job_first;
+	guint         job_done;
+	guint         job_total;
+	GTimer       *job_timer;
+	GtkWidget    *job_progress;
+	GtkWidget    *job_stop;
 };
 
 typedef struct {
@@ -98,6 +113,8 @@ static const gchar        *st_xmlui_filename = PKGUIDIR "/nact-assistant-export.
 static const gchar        *st_toplevel_name  = "ExportAssistant";
 static const gchar        *st_wsp_name       = NA_IPREFS_EXPORT_ASSISTANT_WSP;
 
+static guint               st_export_chunk   = 10;		/* count of items exported per idle loop */
+
 static BaseAssistantClass *st_parent_class   = NULL;
 
 static GType      register_type( void );
@@ -121,7 +138,12 @@ static void       on_folder_chooser_selection_changed( GtkFileChooser *chooser,
 static void       assistant_prepare( BaseAssistant *window, GtkAssistant *assistant, GtkWidget *page );
 static void       assist_prepare_confirm( NactAssistantExport *window, GtkAssistant *assistant, GtkWidget *page );
 static void       assistant_apply( BaseAssistant *window, GtkAssistant *assistant );
+static gboolean   export_on_idle( NactAssistantExport *window );
+static void       export_display_progress( NactAssistantExport *window );
+static void       on_export_stop_clicked( GtkButton *button, NactAssistantExport *window );
+static void       export_cancel( NactAssistantExport *window );
 static void       assist_prepare_exportdone( NactAssistantExport *window, GtkAssistant *assistant, GtkWidget *page );
+static void       export_display_summary( NactAssistantExport *window );
 static void       free_results( GList *list );
 
 GType
@@ -310,6 +332,8 @@ instance_dispose( GObject *window )
 
 		self->private->dispose_has_run = TRUE;
 
+		export_cancel( self );
+
 		g_object_unref( self->private->items_view );
 
 		if( self->private->selected_items ){
@@ -773,61 +797,262 @@ assist_prepare_confirm( NactAssistantExport *window, GtkAssistant *assistant, Gt
  * As of 1.11, nact_gconf_writer doesn't return any error message.
  * An error is simply indicated by returning a null filename.
  * So we provide a general error message.
+ *
+ * The export itself is run by chunks of items from an idle callback, so
+ * that the user interface stays responsive and the progress may be
+ * displayed in the summary page, whatever be the count of items.
  */
 static void
 assistant_apply( BaseAssistant *wnd, GtkAssistant *assistant )
 {
 	static const gchar *thisfn = "nact_assistant_export_on_apply";
 	NactAssistantExport *window;
+	NactAssistantExportPrivate *priv;
 	GList *ia;
 	ExportStruct *str;
-	NactApplication *application;
-	NAUpdater *updater;
-	gboolean first;
 
 	g_return_if_fail( NACT_IS_ASSISTANT_EXPORT( wnd ));
 
 	g_debug( "%s: window=%p, assistant=%p", thisfn, ( void * ) wnd, ( void * ) assistant );
 
 	window = NACT_ASSISTANT_EXPORT( wnd );
+	priv = window->private;
 
-	application = NACT_APPLICATION( base_window_get_application( BASE_WINDOW( window )));
-	updater = nact_application_get_updater( application );
-	first = TRUE;
+	g_return_if_fail( priv->uri && strlen( priv->uri ));
 
-	g_return_if_fail( window->private->uri && strlen( window->private->uri ));
+	export_cancel( window );
 
-	for( ia = window->private->selected_items ; ia ; ia = ia->next ){
-		str = g_new0( ExportStruct, 1 );
-		window->private->results = g_list_append( window->private->results, str );
+	priv->job_format = na_settings_get_string( NA_IPREFS_EXPORT_PREFERRED_FORMAT, NULL, NULL );
+	g_return_if_fail( priv->job_format && strlen( priv->job_format ));
+	priv->job_ask = ( strcmp( priv->job_format, EXPORTER_FORMAT_ASK ) == 0 );
+	priv->job_first = TRUE;
 
+	for( ia = priv->selected_items ; ia ; ia = ia->next ){
+		str = g_new0( ExportStruct, 1 );
 		str->item = NA_OBJECT_ITEM( na_object_get_origin( NA_IDUPLICABLE( ia->data )));
-		str->format = na_settings_get_string( NA_IPREFS_EXPORT_PREFERRED_FORMAT, NULL, NULL );
-		g_return_if_fail( str->format && strlen( str->format ));
+		priv->results = g_list_prepend( priv->results, str );
+		priv->job_items = g_list_prepend( priv->job_items, str->item );
+	}
 
-		if( !strcmp( str->format, EXPORTER_FORMAT_ASK )){
-			g_free( str->format );
-			str->format = nact_export_ask_user( BASE_WINDOW( wnd ), str->item, first );
-			g_return_if_fail( str->format && strlen( str->format ));
+	priv->results = g_list_reverse( priv->results );
+	priv->job_items = g_list_reverse( priv->job_items );
+	priv->job_next = priv->results;
+	priv->job_next_item = priv->job_items;
+	priv->job_done = 0;
+	priv->job_total = g_list_length( priv->results );
+	priv->job_timer = g_timer_new();
+	priv->job_source_id = g_idle_add(( GSourceFunc ) export_on_idle, window );
+}
+
+/*
+ * when the format is not asked for each item, the provider is offered
+ * to export all remaining items in the same file
+ */
+static gboolean
+export_on_idle( NactAssistantExport *window )
+{
+	static const gchar *thisfn = "nact_assistant_export_export_on_idle";
+	NactAssistantExportPrivate *priv;
+	NactApplication *application;
+	NAUpdater *updater;
+	ExportStruct *str, *other;
+	GList *more, *it;
+	guint count;
+
+	priv = window->private;
+	application = NACT_APPLICATION( base_window_get_application( BASE_WINDOW( window )));
+	updater = nact_application_get_updater( application );
+
+	for( count = 0 ; priv->job_next && count < st_export_chunk ; ++count ){
+		str = ( ExportStruct * ) priv->job_next->data;
+
+		if( priv->job_ask ){
+			str->format = nact_export_ask_user( BASE_WINDOW( window ), str->item, priv->job_first );
 
 			if( !str->format || !strcmp( str->format, EXPORTER_FORMAT_NOEXPORT )){
 				str->msg = g_slist_append( NULL, g_strdup( _( "Export canceled due to user action." )));
+
+			} else {
+				str->fname = na_exporter_to_file( NA_PIVOT( updater ), str->item, priv->uri, str->format, &str->msg );
+			}
+
+		} else {
+			str->format = g_strdup( priv->job_format );
+
+			if( strcmp( priv->job_format, EXPORTER_FORMAT_NOEXPORT ) != 0 ){
+				more = priv->job_next_item->next;
+				str->fname = na_exporter_to_file_more( NA_PIVOT( updater ), str->item, &more, priv->uri, str->format, &str->msg );
+
+				/* the provider has written all remaining items in the same file
+				 */
+				if( priv->job_next_item->next && !more ){
+					for( it = priv->job_next->next ; it ; it = it->next ){
+						other = ( ExportStruct * ) it->data;
+						other->format = g_strdup( priv->job_format );
+						other->fname = g_strdup( str->fname );
+						priv->job_done += 1;
+					}
+					priv->job_next = g_list_last( priv->job_next );
+					priv->job_next_item = g_list_last( priv->job_next_item );
+				}
 			}
 		}
 
-		if( strcmp( str->format, EXPORTER_FORMAT_NOEXPORT ) != 0 ){
-			str->fname = na_exporter_to_file( NA_PIVOT( updater ), str->item, window->private->uri, str->format, &str->msg );
+		priv->job_first = FALSE;
+		priv->job_next = priv->job_next->next;
+		priv->job_next_item = priv->job_next_item->next;
+		priv->job_done += 1;
+	}
+
+	export_display_progress( window );
+
+	if( priv->job_next ){
+		return( TRUE );
+	}
+
+	g_debug( "%s: window=%p, %u items exported in %.3lf s",
+			thisfn, ( void * ) window, priv->job_done, g_timer_elapsed( priv->job_timer, NULL ));
+
+	priv->job_source_id = 0;
+	export_cancel( window );
+
+	if( priv->job_progress ){
+		export_display_summary( window );
+	}
+
+	return( FALSE );
+}
+
+/*
+ * display the count of exported items, and the throughput
+ */
+static void
+export_display_progress( NactAssistantExport *window )
+{
+	NactAssistantExportPrivate *priv;
+	gdouble elapsed;
+	gchar *text;
+
+	priv = window->private;
+
+	if( priv->job_progress && priv->job_timer ){
+		elapsed = g_timer_elapsed( priv->job_timer, NULL );
+		/* i18n: progress of the export: count of exported items, total count, items per second */
+		text = g_strdup_printf( _( "Exported items: %u/%u (%.0lf/s)" ),
+				priv->job_done, priv->job_total, elapsed > 0 ? priv->job_done / elapsed : 0 );
+		gtk_progress_bar_set_text( GTK_PROGRESS_BAR( priv->job_progress ), text );
+		gtk_progress_bar_set_fraction( GTK_PROGRESS_BAR( priv->job_progress ),
+				priv->job_total ? ( gdouble ) priv->job_done / priv->job_total : 1.0 );
+		g_free( text );
+	}
+}
+
+/*
+ * the user stops the export: the items which have not been exported yet
+ * are reported as such in the summary
+ */
+static void
+on_export_stop_clicked( GtkButton *button, NactAssistantExport *window )
+{
+	static const gchar *thisfn = "nact_assistant_export_on_export_stop_clicked";
+	ExportStruct *str;
+	GList *it;
+
+	g_debug( "%s: button=%p, window=%p", thisfn, ( void * ) button, ( void * ) window );
+
+	if( window->private->job_source_id ){
+		for( it = window->private->job_next ; it ; it = it->next ){
+			str = ( ExportStruct * ) it->data;
+			str->msg = g_slist_append( str->msg, g_strdup( _( "Export canceled due to user action." )));
 		}
 
-		g_free( str->format );
-		first = FALSE;
+		export_cancel( window );
+		export_display_summary( window );
 	}
 }
 
+/*
+ * stop the export job if it is still running, releasing its resources
+ */
+static void
+export_cancel( NactAssistantExport *window )
+{
+	NactAssistantExportPrivate *priv;
+
+	priv = window->private;
+
+	if( priv->job_source_id ){
+		g_source_remove( priv->job_source_id );
+		priv->job_source_id = 0;
+	}
+
+	priv->job_next = NULL;
+	priv->job_next_item = NULL;
+
+	if( priv->job_items ){
+		g_list_free( priv->job_items );
+		priv->job_items = NULL;
+	}
+
+	g_free( priv->job_format );
+	priv->job_format = NULL;
+
+	if( priv->job_timer ){
+		g_timer_destroy( priv->job_timer );
+		priv->job_timer = NULL;
+	}
+}
+
+/*
+ * the summary page first displays the progress of the export, and is
+ * only completed when the export job is over
+ */
 static void
 assist_prepare_exportdone( NactAssistantExport *window, GtkAssistant *assistant, GtkWidget *page )
 {
 	static const gchar *thisfn = "nact_assistant_export_prepare_exportdone";
+	GtkWidget *vbox, *hbox, *button;
+
+	g_debug( "%s: window=%p, assistant=%p, page=%p",
+			thisfn, ( void * ) window, ( void * ) assistant, ( void * ) page );
+
+	vbox = na_gtk_utils_find_widget_by_name( GTK_CONTAINER( page ), "p5-SummaryVBox" );
+	g_return_if_fail( GTK_IS_BOX( vbox ));
+
+#if GTK_CHECK_VERSION( 3,0,0 )
+	hbox = gtk_box_new( GTK_ORIENTATION_HORIZONTAL, 4 );
+#else
+	hbox = gtk_hbox_new( FALSE, 4 );
+#endif
+	gtk_box_pack_start( GTK_BOX( vbox ), hbox, FALSE, FALSE, 0 );
+
+	window->private->job_progress = gtk_progress_bar_new();
+	gtk_box_pack_start( GTK_BOX( hbox ), window->private->job_progress, TRUE, TRUE, 0 );
+
+	button = gtk_button_new_from_stock( GTK_STOCK_STOP );
+	gtk_box_pack_start( GTK_BOX( hbox ), button, FALSE, FALSE, 0 );
+	window->private->job_stop = button;
+
+	base_window_signal_connect(
+			BASE_WINDOW( window ),
+			G_OBJECT( button ),
+			"clicked",
+			G_CALLBACK( on_export_stop_clicked ));
+
+	export_display_progress( window );
+	gtk_widget_show_all( page );
+
+	if( !window->private->job_source_id ){
+		export_display_summary( window );
+	}
+}
+
+static void
+export_display_summary( NactAssistantExport *window )
+{
+	static const gchar *thisfn = "nact_assistant_export_display_summary";
+	GtkAssistant *assistant;
+	GtkWidget *page;
 	gint errors;
 	guint width;
 	GtkWidget *vbox;
@@ -840,6 +1065,9 @@ assist_prepare_exportdone( NactAssistantExport *window, GtkAssistant *assistant,
 	GList *ir;
 	ExportStruct *str;
 
+	assistant = GTK_ASSISTANT( base_window_get_gtk_toplevel( BASE_WINDOW( window )));
+	page = gtk_assistant_get_nth_page( assistant, ASSIST_PAGE_DONE );
+
 	g_debug( "%s: window=%p, assistant=%p, page=%p",
 			thisfn, ( void * ) window, ( void * ) assistant, ( void * ) page );
 
@@ -848,6 +1076,10 @@ assist_prepare_exportdone( NactAssistantExport *window, GtkAssistant *assistant,
 	vbox = na_gtk_utils_find_widget_by_name( GTK_CONTAINER( page ), "p5-SummaryVBox" );
 	g_return_if_fail( GTK_IS_BOX( vbox ));
 
+	if( window->private->job_stop ){
+		gtk_widget_set_sensitive( window->private->job_stop, FALSE );
+	}
+
 #if !GTK_CHECK_VERSION( 3,0,0 )
 	/* Note that, at least, in Gtk 2.20 (Ubuntu 10) and 2.22 (Fedora 14), GtkLabel
 	 * queues its resize (when the text is being set), but the actual resize does
@@ -942,7 +1174,9 @@ free_results( GList *list )
 	for( ir = list ; ir ; ir = ir->next ){
 		str = ( ExportStruct * ) ir->data;
 		g_free( str->fname );
+		g_free( str->format );
 		na_core_utils_slist_free( str->msg );
+		g_free( str );
 	}
 
 	g_list_free( list );
@@ -93,12 +93,26 @@ struct _NactAssistantImportPrivate {
 	NAIOption   *mode;
 	GList       *results;
 	GList       *overriden;
+
+	/* the import job, run by chunks from an idle callback
+	 */
+	NAImporterParms  job_parms;
+	NAImporterJob   *job;
+	guint            job_source_id;
+	gboolean         job_stopped;
+	guint            job_done;
+	guint            job_total;
+	GTimer          *job_timer;
+	GtkWidget       *job_progress;
+	GtkWidget       *job_stop;
 };
 
 static const gchar        *st_xmlui_filename = PKGUIDIR "/nact-assistant-import.ui";
 static const gchar        *st_toplevel_name  = "ImportAssistant";
 static const gchar        *st_wsp_name       = NA_IPREFS_IMPORT_ASSISTANT_WSP;
 
+static guint               st_import_chunk   = 10;		/* count of files imported per idle loop */
+
 static BaseAssistantClass *st_parent_class   = NULL;
 
 static GType         register_type( void );
@@ -123,8 +137,15 @@ static void          runtime_init_duplicates( NactAssistantImport *window, GtkAs
 static void          assistant_prepare( BaseAssistant *window, GtkAssistant *assistant, GtkWidget *page );
 static void          prepare_confirm( NactAssistantImport *window, GtkAssistant *assistant, GtkWidget *page );
 static void          assistant_apply( BaseAssistant *window, GtkAssistant *assistant );
+static gboolean      import_on_idle( NactAssistantImport *window );
+static void          import_display_progress( NactAssistantImport *window );
+static void          on_import_stop_clicked( GtkButton *button, NactAssistantImport *window );
+static void          import_end( NactAssistantImport *window );
+static void          import_cancel( NactAssistantImport *window );
 static NAObjectItem *check_for_existence( const NAObjectItem *, NactMainWindow *window );
+static GHashTable   *get_existing_index( NactMainWindow *window );
 static void          prepare_importdone( NactAssistantImport *window, GtkAssistant *assistant, GtkWidget *page );
+static void          import_display_summary( NactAssistantImport *window );
 static void          free_results( GList *list );
 
 static GtkWidget    *find_widget_from_page( GtkWidget *page, const gchar *name );
@@ -281,6 +302,8 @@ instance_dispose( GObject *window )
 
 		self->private->dispose_has_run = TRUE;
 
+		import_cancel( self );
+
 		/* chain up to the parent class */
 		if( G_OBJECT_CLASS( st_parent_class )->dispose ){
 			G_OBJECT_CLASS( st_parent_class )->dispose( window );
@@ -645,37 +668,134 @@ prepare_confirm( NactAssistantImport *window, GtkAssistant *assistant, GtkWidget
 
 /*
  * do import here
+ *
+ * the import itself is run by chunks of uris from an idle callback, so
+ * that the user interface stays responsive and the progress may be
+ * displayed in the summary page, whatever be the count of files
  */
 static void
 assistant_apply( BaseAssistant *wnd, GtkAssistant *assistant )
 {
 	static const gchar *thisfn = "nact_assistant_import_assistant_apply";
 	NactAssistantImport *window;
-	NAImporterParms importer_parms;
+	NactAssistantImportPrivate *priv;
 	BaseWindow *main_window;
-	GList *import_results, *it;
-	GList *insertable_items, *overriden_items;
-	NAImporterResult *result;
 	NactApplication *application;
 	NAUpdater *updater;
-	NactTreeView *items_view;
 
 	g_return_if_fail( NACT_IS_ASSISTANT_IMPORT( wnd ));
 
 	g_debug( "%s: window=%p, assistant=%p", thisfn, ( void * ) wnd, ( void * ) assistant );
 	window = NACT_ASSISTANT_IMPORT( wnd );
+	priv = window->private;
 	g_object_get( G_OBJECT( window ), BASE_PROP_PARENT, &main_window, NULL );
 	application = NACT_APPLICATION( base_window_get_application( main_window ));
 	updater = nact_application_get_updater( application );
 
-	memset( &importer_parms, '\0', sizeof( NAImporterParms ));
-	importer_parms.uris = gtk_file_chooser_get_uris( GTK_FILE_CHOOSER( window->private->file_chooser ));
-	importer_parms.check_fn = ( NAImporterCheckFn ) check_for_existence;
-	importer_parms.check_fn_data = main_window;
-	importer_parms.preferred_mode = na_import_mode_get_id( NA_IMPORT_MODE( window->private->mode ));
-	importer_parms.parent_toplevel = base_window_get_gtk_toplevel( BASE_WINDOW( wnd ));
+	import_cancel( window );
+
+	memset( &priv->job_parms, '\0', sizeof( NAImporterParms ));
+	priv->job_parms.uris = gtk_file_chooser_get_uris( GTK_FILE_CHOOSER( priv->file_chooser ));
+	priv->job_parms.check_fn = ( NAImporterCheckFn ) check_for_existence;
+	priv->job_parms.check_fn_data = main_window;
+	priv->job_parms.index_fn = ( NAImporterIndexFn ) get_existing_index;
+	priv->job_parms.preferred_mode = na_import_mode_get_id( NA_IMPORT_MODE( priv->mode ));
+	priv->job_parms.parent_toplevel = base_window_get_gtk_toplevel( BASE_WINDOW( wnd ));
+
+	priv->job = na_importer_job_new( NA_PIVOT( updater ), &priv->job_parms );
+	priv->job_stopped = FALSE;
+	priv->job_timer = g_timer_new();
+	priv->job_source_id = g_idle_add(( GSourceFunc ) import_on_idle, window );
+}
+
+static gboolean
+import_on_idle( NactAssistantImport *window )
+{
+	static const gchar *thisfn = "nact_assistant_import_import_on_idle";
+	NactAssistantImportPrivate *priv;
+
+	priv = window->private;
 
-	import_results = na_importer_import_from_uris( NA_PIVOT( updater ), &importer_parms );
+	if( na_importer_job_step( priv->job, st_import_chunk )){
+		import_display_progress( window );
+		return( TRUE );
+	}
+
+	import_display_progress( window );
+	g_debug( "%s: window=%p, %u files imported in %.3lf s",
+			thisfn, ( void * ) window, g_slist_length( priv->job_parms.uris ), g_timer_elapsed( priv->job_timer, NULL ));
+
+	priv->job_source_id = 0;
+	import_end( window );
+
+	return( FALSE );
+}
+
+/*
+ * display the count of imported files, and the throughput
+ */
+static void
+import_display_progress( NactAssistantImport *window )
+{
+	NactAssistantImportPrivate *priv;
+	guint done, total;
+	gdouble elapsed;
+	gchar *text;
+
+	priv = window->private;
+
+	if( priv->job_progress && priv->job ){
+		na_importer_job_get_progress( priv->job, &done, &total );
+		elapsed = g_timer_elapsed( priv->job_timer, NULL );
+		/* i18n: progress of the import: count of imported files, total count, files per second */
+		text = g_strdup_printf( _( "Imported files: %u/%u (%.0lf/s)" ),
+				done, total, elapsed > 0 ? done / elapsed : 0 );
+		gtk_progress_bar_set_text( GTK_PROGRESS_BAR( priv->job_progress ), text );
+		gtk_progress_bar_set_fraction( GTK_PROGRESS_BAR( priv->job_progress ),
+				total ? ( gdouble ) done / total : 1.0 );
+		g_free( text );
+	}
+}
+
+/*
+ * the user stops the import: the items which have been imported until
+ * now are inserted in the tree view, the remaining files are ignored
+ */
+static void
+on_import_stop_clicked( GtkButton *button, NactAssistantImport *window )
+{
+	static const gchar *thisfn = "nact_assistant_import_on_import_stop_clicked";
+
+	g_debug( "%s: button=%p, window=%p", thisfn, ( void * ) button, ( void * ) window );
+
+	if( window->private->job_source_id ){
+		g_source_remove( window->private->job_source_id );
+		window->private->job_source_id = 0;
+		window->private->job_stopped = TRUE;
+		import_end( window );
+	}
+}
+
+/*
+ * the import job is over (or has been stopped by the user): insert the
+ * imported items in the tree view, and display the summary
+ */
+static void
+import_end( NactAssistantImport *window )
+{
+	NactAssistantImportPrivate *priv;
+	BaseWindow *main_window;
+	GList *import_results, *it;
+	GList *insertable_items, *overriden_items;
+	NAImporterResult *result;
+	NactTreeView *items_view;
+
+	priv = window->private;
+	g_object_get( G_OBJECT( window ), BASE_PROP_PARENT, &main_window, NULL );
+
+	na_importer_job_get_progress( priv->job, &priv->job_done, &priv->job_total );
+	import_results = na_importer_job_free( priv->job );
+	priv->job = NULL;
 
 	insertable_items = NULL;
 	overriden_items = NULL;
@@ -693,8 +813,9 @@ assistant_apply( BaseAssistant *wnd, GtkAssistant *assistant )
 		}
 	}
 
-	na_core_utils_slist_free( importer_parms.uris );
-	window->private->results = import_results;
+	na_core_utils_slist_free( priv->job_parms.uris );
+	priv->job_parms.uris = NULL;
+	priv->results = import_results;
 
 	/* then insert the list
 	 * assuring that actions will be inserted in the same order as uris
@@ -718,6 +839,55 @@ assistant_apply( BaseAssistant *wnd, GtkAssistant *assistant )
 		nact_tree_ieditable_set_items( NACT_TREE_IEDITABLE( items_view ), overriden_items );
 		window->private->overriden = overriden_items;
 	}
+
+	if( priv->job_timer ){
+		g_timer_destroy( priv->job_timer );
+		priv->job_timer = NULL;
+	}
+
+	if( priv->job_progress ){
+		import_display_summary( window );
+	}
+}
+
+/*
+ * the assistant is closed while the import job is still running: the
+ * items which have been already imported are just released
+ */
+static void
+import_cancel( NactAssistantImport *window )
+{
+	NactAssistantImportPrivate *priv;
+	GList *import_results, *it;
+	NAImporterResult *result;
+
+	priv = window->private;
+
+	if( priv->job_source_id ){
+		g_source_remove( priv->job_source_id );
+		priv->job_source_id = 0;
+	}
+
+	if( priv->job ){
+		import_results = na_importer_job_free( priv->job );
+		priv->job = NULL;
+
+		for( it = import_results ; it ; it = it->next ){
+			result = ( NAImporterResult * ) it->data;
+			if( result->imported ){
+				na_object_unref( result->imported );
+			}
+		}
+
+		free_results( import_results );
+		na_core_utils_slist_free( priv->job_parms.uris );
+		priv->job_parms.uris = NULL;
+	}
+
+	if( priv->job_timer ){
+		g_timer_destroy( priv->job_timer );
+		priv->job_timer = NULL;
+	}
 }
 
 static NAObjectItem *
@@ -740,6 +910,64 @@ check_for_existence( const NAObjectItem *item, NactMainWindow *window )
 	return( exists );
 }
 
+/*
+ * index once all the items of the tree, rather than walking it again
+ * for each imported item
+ */
+static GHashTable *
+get_existing_index( NactMainWindow *window )
+{
+	NactTreeView *items_view;
+
+	items_view = nact_main_window_get_items_view( window );
+
+	return( nact_tree_view_get_items_index( items_view ));
+}
+
+/*
+ * the summary page first displays the progress of the import, and is
+ * only completed when the import job is over
+ */
+static void
+prepare_importdone( NactAssistantImport *window, GtkAssistant *assistant, GtkWidget *page )
+{
+	static const gchar *thisfn = "nact_assistant_import_prepare_importdone";
+	GtkWidget *vbox, *hbox, *button;
+
+	g_debug( "%s: window=%p, assistant=%p, page=%p",
+			thisfn, ( void * ) window, ( void * ) assistant, ( void * ) page );
+
+	vbox = find_widget_from_page( page, "p4-SummaryVBox" );
+	g_return_if_fail( GTK_IS_BOX( vbox ));
+
+#if GTK_CHECK_VERSION( 3,0,0 )
+	hbox = gtk_box_new( GTK_ORIENTATION_HORIZONTAL, 4 );
+#else
+	hbox = gtk_hbox_new( FALSE, 4 );
+#endif
+	gtk_box_pack_start( GTK_BOX( vbox ), hbox, FALSE, FALSE, 0 );
+
+	window->private->job_progress = gtk_progress_bar_new();
+	gtk_box_pack_start( GTK_BOX( hbox ), window->private->job_progress, TRUE, TRUE, 0 );
+
+	button = gtk_button_new_from_stock( GTK_STOCK_STOP );
+	gtk_box_pack_start( GTK_BOX( hbox ), button, FALSE, FALSE, 0 );
+	window->private->job_stop = button;
+
+	base_window_signal_connect(
+			BASE_WINDOW( window ),
+			G_OBJECT( button ),
+			"clicked",
+			G_CALLBACK( on_import_stop_clicked ));
+
+	import_display_progress( window );
+	gtk_widget_show_all( page );
+
+	if( !window->private->job_source_id ){
+		import_display_summary( window );
+	}
+}
+
 /*
  * summary page is a vbox inside of a scrolled window
  * each line in this vbox is a GtkLabel
@@ -747,9 +975,11 @@ check_for_existence( const NAObjectItem *item, NactMainWindow *window )
  * in blue.
  */
 static void
-prepare_importdone( NactAssistantImport *window, GtkAssistant *assistant, GtkWidget *page )
+import_display_summary( NactAssistantImport *window )
 {
-	static const gchar *thisfn = "nact_assistant_import_prepare_importdone";
+	static const gchar *thisfn = "nact_assistant_import_display_summary";
+	GtkAssistant *assistant;
+	GtkWidget *page;
 	guint width;
 	GtkWidget *vbox;
 	GtkWidget *file_vbox, *file_uri, *file_report;
@@ -760,6 +990,9 @@ prepare_importdone( NactAssistantImport *window, GtkAssistant *assistant, GtkWid
 	const gchar *color;
 	gchar *mode_id;
 
+	assistant = GTK_ASSISTANT( base_window_get_gtk_toplevel( BASE_WINDOW( window )));
+	page = gtk_assistant_get_nth_page( assistant, ASSIST_PAGE_DONE );
+
 	g_debug( "%s: window=%p, assistant=%p, page=%p",
 			thisfn, ( void * ) window, ( void * ) assistant, ( void * ) page );
 
@@ -767,6 +1000,10 @@ prepare_importdone( NactAssistantImport *window, GtkAssistant *assistant, GtkWid
 	vbox = find_widget_from_page( page, "p4-SummaryVBox" );
 	g_return_if_fail( GTK_IS_BOX( vbox ));
 
+	if( window->private->job_stop ){
+		gtk_widget_set_sensitive( window->private->job_stop, FALSE );
+	}
+
 #if !GTK_CHECK_VERSION( 3,0,0 )
 	/* Note that, at least, in Gtk 2.20 (Ubuntu 10) and 2.22 (Fedora 14), GtkLabel
 	 * queues its resize (when the text is being set), but the actual resize does
@@ -839,6 +1076,19 @@ prepare_importdone( NactAssistantImport *window, GtkAssistant *assistant, GtkWid
 		gtk_box_pack_start( GTK_BOX( file_vbox ), file_report, FALSE, FALSE, 0 );
 	}
 
+	if( window->private->job_stopped ){
+		/* i18n: the import has been stopped by the user before its end */
+		text = g_strdup_printf( _( "Import stopped by the user: %u of %u files have been imported." ),
+				window->private->job_done, window->private->job_total );
+		file_report = gtk_label_new( text );
+		g_free( text );
+		gtk_label_set_line_wrap( GTK_LABEL( file_report ), TRUE );
+		gtk_label_set_line_wrap_mode( GTK_LABEL( file_report ), PANGO_WRAP_WORD );
+		g_object_set( G_OBJECT( file_report ), "xalign", 0, NULL );
+		g_object_set( G_OBJECT( file_report ), "xpad", width, NULL );
+		gtk_box_pack_start( GTK_BOX( vbox ), file_report, FALSE, FALSE, 0 );
+	}
+
 	mode_id = na_ioption_get_id( window->private->mode );
 	na_settings_set_string( NA_IPREFS_IMPORT_PREFERRED_MODE, mode_id );
 	g_free( mode_id );
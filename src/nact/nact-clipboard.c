@@ -34,6 +34,7 @@
 #include <gtk/gtk.h>
 #include <string.h>
 
+#include <api/na-core-utils.h>
 #include <api/na-object-api.h>
 
 #include <core/na-exporter.h>
@@ -113,7 +114,9 @@ static void   get_from_dnd_clipboard_callback( GtkClipboard *clipboard, GtkSelec
 static void   clear_dnd_clipboard_callback( GtkClipboard *clipboard, NactClipboardDndData *data );
 static gchar *export_rows( NactClipboard *clipboard, GList *rows, const gchar *dest_folder );
 static gchar *export_objects( NactClipboard *clipboard, GList *objects );
-static gchar *export_row_object( NactClipboard *clipboard, NAObject *object, const gchar *dest_folder, GList **exported, gboolean first );
+static void   export_collect_items( NAObject *object, GList **items, GHashTable *exported );
+static gchar *export_items( NactClipboard *clipboard, GList *items, const gchar *dest_folder );
+static void   export_items_with_format( NactClipboard *clipboard, GList *items, const gchar *format, const gchar *dest_folder, GString *data, GSList **messages );
 
 static void   get_from_primary_clipboard_callback( GtkClipboard *gtk_clipboard, GtkSelectionData *selection_data, guint info, NactClipboard *clipboard );
 static void   clear_primary_clipboard( NactClipboard *clipboard );
@@ -488,22 +491,20 @@ static gchar *
 export_rows( NactClipboard *clipboard, GList *rows, const gchar *dest_folder )
 {
 	static const gchar *thisfn = "nact_clipboard_export_rows";
-	GString *data;
 	GtkTreeModel *model;
-	GList *exported, *irow;
+	GList *objects, *items, *irow;
+	GHashTable *exported;
 	GtkTreePath *path;
 	GtkTreeIter iter;
 	NAObject *object;
 	gchar *buffer;
-	gboolean first;
 
 	g_debug( "%s: clipboard=%p, rows=%p (count=%d), dest_folder=%s",
 			thisfn, ( void * ) clipboard, ( void * ) rows, g_list_length( rows ), dest_folder );
 
-	first = TRUE;
-	buffer = NULL;
-	exported = NULL;
-	data = g_string_new( "" );
+	objects = NULL;
+	items = NULL;
+	exported = g_hash_table_new( g_direct_hash, g_direct_equal );
 	model = gtk_tree_row_reference_get_model(( GtkTreeRowReference * ) rows->data );
 
 	for( irow = rows ; irow ; irow = irow->next ){
@@ -512,139 +513,193 @@ export_rows( NactClipboard *clipboard, GList *rows, const gchar *dest_folder )
 			gtk_tree_model_get_iter( model, &iter, path );
 			gtk_tree_path_free( path );
 			gtk_tree_model_get( model, &iter, TREE_COLUMN_NAOBJECT, &object, -1 );
-			buffer = export_row_object( clipboard, object, dest_folder, &exported, first );
-			if( buffer && strlen( buffer )){
-				data = g_string_append( data, buffer );
-				g_free( buffer );
-			}
-			g_object_unref( object );
+			export_collect_items( object, &items, exported );
+			objects = g_list_prepend( objects, object );
 		}
-		first = FALSE;
 	}
 
-	g_list_free( exported );
-	return( g_string_free( data, FALSE ));
+	items = g_list_reverse( items );
+	buffer = export_items( clipboard, items, dest_folder );
+
+	g_list_free( items );
+	g_hash_table_destroy( exported );
+	g_list_foreach( objects, ( GFunc ) g_object_unref, NULL );
+	g_list_free( objects );
+
+	return( buffer );
 }
 
 static gchar *
 export_objects( NactClipboard *clipboard, GList *objects )
 {
 	gchar *buffer;
-	GString *data;
-	GList *exported;
+	GList *items;
+	GHashTable *exported;
 	GList *iobj;
-	NAObject *object;
-	gboolean first;
 
-	first = TRUE;
-	buffer = NULL;
-	exported = NULL;
-	data = g_string_new( "" );
+	items = NULL;
+	exported = g_hash_table_new( g_direct_hash, g_direct_equal );
 
 	for( iobj = objects ; iobj ; iobj = iobj->next ){
-		object = NA_OBJECT( iobj->data );
-		buffer = export_row_object( clipboard, object, NULL, &exported, first );
-		if( buffer && strlen( buffer )){
-			data = g_string_append( data, buffer );
-			g_free( buffer );
-		}
-		g_object_unref( object );
-		first = FALSE;
+		export_collect_items( NA_OBJECT( iobj->data ), &items, exported );
 	}
 
-	g_list_free( exported );
-	return( g_string_free( data, FALSE ));
+	items = g_list_reverse( items );
+	buffer = export_items( clipboard, items, NULL );
+
+	g_list_free( items );
+	g_hash_table_destroy( exported );
+	g_list_foreach( objects, ( GFunc ) g_object_unref, NULL );
+
+	return( buffer );
 }
 
 /*
- * export to a buffer if dest_folder is null, and returns this buffer
- * else export to a new file in the target directory (returning an empty string)
+ * collect the NAObjectItem's to be exported, in the order they will be
+ * exported: for a menu, first its subitems, then the menu itself
  *
- * exported maintains a list of exported items, so that the same item is not
- * exported twice
+ * the list is built in reverse order (prepending)
+ *
+ * exported is a set of already collected items, so that the same item
+ * is not exported twice
  */
-static gchar *
-export_row_object( NactClipboard *clipboard, NAObject *object, const gchar *dest_folder, GList **exported, gboolean first )
+static void
+export_collect_items( NAObject *object, GList **items, GHashTable *exported )
 {
-	static const gchar *thisfn = "nact_clipboard_export_row_object";
 	GList *subitems, *isub;
-	NactApplication *application;
-	NAUpdater *updater;
 	NAObjectItem *item;
-	gchar *item_label;
-	gint index;
-	GString *data;
-	gchar *buffer;
-	gchar *format;
-	gchar *fname;
-	GSList *msgs;
-
-	data = g_string_new( "" );
 
-	/* if we have a menu, first export the subitems
-	 */
 	if( NA_IS_OBJECT_MENU( object )){
 		subitems = na_object_get_items( object );
 
 		for( isub = subitems ; isub ; isub = isub->next ){
-			buffer = export_row_object( clipboard, isub->data, dest_folder, exported, first );
-			if( buffer && strlen( buffer )){
-				data = g_string_append( data, buffer );
-				g_free( buffer );
-			}
-			first = FALSE;
+			export_collect_items( NA_OBJECT( isub->data ), items, exported );
 		}
 	}
 
 	/* only export NAObjectItem type
 	 * here, object may be a menu, an action or a profile
 	 */
-	msgs = NULL;
 	item = ( NAObjectItem * ) object;
 	if( NA_IS_OBJECT_PROFILE( object )){
 		item = NA_OBJECT_ITEM( na_object_get_parent( object ));
 	}
 
-	application = NACT_APPLICATION( base_window_get_application( clipboard->private->window ));
-	updater = nact_application_get_updater( application );
+	if( !g_hash_table_lookup( exported, item )){
+		g_hash_table_insert( exported, item, item );
+		*items = g_list_prepend( *items, item );
+	}
+}
 
-	index = g_list_index( *exported, ( gconstpointer ) item );
-	if( index == -1 ){
+/*
+ * export to a buffer if dest_folder is null, and returns this buffer
+ * else export to new files in the target directory (returning an empty string)
+ *
+ * when the preferred export format is not 'Ask', all items are exported
+ * in one batch; else the user is asked for each item, and consecutive
+ * items which share the same format are exported together
+ */
+static gchar *
+export_items( NactClipboard *clipboard, GList *items, const gchar *dest_folder )
+{
+	static const gchar *thisfn = "nact_clipboard_export_items";
+	GString *data;
+	gchar *preferred;
+	gchar *format;
+	GList *batch, *it;
+	gchar *batch_format;
+	GSList *msgs;
+	gboolean first;
 
-		item_label = na_object_get_label( item );
-		g_debug( "%s: exporting %s", thisfn, item_label );
-		g_free( item_label );
+	g_debug( "%s: clipboard=%p, items=%p (count=%d), dest_folder=%s",
+			thisfn, ( void * ) clipboard, ( void * ) items, g_list_length( items ), dest_folder );
 
-		*exported = g_list_prepend( *exported, ( gpointer ) item );
-		format = na_settings_get_string( NA_IPREFS_EXPORT_PREFERRED_FORMAT, NULL, NULL );
-		g_return_val_if_fail( format && strlen( format ), NULL );
+	data = g_string_new( "" );
+	msgs = NULL;
 
-		if( !strcmp( format, EXPORTER_FORMAT_ASK )){
-			g_free( format );
-			format = nact_export_ask_user( clipboard->private->window, item, first );
-			g_return_val_if_fail( format && strlen( format ), NULL );
-		}
+	preferred = na_settings_get_string( NA_IPREFS_EXPORT_PREFERRED_FORMAT, NULL, NULL );
+	g_return_val_if_fail( preferred && strlen( preferred ), g_string_free( data, FALSE ));
+
+	if( strcmp( preferred, EXPORTER_FORMAT_ASK ) != 0 ){
+		export_items_with_format( clipboard, items, preferred, dest_folder, data, &msgs );
 
-		if( strcmp( format, EXPORTER_FORMAT_NOEXPORT ) != 0 ){
-			if( dest_folder ){
-				fname = na_exporter_to_file( NA_PIVOT( updater ), item, dest_folder, format, &msgs );
-				g_free( fname );
+	} else {
+		first = TRUE;
+		batch = NULL;
+		batch_format = NULL;
 
+		for( it = items ; it ; it = it->next ){
+			format = nact_export_ask_user( clipboard->private->window, NA_OBJECT_ITEM( it->data ), first );
+			first = FALSE;
+			if( !format || !strlen( format )){
+				g_free( format );
+				continue;
+			}
+			if( batch_format && strcmp( batch_format, format ) != 0 ){
+				batch = g_list_reverse( batch );
+				export_items_with_format( clipboard, batch, batch_format, dest_folder, data, &msgs );
+				g_list_free( batch );
+				batch = NULL;
+				g_free( batch_format );
+				batch_format = NULL;
+			}
+			if( !batch_format ){
+				batch_format = format;
 			} else {
-				buffer = na_exporter_to_buffer( NA_PIVOT( updater ), item, format, &msgs );
-				if( buffer && strlen( buffer )){
-					data = g_string_append( data, buffer );
-					g_free( buffer );
-				}
+				g_free( format );
 			}
+			batch = g_list_prepend( batch, it->data );
 		}
 
-		g_free( format );
+		if( batch_format ){
+			batch = g_list_reverse( batch );
+			export_items_with_format( clipboard, batch, batch_format, dest_folder, data, &msgs );
+			g_list_free( batch );
+			g_free( batch_format );
+		}
 	}
 
+	g_free( preferred );
+	na_core_utils_slist_free( msgs );
+
 	return( g_string_free( data, FALSE ));
 }
 
+/*
+ * export all items in the given format, with only one exporter lookup,
+ * appending the output buffers to data if dest_folder is null
+ */
+static void
+export_items_with_format( NactClipboard *clipboard, GList *items, const gchar *format, const gchar *dest_folder, GString *data, GSList **messages )
+{
+	NactApplication *application;
+	NAUpdater *updater;
+	GList *results, *ir;
+
+	if( !items || !strcmp( format, EXPORTER_FORMAT_NOEXPORT )){
+		return;
+	}
+
+	application = NACT_APPLICATION( base_window_get_application( clipboard->private->window ));
+	updater = nact_application_get_updater( application );
+
+	if( dest_folder ){
+		results = na_exporter_to_files( NA_PIVOT( updater ), items, dest_folder, format, messages );
+
+	} else {
+		results = na_exporter_to_buffers( NA_PIVOT( updater ), items, format, messages );
+
+		for( ir = results ; ir ; ir = ir->next ){
+			if( ir->data && strlen(( const gchar * ) ir->data )){
+				data = g_string_append( data, ( const gchar * ) ir->data );
+			}
+		}
+	}
+
+	g_list_foreach( results, ( GFunc ) g_free, NULL );
+	g_list_free( results );
+}
+
 /**
  * nact_clipboard_primary_set:
  * @clipboard: this #NactClipboard object.
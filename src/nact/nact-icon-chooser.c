@@ -52,6 +52,12 @@ struct _NactIconChooserPrivate {
 	const gchar  *initial_icon;
 	gchar        *current_icon;
 	GtkWidget    *path_preview;
+
+	/* themed icons are progressively loaded from an idle callback
+	 */
+	guint         load_source_id;
+	GtkListStore *load_store;
+	GtkTreeIter   load_iter;
 };
 
 #define VIEW_ICON_SIZE					GTK_ICON_SIZE_DND
@@ -95,6 +101,27 @@ static const gchar     *st_wsp_name       = NA_IPREFS_ICON_CHOOSER_WSP;
 
 static BaseDialogClass *st_parent_class   = NULL;
 
+/* a process-wide cache of the themed icon pixbufs, so that re-opening
+ * the dialog, or coming back to an already displayed context, does not
+ * load them again
+ * - the hash table is keyed by "icon_name:width", and points to the link
+ *   of the LRU queue (most recently used first)
+ * - the cache is cleared when the icon theme changes
+ */
+typedef struct {
+	gchar     *key;
+	GdkPixbuf *pixbuf;
+}
+	IconCacheEntry;
+
+static GHashTable      *st_icon_cache     = NULL;
+static GQueue           st_icon_lru       = G_QUEUE_INIT;
+static guint            st_icon_cache_max = 2048;
+
+#define THEME_STORE_LOADED				"nact-icon-chooser-store-loaded"
+
+static guint            st_load_chunk     = 32;		/* count of icons loaded per idle loop */
+
 static GType         register_type( void );
 static void          class_init( NactIconChooserClass *klass );
 static void          instance_init( GTypeInstance *instance, gpointer klass );
@@ -126,6 +153,14 @@ static void          on_path_selection_changed( GtkFileChooser *chooser, NactIco
 static void          on_path_update_preview( GtkFileChooser *chooser, NactIconChooser *editor );
 static void          on_path_apply_button_clicked( GtkButton *button, NactIconChooser *editor );
 static GtkListStore *theme_context_load_icons( NactIconChooser *editor, const gchar *context );
+static gint          get_view_icon_width( void );
+static void          load_pixbufs_start( NactIconChooser *editor, GtkListStore *store );
+static gboolean      load_pixbufs_on_idle( NactIconChooser *editor );
+static void          load_pixbufs_cancel( NactIconChooser *editor );
+static GdkPixbuf    *icon_cache_lookup( const gchar *icon_name, gint width );
+static void          icon_cache_add( const gchar *icon_name, gint width, GdkPixbuf *pixbuf );
+static void          icon_cache_entry_free( IconCacheEntry *entry );
+static void          on_icon_theme_changed( GtkIconTheme *icon_theme, void *empty );
 
 GType
 nact_icon_chooser_get_type( void )
@@ -260,6 +295,8 @@ instance_dispose( GObject *dialog )
 
 		self->private->dispose_has_run = TRUE;
 
+		load_pixbufs_cancel( self );
+
 		paned = base_window_get_widget( BASE_WINDOW( self ), "IconPaned" );
 		pos = gtk_paned_get_position( GTK_PANED( paned ));
 		na_settings_set_uint( NA_IPREFS_ICON_CHOOSER_PANED, pos );
@@ -754,6 +791,7 @@ on_themed_context_changed( GtkTreeSelection *selection, NactIconChooser *editor
 
 		GtkIconView *iconview = GTK_ICON_VIEW( base_window_get_widget( BASE_WINDOW( editor ), "ThemedIconView" ));
 		gtk_icon_view_set_model( iconview, GTK_TREE_MODEL( store ));
+		load_pixbufs_start( editor, store );
 
 		if( last_path ){
 			path = gtk_tree_path_new_from_string( last_path );
@@ -897,14 +935,18 @@ on_path_apply_button_clicked( GtkButton *button, NactIconChooser *editor )
 	on_current_icon_changed( editor );
 }
 
+/*
+ * only list the icons of the context: pixbufs are set from the cache if
+ * they have already been loaded, or later from an idle callback
+ */
 static GtkListStore *
 theme_context_load_icons( NactIconChooser *editor, const gchar *context )
 {
 	static const gchar *thisfn = "nact_icon_chooser_theme_context_load_icons";
 	GtkTreeIter iter;
 	GList *ic;
-	GError *error;
-	gint width, height;
+	gint width;
+	GdkPixbuf *pixbuf;
 
 	g_debug( "%s: editor=%p, context=%s", thisfn, ( void * ) editor, context );
 
@@ -913,31 +955,225 @@ theme_context_load_icons( NactIconChooser *editor, const gchar *context )
 
 	GList *icon_list = g_list_sort( gtk_icon_theme_list_icons( icon_theme, context ), ( GCompareFunc ) g_utf8_collate );
 
-	if( !gtk_icon_size_lookup( VIEW_ICON_SIZE, &width, &height )){
-		width = VIEW_ICON_DEFAULT_WIDTH;
-	}
+	width = get_view_icon_width();
 	g_debug( "%s: width=%d", thisfn, width );
 
 	for( ic = icon_list ; ic ; ic = ic->next ){
 		const gchar *icon_name = ( const gchar * ) ic->data;
-		error = NULL;
-		GdkPixbuf *pixbuf = gtk_icon_theme_load_icon(
-				icon_theme, icon_name, width, GTK_ICON_LOOKUP_GENERIC_FALLBACK, &error );
-		if( error ){
-			g_warning( "%s: %s", thisfn, error->message );
-			g_error_free( error );
-		} else {
-			gtk_list_store_append( store, &iter );
-			gtk_list_store_set( store, &iter,
-					THEME_ICON_LABEL_COLUMN, icon_name,
-					THEME_ICON_PIXBUF_COLUMN, pixbuf,
-					-1 );
+		pixbuf = icon_cache_lookup( icon_name, width );
+		gtk_list_store_insert_with_values( store, &iter, -1,
+				THEME_ICON_LABEL_COLUMN, icon_name,
+				THEME_ICON_PIXBUF_COLUMN, pixbuf,
+				-1 );
+		if( pixbuf ){
 			g_object_unref( pixbuf );
 		}
 	}
-	g_debug( "%s: %d loaded icons in store=%p", thisfn, g_list_length( icon_list ), ( void * ) store );
+	g_debug( "%s: %d listed icons in store=%p", thisfn, g_list_length( icon_list ), ( void * ) store );
 	g_list_foreach( icon_list, ( GFunc ) g_free, NULL );
 	g_list_free( icon_list );
 
 	return( store );
 }
+
+static gint
+get_view_icon_width( void )
+{
+	gint width, height;
+
+	if( !gtk_icon_size_lookup( VIEW_ICON_SIZE, &width, &height )){
+		width = VIEW_ICON_DEFAULT_WIDTH;
+	}
+
+	return( width );
+}
+
+/*
+ * start loading the missing pixbufs of the just displayed store,
+ * stopping the load of the previously displayed one (which will be
+ * resumed if the user comes back to it)
+ */
+static void
+load_pixbufs_start( NactIconChooser *editor, GtkListStore *store )
+{
+	load_pixbufs_cancel( editor );
+
+	if( !g_object_get_data( G_OBJECT( store ), THEME_STORE_LOADED ) &&
+		gtk_tree_model_get_iter_first( GTK_TREE_MODEL( store ), &editor->private->load_iter )){
+
+		editor->private->load_store = g_object_ref( store );
+		editor->private->load_source_id = g_idle_add(( GSourceFunc ) load_pixbufs_on_idle, editor );
+	}
+}
+
+/*
+ * rows are loaded in the order of the store, so that the first visible
+ * icons are also the first loaded
+ * icons which cannot be loaded are removed from the store
+ */
+static gboolean
+load_pixbufs_on_idle( NactIconChooser *editor )
+{
+	static const gchar *thisfn = "nact_icon_chooser_load_pixbufs_on_idle";
+	NactIconChooserPrivate *priv;
+	GtkIconTheme *icon_theme;
+	GtkTreeModel *model;
+	gboolean valid;
+	guint count;
+	gint width;
+	gchar *icon_name;
+	GdkPixbuf *pixbuf;
+	GError *error;
+
+	priv = editor->private;
+	model = GTK_TREE_MODEL( priv->load_store );
+
+	/* the store may have been cleared when the dialog is destroyed */
+	valid = ( gtk_tree_model_iter_n_children( model, NULL ) > 0 );
+
+	icon_theme = gtk_icon_theme_get_default();
+	width = get_view_icon_width();
+
+	for( count = 0 ; valid && count < st_load_chunk ; ++count ){
+		gtk_tree_model_get( model, &priv->load_iter,
+				THEME_ICON_LABEL_COLUMN, &icon_name,
+				THEME_ICON_PIXBUF_COLUMN, &pixbuf,
+				-1 );
+
+		if( pixbuf ){
+			g_object_unref( pixbuf );
+			valid = gtk_tree_model_iter_next( model, &priv->load_iter );
+
+		} else {
+			error = NULL;
+			pixbuf = gtk_icon_theme_load_icon(
+					icon_theme, icon_name, width, GTK_ICON_LOOKUP_GENERIC_FALLBACK, &error );
+
+			if( error ){
+				g_warning( "%s: %s", thisfn, error->message );
+				g_error_free( error );
+				valid = gtk_list_store_remove( priv->load_store, &priv->load_iter );
+
+			} else {
+				gtk_list_store_set( priv->load_store, &priv->load_iter, THEME_ICON_PIXBUF_COLUMN, pixbuf, -1 );
+				icon_cache_add( icon_name, width, pixbuf );
+				g_object_unref( pixbuf );
+				valid = gtk_tree_model_iter_next( model, &priv->load_iter );
+			}
+		}
+
+		g_free( icon_name );
+	}
+
+	if( valid ){
+		return( TRUE );
+	}
+
+	g_debug( "%s: store=%p fully loaded", thisfn, ( void * ) priv->load_store );
+	g_object_set_data( G_OBJECT( priv->load_store ), THEME_STORE_LOADED, GINT_TO_POINTER( TRUE ));
+	g_object_unref( priv->load_store );
+	priv->load_store = NULL;
+	priv->load_source_id = 0;
+
+	return( FALSE );
+}
+
+static void
+load_pixbufs_cancel( NactIconChooser *editor )
+{
+	if( editor->private->load_source_id ){
+		g_source_remove( editor->private->load_source_id );
+		editor->private->load_source_id = 0;
+	}
+
+	if( editor->private->load_store ){
+		g_object_unref( editor->private->load_store );
+		editor->private->load_store = NULL;
+	}
+}
+
+/*
+ * Returns: a new reference to the cached pixbuf, or %NULL
+ */
+static GdkPixbuf *
+icon_cache_lookup( const gchar *icon_name, gint width )
+{
+	GdkPixbuf *pixbuf;
+	gchar *key;
+	GList *link;
+
+	pixbuf = NULL;
+
+	if( st_icon_cache ){
+		key = g_strdup_printf( "%s:%d", icon_name, width );
+		link = ( GList * ) g_hash_table_lookup( st_icon_cache, key );
+
+		if( link ){
+			g_queue_unlink( &st_icon_lru, link );
+			g_queue_push_head_link( &st_icon_lru, link );
+			pixbuf = g_object_ref((( IconCacheEntry * ) link->data )->pixbuf );
+		}
+
+		g_free( key );
+	}
+
+	return( pixbuf );
+}
+
+static void
+icon_cache_add( const gchar *icon_name, gint width, GdkPixbuf *pixbuf )
+{
+	IconCacheEntry *entry;
+	GList *link;
+
+	if( !st_icon_cache ){
+		st_icon_cache = g_hash_table_new( g_str_hash, g_str_equal );
+		g_signal_connect( gtk_icon_theme_get_default(), "changed", G_CALLBACK( on_icon_theme_changed ), NULL );
+	}
+
+	entry = g_new0( IconCacheEntry, 1 );
+	entry->key = g_strdup_printf( "%s:%d", icon_name, width );
+
+	if( g_hash_table_lookup( st_icon_cache, entry->key )){
+		g_free( entry->key );
+		g_free( entry );
+		return;
+	}
+
+	entry->pixbuf = g_object_ref( pixbuf );
+	g_queue_push_head( &st_icon_lru, entry );
+	g_hash_table_insert( st_icon_cache, entry->key, st_icon_lru.head );
+
+	/* evict the least recently used entries */
+	while( g_queue_get_length( &st_icon_lru ) > st_icon_cache_max ){
+		link = g_queue_pop_tail_link( &st_icon_lru );
+		entry = ( IconCacheEntry * ) link->data;
+		g_hash_table_remove( st_icon_cache, entry->key );
+		icon_cache_entry_free( entry );
+		g_list_free_1( link );
+	}
+}
+
+static void
+icon_cache_entry_free( IconCacheEntry *entry )
+{
+	g_object_unref( entry->pixbuf );
+	g_free( entry->key );
+	g_free( entry );
+}
+
+static void
+on_icon_theme_changed( GtkIconTheme *icon_theme, void *empty )
+{
+	static const gchar *thisfn = "nact_icon_chooser_on_icon_theme_changed";
+	IconCacheEntry *entry;
+
+	g_debug( "%s: icon_theme=%p, clearing %u cached pixbufs",
+			thisfn, ( void * ) icon_theme, g_queue_get_length( &st_icon_lru ));
+
+	g_hash_table_remove_all( st_icon_cache );
+
+	while(( entry = ( IconCacheEntry * ) g_queue_pop_head( &st_icon_lru )) != NULL ){
+		icon_cache_entry_free( entry );
+	}
+}
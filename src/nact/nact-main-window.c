@@ -125,6 +125,21 @@ struct _NactMainWindowPrivate {
 
 	gulong           pivot_handler_id;
 	NATimeout        pivot_timeout;
+
+	/**
+	 * Progressive load of the items list.
+	 *
+	 * @load_tree is a ref'd copy of the list of items of the #NAPivot,
+	 * so that it stays valid even if the pivot reloads its items in the
+	 * meanwhile; @load_next is the first item not yet appended to the
+	 * tree view.
+	 */
+	guint            load_source_id;
+	gboolean         load_done;
+	GList           *load_tree;
+	GList           *load_next;
+	guint            load_count;
+	guint            load_total;
 };
 
 /* properties set against the main window
@@ -157,6 +172,7 @@ static const gchar     *st_toplevel_name          = "MainWindow";
 static const gchar     *st_wsp_name               = NA_IPREFS_MAIN_WINDOW_WSP;
 
 static gint             st_burst_timeout          = 2500;		/* burst timeout in msec */
+static guint            st_load_chunk             = 50;		/* count of items appended per idle loop */
 static BaseWindowClass *st_parent_class           = NULL;
 static gint             st_signals[ LAST_SIGNAL ] = { 0 };
 
@@ -198,6 +214,8 @@ static void       on_pivot_items_changed( NAUpdater *updater, NactMainWindow *wi
 static gboolean   confirm_for_giveup_from_pivot( const NactMainWindow *window );
 static gboolean   confirm_for_giveup_from_menu( const NactMainWindow *window );
 static void       load_or_reload_items( NactMainWindow *window );
+static gboolean   load_items_on_idle( NactMainWindow *window );
+static void       load_items_cancel( NactMainWindow *window );
 
 /* application termination */
 static gboolean   on_base_quit_requested( NactApplication *application, NactMainWindow *window );
@@ -584,7 +602,6 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	priv->pivot_timeout.timeout = st_burst_timeout;
 	priv->pivot_timeout.handler = ( NATimeoutFunc ) on_block_items_changed_timeout;
 	priv->pivot_timeout.user_data = self;
-	priv->pivot_timeout.source_id = 0;
 }
 
 static void
@@ -763,6 +780,9 @@ instance_dispose( GObject *window )
 
 		self->private->dispose_has_run = TRUE;
 
+		na_timeout_remove( &self->private->pivot_timeout );
+		load_items_cancel( self );
+
 		gtk_main_quit();
 
 		g_object_unref( self->private->clipboard );
@@ -1314,20 +1334,89 @@ confirm_for_giveup_from_menu( const NactMainWindow *window )
 	return( reload_ok );
 }
 
+/*
+ * The items are loaded from an idle callback, so that the main window
+ * be displayed first; they are then appended to the tree view by chunks,
+ * each from its own idle loop, so that the user interface stays
+ * responsive whatever be the count of items.
+ */
 static void
 load_or_reload_items( NactMainWindow *window )
 {
 	static const gchar *thisfn = "nact_main_window_load_or_reload_items";
-	GList *tree;
 
 	g_debug( "%s: window=%p", thisfn, ( void * ) window );
 
+	load_items_cancel( window );
 	raz_selection_properties( window );
 
-	tree = na_updater_load_items( window->private->updater );
-	nact_tree_view_fill( window->private->items_view, tree );
+	nact_tree_view_fill_begin( window->private->items_view );
+	nact_main_statusbar_display_status( window, "load-items-context", _( "Loading items..." ));
+
+	nact_menubar_set_loading( window->private->menubar, TRUE );
+
+	window->private->load_done = FALSE;
+	window->private->load_source_id = g_idle_add(( GSourceFunc ) load_items_on_idle, window );
+}
+
+static gboolean
+load_items_on_idle( NactMainWindow *window )
+{
+	static const gchar *thisfn = "nact_main_window_load_items_on_idle";
+	NactMainWindowPrivate *priv;
+	gchar *msg;
+
+	priv = window->private;
+
+	if( !priv->load_done ){
+		priv->load_tree = na_object_copyref_items( na_updater_load_items( priv->updater ));
+		priv->load_next = priv->load_tree;
+		priv->load_count = 0;
+		priv->load_total = g_list_length( priv->load_tree );
+		priv->load_done = TRUE;
+		g_debug( "%s: window=%p, %u items loaded", thisfn, ( void * ) window, priv->load_total );
 
+	} else {
+		priv->load_next = nact_tree_view_fill_chunk( priv->items_view, priv->load_next, st_load_chunk );
+		priv->load_count = MIN( priv->load_count + st_load_chunk, priv->load_total );
+	}
+
+	if( priv->load_next ){
+		/* i18n: progress of the load of the items list */
+		msg = g_strdup_printf( _( "Loading items: %u/%u" ), priv->load_count, priv->load_total );
+		nact_main_statusbar_display_status( window, "load-items-context", msg );
+		g_free( msg );
+		return( TRUE );
+	}
+
+	priv->load_source_id = 0;
+	nact_main_statusbar_hide_status( window, "load-items-context" );
+	nact_tree_view_fill_end( priv->items_view, priv->load_tree );
+	nact_menubar_set_loading( priv->menubar, FALSE );
+	na_object_free_items( priv->load_tree );
+	priv->load_tree = NULL;
 	g_debug( "%s: end of tree view filling", thisfn );
+
+	return( FALSE );
+}
+
+static void
+load_items_cancel( NactMainWindow *window )
+{
+	if( window->private->load_source_id ){
+		g_source_remove( window->private->load_source_id );
+		window->private->load_source_id = 0;
+
+		if( !window->private->dispose_has_run ){
+			nact_main_statusbar_hide_status( window, "load-items-context" );
+		}
+	}
+
+	if( window->private->load_tree ){
+		na_object_free_items( window->private->load_tree );
+		window->private->load_tree = NULL;
+		window->private->load_next = NULL;
+	}
 }
 
 /**
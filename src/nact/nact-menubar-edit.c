@@ -93,6 +93,7 @@ nact_menubar_edit_on_update_sensitivities( const NactMenubar *bar )
 	nact_menubar_enable_item( bar, "CopyItem", copy_enabled );
 
 	/* paste enabled if
+	 * - the items list is fully loaded
 	 * - clipboard is not empty
 	 * - current selection is not multiple
 	 * - if clipboard contains only profiles,
@@ -105,6 +106,7 @@ nact_menubar_edit_on_update_sensitivities( const NactMenubar *bar )
 	paste_enabled = bar->private->treeview_has_focus || bar->private->popup_handler;
 	paste_enabled &= !is_clipboard_empty;
 	paste_enabled &= bar->private->count_selected <= 1;
+	paste_enabled &= !bar->private->is_loading;
 	if( bar->private->clipboard_profiles ){
 		paste_enabled &= bar->private->count_selected == 1;
 		paste_enabled &= bar->private->is_action_writable;
@@ -131,6 +133,7 @@ nact_menubar_edit_on_update_sensitivities( const NactMenubar *bar )
 	paste_into_enabled = bar->private->treeview_has_focus || bar->private->popup_handler;
 	paste_into_enabled &= !is_clipboard_empty;
 	paste_into_enabled &= bar->private->count_selected <= 1;
+	paste_into_enabled &= !bar->private->is_loading;
 	if( bar->private->clipboard_profiles ){
 		paste_into_enabled &= bar->private->count_selected == 1;
 		if( paste_into_enabled ){
@@ -54,6 +54,7 @@ static gchar *st_save_warning     = N_( "Some items may not have been saved" );
 static gchar *st_level_zero_write = N_( "Unable to rewrite the level-zero items list" );
 static gchar *st_delete_error     = N_( "Some items have not been deleted" );
 
+static GList   *get_modified_items( GList *modified, NAObjectItem *item );
 static gboolean save_item( BaseWindow *window, NAUpdater *updater, NAObjectItem *item, GSList **messages );
 static void     install_autosave( NactMenubar *bar );
 static void     on_autosave_prefs_changed( const gchar *group, const gchar *key, gconstpointer new_value, gpointer user_data );
@@ -89,6 +90,7 @@ nact_menubar_file_on_update_sensitivities( const NactMenubar *bar )
 	 * we must have at least one writable provider
 	 */
 	new_item_enabled = bar->private->is_parent_writable && bar->private->has_writable_providers;
+	new_item_enabled &= !bar->private->is_loading;
 	g_debug( "%s: is_parent_writable=%s, has_writable_providers=%s, new_item_enabled=%s",
 			thisfn,
 			bar->private->is_parent_writable ? "True":"False",
@@ -102,12 +104,12 @@ nact_menubar_file_on_update_sensitivities( const NactMenubar *bar )
 	 * action must be writable
 	 */
 	nact_menubar_enable_item( bar, "NewProfileItem",
-			bar->private->enable_new_profile && bar->private->is_action_writable );
+			bar->private->enable_new_profile && bar->private->is_action_writable && !bar->private->is_loading );
 
 	/* save enabled if at least one item has been modified
 	 * or level-zero has been resorted and is writable
 	 */
-	nact_menubar_enable_item( bar, "SaveItem", ( bar->private->is_tree_modified ));
+	nact_menubar_enable_item( bar, "SaveItem", ( bar->private->is_tree_modified && !bar->private->is_loading ));
 
 	/* quit always enabled */
 }
@@ -271,14 +273,24 @@ nact_menubar_file_save_items( BaseWindow *window )
 	NactTreeView *items_view;
 	GList *items, *it;
 	GList *new_pivot;
-	NAObjectItem *duplicate;
+	GList *modified, *modified_roots, *im;
+	GList *failed, *failed_roots;
+	NAObjectItem *duplicate, *origin, *root;
 	GSList *messages;
-	gchar *msg;
+	gchar *msg, *label;
+	guint count;
 
 	BAR_WINDOW_VOID( window );
 
 	g_debug( "%s: window=%p", thisfn, ( void * ) window );
 
+	/* do not save a partially loaded list (e.g. from autosave)
+	 */
+	if( bar->private->is_loading ){
+		g_debug( "%s: items list is being loaded, nothing saved", thisfn );
+		return;
+	}
+
 	/* always write the level zero list of items as the first save phase
 	 * and reset the corresponding modification flag
 	 */
@@ -324,19 +336,96 @@ nact_menubar_file_save_items( BaseWindow *window )
 		items = nact_tree_view_get_items( items_view );
 	}
 
-	/* recursively save the modified items
-	 * check is useless here if item was not modified, but not very costly;
-	 * above all, it is less costly to check the status here, than to check
-	 * recursively each and every modified item
+	/* first collect the modified items, children before their parent,
+	 * keeping track of the level-zero items which have modified subitems
+	 */
+	modified = NULL;
+	modified_roots = NULL;
+
+	for( it = items ; it ; it = it->next ){
+		im = modified;
+		modified = get_modified_items( modified, NA_OBJECT_ITEM( it->data ));
+		if( modified != im ){
+			modified_roots = g_list_prepend( modified_roots, it->data );
+		}
+	}
+
+	modified = g_list_reverse( modified );
+	g_debug( "%s: %d modified item(s) to be saved", thisfn, g_list_length( modified ));
+
+	/* then write them in one batch
+	 */
+	count = 0;
+	na_updater_write_batch_begin( bar->private->updater );
+
+	for( im = modified ; im ; im = im->next ){
+		if( save_item( window, bar->private->updater, NA_OBJECT_ITEM( im->data ), &messages )){
+			count += 1;
+		}
+	}
+
+	/* a written item may still fail to be committed at the end of the
+	 * batch: it is then not counted as saved, and its level-zero item is
+	 * left modified
+	 */
+	failed_roots = NULL;
+
+	if( na_updater_write_batch_end( bar->private->updater, &failed, &messages ) != NA_IIO_PROVIDER_CODE_OK && !failed ){
+		messages = g_slist_append( messages, g_strdup( _( "Some items could not be committed to the disk." )));
+	}
+
+	for( im = failed ; im ; im = im->next ){
+		label = na_object_get_label( im->data );
+		/* i18n: the item had been written, but the file could not be put in place */
+		messages = g_slist_append( messages, g_strdup_printf( _( "Unable to commit '%s' to the disk." ), label ));
+		g_free( label );
+		count -= MIN( count, 1 );
+
+		root = NA_OBJECT_ITEM( im->data );
+		while( na_object_get_parent( root )){
+			root = na_object_get_parent( root );
+		}
+		if( !g_list_find( failed_roots, root )){
+			failed_roots = g_list_prepend( failed_roots, root );
+		}
+	}
+
+	na_object_free_items( failed );
+	g_list_free( modified );
+
+	/* rebuild the pivot: a level-zero item which has no modified subitem
+	 * is still identical to its origin, which is so just kept, as well as
+	 * the origin of a level-zero item which has not been fully committed
 	 */
 	new_pivot = NULL;
 
 	for( it = items ; it ; it = it->next ){
-		save_item( window, bar->private->updater, NA_OBJECT_ITEM( it->data ), &messages );
-		duplicate = NA_OBJECT_ITEM( na_object_duplicate( it->data, DUPLICATE_REC ));
-		na_object_reset_origin( it->data, duplicate );
-		na_object_check_status( it->data );
-		new_pivot = g_list_prepend( new_pivot, duplicate );
+		origin = ( NAObjectItem * ) na_object_get_origin( it->data );
+
+		if( origin &&
+			!na_object_get_parent( origin ) &&
+			( !g_list_find( modified_roots, it->data ) || g_list_find( failed_roots, it->data ))){
+
+				new_pivot = g_list_prepend( new_pivot, na_object_ref( origin ));
+
+		} else if( g_list_find( failed_roots, it->data )){
+			g_debug( "%s: %p not committed, left modified", thisfn, ( void * ) it->data );
+
+		} else {
+			duplicate = NA_OBJECT_ITEM( na_object_duplicate( it->data, DUPLICATE_REC ));
+			na_object_reset_origin( it->data, duplicate );
+			na_object_check_status( it->data );
+			new_pivot = g_list_prepend( new_pivot, duplicate );
+		}
+	}
+
+	g_list_free( modified_roots );
+
+	if( count ){
+		/* i18n: status bar message once the modified items have been saved */
+		msg = g_strdup_printf( _( "%u modified item(s) saved." ), count );
+		nact_main_statusbar_display_with_timeout( NACT_MAIN_WINDOW( window ), "save-items-context", msg );
+		g_free( msg );
 	}
 
 	if( g_slist_length( messages )){
@@ -350,11 +439,37 @@ nact_menubar_file_save_items( BaseWindow *window )
 	na_pivot_set_new_items( NA_PIVOT( bar->private->updater ), g_list_reverse( new_pivot ));
 	na_object_free_items( items );
 	nact_main_window_block_reload( NACT_MAIN_WINDOW( window ));
-	g_signal_emit_by_name( window, TREE_SIGNAL_MODIFIED_STATUS_CHANGED, FALSE );
+	g_signal_emit_by_name( window, TREE_SIGNAL_MODIFIED_STATUS_CHANGED, failed_roots != NULL );
+	g_list_free( failed_roots );
 }
 
 /*
- * iterates here on each and every NAObjectItem row stored in the tree
+ * iterates here on each and every NAObjectItem row stored in the tree,
+ * prepending the modified ones to the list
+ * as the list is reversed by the caller, children are written before
+ * their parent menu
+ */
+static GList *
+get_modified_items( GList *modified, NAObjectItem *item )
+{
+	GList *subitems, *it;
+
+	if( NA_IS_OBJECT_MENU( item )){
+		subitems = na_object_get_items( item );
+		for( it = subitems ; it ; it = it->next ){
+			modified = get_modified_items( modified, NA_OBJECT_ITEM( it->data ));
+		}
+	}
+
+	if( na_object_is_modified( item )){
+		modified = g_list_prepend( modified, item );
+	}
+
+	return( modified );
+}
+
+/*
+ * writes a modified item
  */
 static gboolean
 save_item( BaseWindow *window, NAUpdater *updater, NAObjectItem *item, GSList **messages )
@@ -363,7 +478,6 @@ save_item( BaseWindow *window, NAUpdater *updater, NAObjectItem *item, GSList **
 	gboolean ret;
 	NAIOProvider *provider_before;
 	NAIOProvider *provider_after;
-	GList *subitems, *it;
 	gchar *label;
 	guint save_ret;
 
@@ -373,13 +487,6 @@ save_item( BaseWindow *window, NAUpdater *updater, NAObjectItem *item, GSList **
 
 	ret = TRUE;
 
-	if( NA_IS_OBJECT_MENU( item )){
-		subitems = na_object_get_items( item );
-		for( it = subitems ; it ; it = it->next ){
-			ret &= save_item( window, updater, NA_OBJECT_ITEM( it->data ), messages );
-		}
-	}
-
 	provider_before = na_object_get_provider( item );
 
 	if( na_object_is_modified( item )){
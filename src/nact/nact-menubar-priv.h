@@ -80,6 +80,10 @@ struct _NactMenubarPrivate {
 	 */
 	gboolean         is_tree_modified;
 
+	/* set while the items list is progressively loaded in the tree view
+	 */
+	gboolean         is_loading;
+
 	/* set on focus in/out
 	 */
 	gboolean         treeview_has_focus;
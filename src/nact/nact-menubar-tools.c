@@ -44,8 +44,10 @@
 void
 nact_menubar_tools_on_update_sensitivities( const NactMenubar *bar )
 {
-	/* import item enabled if at least one writable provider */
-	nact_menubar_enable_item( bar, "ImportItem", bar->private->has_writable_providers );
+	/* import item enabled if at least one writable provider
+	 * and the items list is fully loaded
+	 */
+	nact_menubar_enable_item( bar, "ImportItem", bar->private->has_writable_providers && !bar->private->is_loading );
 
 	/* export item enabled if IActionsList store contains actions */
 	nact_menubar_enable_item( bar, "ExportItem", bar->private->have_exportables );
@@ -940,3 +940,24 @@ nact_menubar_save_items( BaseWindow *window )
 {
 	nact_menubar_file_save_items( window );
 }
+
+/**
+ * nact_menubar_set_loading:
+ * @bar: this #NactMenubar instance.
+ * @loading: whether the items list is being loaded.
+ *
+ * The items list is appended to the tree view by chunks; until the last
+ * chunk be in, the items which would modify the list (new, paste, import,
+ * save) are disabled.
+ */
+void
+nact_menubar_set_loading( NactMenubar *bar, gboolean loading )
+{
+	g_return_if_fail( NACT_IS_MENUBAR( bar ));
+
+	if( !bar->private->dispose_has_run ){
+
+		bar->private->is_loading = loading;
+		g_signal_emit_by_name( bar, MENUBAR_SIGNAL_UPDATE_SENSITIVITIES );
+	}
+}
@@ -93,6 +93,8 @@ NactMenubar *nact_menubar_new       ( BaseWindow *window );
 
 void         nact_menubar_save_items( BaseWindow *window );
 
+void         nact_menubar_set_loading( NactMenubar *bar, gboolean loading );
+
 G_END_DECLS
 
 #endif /* __NACT_MENUBAR_H__ */
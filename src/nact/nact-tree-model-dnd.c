@@ -129,6 +129,7 @@ static gboolean      is_drop_possible_into_dest( NactTreeModel *model, GtkTreePa
 static void          drop_inside_move_dest( NactTreeModel *model, GList *rows, GtkTreePath **dest );
 static gboolean      drop_uri_list( NactTreeModel *model, GtkTreePath *dest, GtkSelectionData  *selection_data );
 static NAObjectItem *is_dropped_already_exists( const NAObjectItem *importing, const NactMainWindow *window );
+static GHashTable   *get_dropped_index( const NactMainWindow *window );
 static char         *get_xds_atom_value( GdkDragContext *context );
 static gboolean      is_parent_accept_new_children( NactApplication *application, NactMainWindow *window, NAObjectItem *parent );
 static guint         target_atom_to_id( GdkAtom atom );
@@ -892,6 +893,7 @@ drop_uri_list( NactTreeModel *model, GtkTreePath *dest, GtkSelectionData  *selec
 	parms.uris = g_slist_reverse( na_core_utils_slist_from_split( selection_data_data, "\r\n" ));
 	parms.check_fn = ( NAImporterCheckFn ) is_dropped_already_exists;
 	parms.check_fn_data = main_window;
+	parms.index_fn = ( NAImporterIndexFn ) get_dropped_index;
 	parms.preferred_mode = 0;
 	parms.parent_toplevel = base_window_get_gtk_toplevel( BASE_WINDOW( main_window ));
 
@@ -988,6 +990,16 @@ is_dropped_already_exists( const NAObjectItem *importing, const NactMainWindow *
 	return( exists );
 }
 
+static GHashTable *
+get_dropped_index( const NactMainWindow *window )
+{
+	NactTreeView *items_view;
+
+	items_view = nact_main_window_get_items_view( window );
+
+	return( nact_tree_view_get_items_index( items_view ));
+}
+
 /*
  * this function works well, but only called from on_drag_motion handler...
  */
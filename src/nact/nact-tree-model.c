@@ -70,16 +70,6 @@ enum {
  */
 typedef gboolean ( *FnIterOnStore )( const NactTreeModel *, GtkTreeStore *, GtkTreePath *, NAObject *, gpointer );
 
-/* getting the list of items
- * - mode is the indicator of the wished content
- * - list is the returned list
- */
-typedef struct {
-	guint  mode;
-	GList *items;
-}
-	ntmGetItems;
-
 /* when iterating while searching for an object by id
  * setting the iter if found
  */
@@ -130,6 +120,7 @@ static void     instance_finalize( GObject *model );
 
 static void     on_settings_order_mode_changed( const gchar *group, const gchar *key, gconstpointer new_value, gboolean mandatory, NactTreeModel *model );
 static void     on_tab_updatable_item_updated( BaseWindow *window, NAIContext *context, guint data, NactTreeModel *model );
+static gboolean on_test_expand_row( GtkTreeView *treeview, GtkTreeIter *iter, GtkTreePath *path, NactTreeModel *model );
 
 static void     append_item( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent, GtkTreeIter *iter, const NAObject *object );
 static void     display_item( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *iter, const NAObject *object );
@@ -139,10 +130,11 @@ static void     dump( NactTreeModel *model );
 static gboolean dump_store( NactTreeModel *model, GtkTreePath *path, NAObject *object, ntmDumpStruct *ntm );
 #endif
 static void     fill_tree_store( GtkTreeStore *model, GtkTreeView *treeview, NAObject *object, GtkTreeIter *parent );
+static void     fill_children( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *iter, const NAObject *object );
+static void     fill_subtree( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent );
 static gboolean filter_visible( GtkTreeModel *store, GtkTreeIter *iter, NactTreeModel *model );
 static gboolean find_item_iter( NactTreeModel *model, GtkTreeStore *store, GtkTreePath *path, NAObject *object, ntmFindId *nfo );
 static gboolean find_object_iter( NactTreeModel *model, GtkTreeStore *store, GtkTreePath *path, NAObject *object, ntmFindObject *nfo );
-static gboolean get_items_iter( const NactTreeModel *model, GtkTreeStore *store, GtkTreePath *path, NAObject *object, ntmGetItems *ngi );
 static void     iter_on_store( const NactTreeModel *model, GtkTreeModel *store, GtkTreeIter *parent, FnIterOnStore fn, gpointer user_data );
 static gboolean iter_on_store_item( const NactTreeModel *model, GtkTreeModel *store, GtkTreeIter *iter, FnIterOnStore fn, gpointer user_data );
 static void     remove_if_exists( NactTreeModel *model, GtkTreeModel *store, const NAObject *object );
@@ -377,6 +369,16 @@ instance_constructed( GObject *model )
 
 		priv->clipboard = nact_clipboard_new( priv->window );
 
+		/* children rows are only appended to the store when their parent
+		 * is about to be expanded
+		 */
+		base_window_signal_connect_with_data(
+				priv->window,
+				G_OBJECT( priv->treeview ),
+				"test-expand-row",
+				G_CALLBACK( on_test_expand_row ),
+				model );
+
 		if( priv->mode == TREE_MODE_EDITION ){
 
 			egg_tree_multi_drag_add_drag_support(
@@ -505,7 +507,7 @@ nact_tree_model_new( BaseWindow *window, GtkTreeView *treeview, NactTreeMode mod
 	g_debug( "%s: window=%p, treeview=%p, mode=%u", thisfn, ( void * ) window, ( void * ) treeview, mode );
 
 	ts_model = gtk_tree_store_new(
-			TREE_N_COLUMN, GDK_TYPE_PIXBUF, G_TYPE_STRING, NA_TYPE_OBJECT );
+			TREE_N_COLUMN, GDK_TYPE_PIXBUF, G_TYPE_STRING, NA_TYPE_OBJECT, G_TYPE_BOOLEAN );
 
 	/* create the filter model
 	 */
@@ -587,6 +589,28 @@ on_tab_updatable_item_updated( BaseWindow *window, NAIContext *context, guint da
 	}
 }
 
+/*
+ * the row is about to be expanded: make sure that all its descendants
+ * are present in the store, so that GtkTreeView is able to display them
+ * (and to recursively expand them on expand_all)
+ */
+static gboolean
+on_test_expand_row( GtkTreeView *treeview, GtkTreeIter *iter, GtkTreePath *path, NactTreeModel *model )
+{
+	GtkTreeStore *store;
+	GtkTreeIter store_iter;
+
+	if( !model->private->dispose_has_run ){
+
+		store = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
+		gtk_tree_model_filter_convert_iter_to_child_iter( GTK_TREE_MODEL_FILTER( model ), &store_iter, iter );
+		fill_subtree( store, model->private->treeview, &store_iter );
+	}
+
+	/* allow the row to be expanded */
+	return( FALSE );
+}
+
 /**
  * nact_tree_model_delete:
  * @model: this #NactTreeModel instance.
@@ -649,14 +673,17 @@ nact_tree_model_delete( NactTreeModel *model, NAObject *object )
  * We enter with the GSList owned by NAPivot which contains the ordered
  * list of level-zero items. We want have a duplicate of this list in
  * tree store, so that we are able to freely edit it.
+ *
+ * Only the level-zero items and their direct children are appended to
+ * the store here; deeper rows are materialized when their parent is
+ * expanded, or when the store is searched for an item. The cost of
+ * this initial fill-up so does not depend of the depth of the tree.
  */
 void
 nact_tree_model_fill( NactTreeModel *model, GList *items )
 {
 	static const gchar *thisfn = "nact_tree_model_fill";
 	GtkTreeStore *ts_model;
-	GList *it;
-	NAObject *duplicate;
 
 	g_return_if_fail( NACT_IS_TREE_MODEL( model ));
 
@@ -668,13 +695,51 @@ nact_tree_model_fill( NactTreeModel *model, GList *items )
 		ts_model = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
 		gtk_tree_store_clear( ts_model );
 
-		for( it = items ; it ; it = it->next ){
+		nact_tree_model_fill_chunk( model, items, G_MAXUINT );
+	}
+}
+
+/**
+ * nact_tree_model_fill_chunk:
+ * @model: this #NactTreeModel instance.
+ * @items: the first item of the chunk, as a link of the list of
+ *  level-zero items.
+ * @count: the maximum count of items to be appended.
+ *
+ * Appends at most @count items, starting with @items, at the end of the
+ * tree store.
+ *
+ * This let the caller progressively fill up the store, e.g. from idle
+ * callbacks, after having cleared it with nact_tree_model_fill( model, NULL ).
+ *
+ * Returns: the first link of the list which has not been appended, or
+ * %NULL if the end of the list has been reached.
+ */
+GList *
+nact_tree_model_fill_chunk( NactTreeModel *model, GList *items, guint count )
+{
+	GtkTreeStore *ts_model;
+	GList *it;
+	guint i;
+	NAObject *duplicate;
+
+	g_return_val_if_fail( NACT_IS_TREE_MODEL( model ), NULL );
+
+	it = NULL;
+
+	if( !model->private->dispose_has_run ){
+
+		ts_model = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
+
+		for( it = items, i = 0 ; it && i < count ; it = it->next, ++i ){
 			duplicate = ( NAObject * ) na_object_duplicate( it->data, DUPLICATE_REC );
 			na_object_check_status( duplicate );
 			fill_tree_store( ts_model, model->private->treeview, duplicate, NULL );
 			na_object_unref( duplicate );
 		}
 	}
+
+	return( it );
 }
 
 /**
@@ -749,6 +814,11 @@ nact_tree_model_insert_before( NactTreeModel *model, const NAObject *object, Gtk
 			gtk_tree_model_get( store, &parent_iter, TREE_COLUMN_NAOBJECT, &parent_obj, -1 );
 			g_object_unref( parent_obj );
 
+			/* the rows of the current children must be present before
+			 * the object be added to the children of its parent
+			 */
+			fill_children( GTK_TREE_STORE( store ), model->private->treeview, &parent_iter, parent_obj );
+
 			if( has_sibling ){
 				na_object_insert_item( parent_obj, object, sibling_obj );
 			} else {
@@ -763,7 +833,9 @@ nact_tree_model_insert_before( NactTreeModel *model, const NAObject *object, Gtk
 				GTK_TREE_STORE( store ), &iter,
 				has_parent ? &parent_iter : NULL,
 				has_sibling ? &sibling_iter : NULL );
-		gtk_tree_store_set( GTK_TREE_STORE( store ), &iter, TREE_COLUMN_NAOBJECT, object, -1 );
+		/* the children rows of the object are inserted by the caller
+		 */
+		gtk_tree_store_set( GTK_TREE_STORE( store ), &iter, TREE_COLUMN_NAOBJECT, object, TREE_COLUMN_FILLED, TRUE, -1 );
 		display_item( GTK_TREE_STORE( store ), model->private->treeview, &iter, object );
 
 		inserted_path = gtk_tree_model_get_path( store, &iter );
@@ -824,11 +896,12 @@ nact_tree_model_insert_into( NactTreeModel *model, const NAObject *object, GtkTr
 
 		gtk_tree_model_get( store, &parent_iter, TREE_COLUMN_NAOBJECT, &parent, -1 );
 		g_object_unref( parent );
+		fill_children( GTK_TREE_STORE( store ), model->private->treeview, &parent_iter, parent );
 		na_object_insert_item( parent, object, NULL );
 		na_object_set_parent( object, parent );
 
 		gtk_tree_store_insert_after( GTK_TREE_STORE( store ), &iter, &parent_iter, NULL );
-		gtk_tree_store_set( GTK_TREE_STORE( store ), &iter, TREE_COLUMN_NAOBJECT, object, -1 );
+		gtk_tree_store_set( GTK_TREE_STORE( store ), &iter, TREE_COLUMN_NAOBJECT, object, TREE_COLUMN_FILLED, TRUE, -1 );
 		display_item( GTK_TREE_STORE( store ), model->private->treeview, &iter, object );
 
 		new_path = gtk_tree_model_get_path( store, &iter );
@@ -886,8 +959,10 @@ nact_tree_model_get_items( const NactTreeModel *model, guint mode )
 {
 	static const gchar *thisfn = "nact_tree_model_get_items";
 	GList *items;
-	GtkTreeStore *store;
-	ntmGetItems ngi;
+	GtkTreeModel *store;
+	GtkTreeIter iter;
+	gboolean ok;
+	NAObject *object;
 
 	g_return_val_if_fail( NACT_IS_TREE_MODEL( model ), NULL );
 
@@ -896,11 +971,22 @@ nact_tree_model_get_items( const NactTreeModel *model, guint mode )
 	if( !model->private->dispose_has_run ){
 		g_debug( "%s: model=%p, mode=0x%xh", thisfn, ( void * ) model, mode );
 
-		ngi.mode = mode;
-		ngi.items = NULL;
-		store = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
-		iter_on_store( model, GTK_TREE_MODEL( store ), NULL, ( FnIterOnStore ) get_items_iter, &ngi );
-		items = g_list_reverse( ngi.items );
+		/* only level-zero items are returned, so there is no need to
+		 * walk (and materialize) the whole store
+		 */
+		if( mode & TREE_LIST_ALL ){
+			store = gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model ));
+			ok = gtk_tree_model_get_iter_first( store, &iter );
+
+			while( ok ){
+				gtk_tree_model_get( store, &iter, TREE_COLUMN_NAOBJECT, &object, -1 );
+				items = g_list_prepend( items, na_object_ref( object ));
+				g_object_unref( object );
+				ok = gtk_tree_model_iter_next( store, &iter );
+			}
+
+			items = g_list_reverse( items );
+		}
 	}
 
 	return( items );
@@ -978,12 +1064,35 @@ nact_tree_model_object_to_path( const NactTreeModel *model, const NAObject *obje
 static void
 append_item( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent, GtkTreeIter *iter, const NAObject *object )
 {
+	gchar *label;
+	gchar *icon_name;
+	GdkPixbuf *icon;
+
 	/*g_debug( "nact_tree_model_append_item: object=%p (ref_count=%d), parent=%p",
 					( void * ) object, G_OBJECT( object )->ref_count, ( void * ) parent );*/
 
-	gtk_tree_store_append( model, iter, parent );
-	gtk_tree_store_set( model, iter, TREE_COLUMN_NAOBJECT, object, -1 );
-	display_item( model, treeview, iter, object );
+	label = na_object_get_label( object );
+	icon = NULL;
+
+	if( NA_IS_OBJECT_ITEM( object )){
+		icon_name = na_object_get_icon( object );
+		icon = base_gtk_utils_get_pixbuf( icon_name, GTK_WIDGET( treeview ), GTK_ICON_SIZE_MENU );
+		g_free( icon_name );
+	}
+
+	/* setting all columns at once, so that the row is inserted and
+	 * filtered only once
+	 */
+	gtk_tree_store_insert_with_values( model, iter, parent, -1,
+			TREE_COLUMN_ICON, icon,
+			TREE_COLUMN_LABEL, label,
+			TREE_COLUMN_NAOBJECT, object,
+			-1 );
+
+	if( icon ){
+		g_object_unref( icon );
+	}
+	g_free( label );
 }
 
 static void
@@ -1103,35 +1212,88 @@ static void
 fill_tree_store( GtkTreeStore *model, GtkTreeView *treeview, NAObject *object, GtkTreeIter *parent )
 {
 	static const gchar *thisfn = "nact_tree_model_fill_tree_store";
-	GList *subitems, *it;
 	GtkTreeIter iter;
 
 	g_debug( "%s entering: object=%p (%s, ref_count=%d)", thisfn,
 			( void * ) object, G_OBJECT_TYPE_NAME( object ), G_OBJECT( object )->ref_count );
 
-	/* an action or a menu
+	append_item( model, treeview, parent, &iter, object );
+
+	/* an action or a menu: its direct children must be present so that
+	 * the expander is displayed (resp. the profiles are available)
 	 */
 	if( NA_IS_OBJECT_ITEM( object )){
-		append_item( model, treeview, parent, &iter, object );
-		subitems = na_object_get_items( object );
-		for( it = subitems ; it ; it = it->next ){
-			fill_tree_store( model, treeview, it->data, &iter );
-		}
+		fill_children( model, treeview, &iter, object );
 
 	} else {
 		g_return_if_fail( NA_IS_OBJECT_PROFILE( object ));
-		append_item( model, treeview, parent, &iter, object );
 	}
 
 	/*g_debug( "%s quitting: object=%p (%s, ref_count=%d)", thisfn,
 			( void * ) object, G_OBJECT_TYPE_NAME( object ), G_OBJECT( object )->ref_count );*/
 }
 
+/*
+ * append the rows of the children of the object at @iter, unless they
+ * are already present in the store
+ *
+ * the rows are appended all at once, and the row at @iter is then marked
+ * as filled; rows inserted while editing are marked as filled as soon as
+ * they are inserted, as their children rows are inserted by the caller,
+ * and the children rows of a parent are appended before a new row be
+ * inserted into it
+ */
+static void
+fill_children( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *iter, const NAObject *object )
+{
+	GList *subitems, *it;
+	GtkTreeIter child;
+	gboolean filled;
+
+	if( NA_IS_OBJECT_ITEM( object )){
+		gtk_tree_model_get( GTK_TREE_MODEL( model ), iter, TREE_COLUMN_FILLED, &filled, -1 );
+
+		if( !filled ){
+			subitems = na_object_get_items( object );
+			for( it = subitems ; it ; it = it->next ){
+				append_item( model, treeview, iter, &child, it->data );
+			}
+
+			gtk_tree_store_set( model, iter, TREE_COLUMN_FILLED, TRUE, -1 );
+		}
+	}
+}
+
+/*
+ * recursively materialize all the descendants of the row at @parent
+ */
+static void
+fill_subtree( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent )
+{
+	GtkTreeIter iter;
+	gboolean ok;
+	NAObject *object;
+
+	ok = gtk_tree_model_iter_children( GTK_TREE_MODEL( model ), &iter, parent );
+
+	while( ok ){
+		gtk_tree_model_get( GTK_TREE_MODEL( model ), &iter, TREE_COLUMN_NAOBJECT, &object, -1 );
+		fill_children( model, treeview, &iter, object );
+		g_object_unref( object );
+
+		fill_subtree( model, treeview, &iter );
+		ok = gtk_tree_model_iter_next( GTK_TREE_MODEL( model ), &iter );
+	}
+}
+
 /*
  * Only display profiles when we are in edition mode.
  *
- * This function is called as soon as a new row is created in the tree store,
- * so is called the first time _before_ the NAObject be set on the row.
+ * This function is called as soon as a new row is created in the tree store.
+ * When inserted via nact_tree_model_insert_before() or
+ * nact_tree_model_insert_into(), it is so called the first time _before_ the
+ * NAObject be set on the row; rows appended when filling up the store are
+ * inserted with all their columns already set.
  */
 static gboolean
 filter_visible( GtkTreeModel *store, GtkTreeIter *iter, NactTreeModel *model )
@@ -1206,25 +1368,6 @@ find_object_iter( NactTreeModel *model, GtkTreeStore *store, GtkTreePath *path,
 	return( nfo->path != NULL );
 }
 
-/*
- * Builds the tree by iterating on the store
- * we may want selected, modified or both, or a combination of these modes
- *
- * This function is called from iter_on_store_item();
- */
-static gboolean
-get_items_iter( const NactTreeModel *model, GtkTreeStore *store, GtkTreePath *path, NAObject *object, ntmGetItems *ngi )
-{
-	if( ngi->mode & TREE_LIST_ALL ){
-		if( gtk_tree_path_get_depth( path ) == 1 ){
-			ngi->items = g_list_prepend( ngi->items, na_object_ref( object ));
-		}
-	}
-
-	/* don't stop iteration */
-	return( FALSE );
-}
-
 static void
 iter_on_store( const NactTreeModel *model, GtkTreeModel *store, GtkTreeIter *parent, FnIterOnStore fn, gpointer user_data )
 {
@@ -1262,7 +1405,10 @@ iter_on_store_item( const NactTreeModel *model, GtkTreeModel *store, GtkTreeIter
 	stop = ( *fn )( model, GTK_TREE_STORE( store ), path, object, user_data );
 	gtk_tree_path_free( path );
 
+	/* children rows may not have been materialized yet
+	 */
 	if( !stop ){
+		fill_children( GTK_TREE_STORE( store ), model->private->treeview, iter, object );
 		iter_on_store( model, store, iter, fn, user_data );
 	}
 
@@ -82,6 +82,7 @@ enum {
 	TREE_COLUMN_ICON = 0,
 	TREE_COLUMN_LABEL,
 	TREE_COLUMN_NAOBJECT,
+	TREE_COLUMN_FILLED,					/* whether the children rows have been appended */
 	TREE_N_COLUMN
 };
 
@@ -91,6 +92,7 @@ NactTreeModel *nact_tree_model_new( BaseWindow *window, GtkTreeView *view, NactT
 
 GtkTreePath   *nact_tree_model_delete       ( NactTreeModel *model, NAObject *object );
 void           nact_tree_model_fill         ( NactTreeModel *model, GList *items );
+GList         *nact_tree_model_fill_chunk   ( NactTreeModel *model, GList *items, guint count );
 GtkTreePath   *nact_tree_model_insert_before( NactTreeModel *model, const NAObject *object, GtkTreePath *path );
 GtkTreePath   *nact_tree_model_insert_into  ( NactTreeModel *model, const NAObject *object, GtkTreePath *path );
 
@@ -146,6 +146,9 @@ static void       select_row_at_path_by_string( NactTreeView *view, const gchar
 static void       toggle_collapse( NactTreeView *view );
 static gboolean   toggle_collapse_iter( NactTreeView *view, GtkTreeModel *model, GtkTreeIter *iter, NAObject *object, gpointer user_data );
 static void       toggle_collapse_row( GtkTreeView *treeview, GtkTreePath *path, guint *toggle );
+static void       index_items( GHashTable *index, GList *items );
+static guint      index_id_hash( const gchar *id );
+static gboolean   index_id_equal( const gchar *a, const gchar *b );
 
 GType
 nact_tree_view_get_type( void )
@@ -891,8 +894,6 @@ void
 nact_tree_view_fill( NactTreeView *view, GList *items )
 {
 	static const gchar *thisfn = "nact_tree_view_fill";
-	NactTreeModel *model;
-	gint nb_menus, nb_actions, nb_profiles;
 
 	g_return_if_fail( NACT_IS_TREE_VIEW( view ));
 
@@ -900,13 +901,92 @@ nact_tree_view_fill( NactTreeView *view, GList *items )
 		g_debug( "%s: view=%p, items=%p (count=%u)",
 				thisfn, ( void * ) view, ( void * ) items, g_list_length( items ));
 
+		nact_tree_view_fill_begin( view );
+		nact_tree_view_fill_chunk( view, items, G_MAXUINT );
+		nact_tree_view_fill_end( view, items );
+	}
+}
+
+/**
+ * nact_tree_view_fill_begin:
+ * @view: this #NactTreeView instance.
+ *
+ * Clears the tree view before a progressive fillup.
+ *
+ * The tree view is made insensitive until nact_tree_view_fill_end() be
+ * called, so that the user cannot edit a partially loaded list.
+ */
+void
+nact_tree_view_fill_begin( NactTreeView *view )
+{
+	static const gchar *thisfn = "nact_tree_view_fill_begin";
+	NactTreeModel *model;
+
+	g_return_if_fail( NACT_IS_TREE_VIEW( view ));
+
+	if( !view->private->dispose_has_run ){
+		g_debug( "%s: view=%p", thisfn, ( void * ) view );
+
 		clear_selection( view );
 		view->private->notify_allowed = FALSE;
+		gtk_widget_set_sensitive( GTK_WIDGET( view->private->tree_view ), FALSE );
+
+		model = NACT_TREE_MODEL( gtk_tree_view_get_model( view->private->tree_view ));
+		nact_tree_model_fill( model, NULL );
+	}
+}
+
+/**
+ * nact_tree_view_fill_chunk:
+ * @view: this #NactTreeView instance.
+ * @items: the first item of the chunk, as a link of the list of
+ *  level-zero items.
+ * @count: the maximum count of items to be appended.
+ *
+ * Returns: the first link of the list which has not been appended, or
+ * %NULL if the end of the list has been reached.
+ */
+GList *
+nact_tree_view_fill_chunk( NactTreeView *view, GList *items, guint count )
+{
+	NactTreeModel *model;
+	GList *next;
+
+	g_return_val_if_fail( NACT_IS_TREE_VIEW( view ), NULL );
+
+	next = NULL;
+
+	if( !view->private->dispose_has_run ){
+
 		model = NACT_TREE_MODEL( gtk_tree_view_get_model( view->private->tree_view ));
-		nact_tree_model_fill( model, items );
-		g_debug( "%s: nact_tree_model_ref_count=%d", thisfn, G_OBJECT( model )->ref_count );
+		next = nact_tree_model_fill_chunk( model, items, count );
+	}
+
+	return( next );
+}
+
+/**
+ * nact_tree_view_fill_end:
+ * @view: this #NactTreeView instance.
+ * @items: the full list of level-zero items which has been loaded.
+ *
+ * Terminates a progressive fillup of the tree view.
+ */
+void
+nact_tree_view_fill_end( NactTreeView *view, GList *items )
+{
+	static const gchar *thisfn = "nact_tree_view_fill_end";
+	gint nb_menus, nb_actions, nb_profiles;
 
+	g_return_if_fail( NACT_IS_TREE_VIEW( view ));
+
+	if( !view->private->dispose_has_run ){
+		g_debug( "%s: view=%p, items=%p (count=%u)",
+				thisfn, ( void * ) view, ( void * ) items, g_list_length( items ));
+
+		gtk_widget_set_sensitive( GTK_WIDGET( view->private->tree_view ), TRUE );
 		view->private->notify_allowed = TRUE;
+
 		na_object_count_items( items, &nb_menus, &nb_actions, &nb_profiles );
 		g_signal_emit_by_name( view->private->window, TREE_SIGNAL_COUNT_CHANGED, TRUE, nb_menus, nb_actions, nb_profiles );
 		g_signal_emit_by_name( view->private->window, TREE_SIGNAL_MODIFIED_STATUS_CHANGED, FALSE );
@@ -1017,6 +1097,40 @@ nact_tree_view_get_item_by_id( const NactTreeView *view, const gchar *id )
 	return( item );
 }
 
+/**
+ * nact_tree_view_get_items_index:
+ * @view: this #NactTreeView instance.
+ *
+ * Returns: a newly allocated #GHashTable which maps the identifier of each
+ * #NAObjectItem of the tree, menus content included, to the item itself.
+ * As in nact_tree_view_get_item_by_id(), identifiers are compared without
+ * regard to case. The hash table should be g_hash_table_destroy() by the
+ * caller, while the items are owned by the underlying tree store.
+ *
+ * This is preferred to nact_tree_view_get_item_by_id() when a lot of
+ * identifiers have to be checked, as the tree is only walked once.
+ */
+GHashTable *
+nact_tree_view_get_items_index( const NactTreeView *view )
+{
+	GHashTable *index;
+	GList *items;
+
+	g_return_val_if_fail( NACT_IS_TREE_VIEW( view ), NULL );
+
+	index = g_hash_table_new_full(
+			( GHashFunc ) index_id_hash, ( GEqualFunc ) index_id_equal, ( GDestroyNotify ) g_free, NULL );
+
+	if( !view->private->dispose_has_run ){
+
+		items = nact_tree_view_get_items( view );
+		index_items( index, items );
+		na_object_free_items( items );
+	}
+
+	return( index );
+}
+
 /**
  * nact_tree_view_get_items:
  * @view: this #NactTreeView instance.
@@ -1465,3 +1579,50 @@ toggle_collapse_row( GtkTreeView *treeview, GtkTreePath *path, guint *toggle )
 		}
 	}
 }
+
+/*
+ * parents are indexed before their children, so that the first found
+ * item is kept as when walking the store
+ */
+static void
+index_items( GHashTable *index, GList *items )
+{
+	GList *it;
+	gchar *id;
+
+	for( it = items ; it ; it = it->next ){
+		if( NA_IS_OBJECT_ITEM( it->data )){
+			id = na_object_get_id( it->data );
+
+			if( !g_hash_table_lookup( index, id )){
+				g_hash_table_insert( index, id, it->data );
+
+			} else {
+				g_free( id );
+			}
+
+			if( NA_IS_OBJECT_MENU( it->data )){
+				index_items( index, na_object_get_items( it->data ));
+			}
+		}
+	}
+}
+
+static guint
+index_id_hash( const gchar *id )
+{
+	gchar *down;
+	guint hash;
+
+	down = g_ascii_strdown( id, -1 );
+	hash = g_str_hash( down );
+	g_free( down );
+
+	return( hash );
+}
+
+static gboolean
+index_id_equal( const gchar *a, const gchar *b )
+{
+	return( g_ascii_strcasecmp( a, b ) == 0 );
+}
@@ -132,6 +132,9 @@ GType         nact_tree_view_get_type( void );
 NactTreeView *nact_tree_view_new( BaseWindow *window, GtkContainer *parent, const gchar *treeview_name, NactTreeMode mode );
 
 void          nact_tree_view_fill     ( NactTreeView *view, GList *items );
+void          nact_tree_view_fill_begin( NactTreeView *view );
+GList        *nact_tree_view_fill_chunk( NactTreeView *view, GList *items, guint count );
+void          nact_tree_view_fill_end  ( NactTreeView *view, GList *items );
 
 gboolean      nact_tree_view_are_notify_allowed( const NactTreeView *view );
 void          nact_tree_view_set_notify_allowed( NactTreeView *view, gboolean allow );
@@ -139,6 +142,7 @@ void          nact_tree_view_set_notify_allowed( NactTreeView *view, gboolean al
 void          nact_tree_view_collapse_all      ( const NactTreeView *view );
 void          nact_tree_view_expand_all        ( const NactTreeView *view );
 NAObjectItem *nact_tree_view_get_item_by_id    ( const NactTreeView *view, const gchar *id );
+GHashTable   *nact_tree_view_get_items_index   ( const NactTreeView *view );
 GList        *nact_tree_view_get_items         ( const NactTreeView *view );
 GList        *nact_tree_view_get_items_ex      ( const NactTreeView *view, guint mode );
 
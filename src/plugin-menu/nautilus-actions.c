@@ -32,8 +32,10 @@
 #endif
 
 #include <string.h>
+#include <unistd.h>
 
 #include <glib/gi18n.h>
+#include <gtk/gtk.h>
 
 #include <libnautilus-extension/nautilus-extension-types.h>
 #include <libnautilus-extension/nautilus-file-info.h>
@@ -45,7 +47,10 @@
 
 #include <core/na-pivot.h>
 #include <core/na-about.h>
+#include <core/na-desktop-environment.h>
 #include <core/na-selected-info.h>
+#include <core/na-service.h>
+#include <core/na-snapshot.h>
 #include <core/na-tokens.h>
 
 #include "nautilus-actions.h"
@@ -59,16 +64,45 @@ struct _NautilusActionsClassPrivate {
 /* private instance data
  */
 struct _NautilusActionsPrivate {
-	gboolean  dispose_has_run;
-	NAPivot  *pivot;
-	gulong    items_changed_handler;
-	gulong    settings_changed_handler;
-	NATimeout change_timeout;
+	gboolean    dispose_has_run;
+	NAPivot    *pivot;
+	gulong      items_changed_handler;
+	gulong      settings_changed_handler;
+	NATimeout   change_timeout;
+	GHashTable *candidates_cache;
 };
 
+/* a node of the candidates tree, as cached for a selection signature
+ *
+ * the candidates tree is the subset of the NAPivot tree which satisfies
+ * the static conditions for this selection signature (see
+ * na_icontext_is_candidate_static()); dynamic conditions still have to
+ * be re-evaluated each time the menu is built
+ */
+typedef struct {
+	NAObjectItem *item;					/* a new reference on the NAPivot item */
+	GSList       *profiles;				/* for an action, the ids of the candidate profiles */
+	GList        *children;				/* for a menu, the list of candidate subitems */
+}
+	CandidateNode;
+
 static GObjectClass *st_parent_class  = NULL;
 static GType         st_actions_type  = 0;
 static gint          st_burst_timeout = 100;		/* burst timeout in msec */
+static guint         st_cache_max     = 32;			/* max count of cached signatures */
+
+/* a process-wide cache of the icons provided to Nautilus
+ * key is the icon as found in the item; value is the resolved icon, i.e.
+ * an existing filename or a themed icon name, or an empty string when the
+ * icon is not available
+ * only the icons which do not depend on the selection are cached, so that
+ * the count of entries is bounded by the count of defined items
+ */
+static GHashTable   *st_icons_cache   = NULL;
+
+/* data set on an expanded item when its icon contained tokens
+ */
+#define ICON_HAS_TOKENS					"nautilus-actions-icon-has-tokens"
 
 static void              class_init( NautilusActionsClass *klass );
 static void              instance_init( GTypeInstance *instance, gpointer klass );
@@ -85,10 +119,16 @@ static GList            *menu_provider_get_toolbar_items( NautilusMenuProvider *
 #endif
 
 static GList            *build_nautilus_menu( NautilusActions *plugin, guint target, GList *selection );
-static GList            *build_nautilus_menu_rec( GList *tree, guint target, GList *selection, NATokens *tokens );
+static GList            *build_nautilus_menu_rec( GList *candidates, guint target, GList *selection, NATokens *tokens );
+static GList            *get_candidates( NautilusActions *plugin, guint target, GList *selection );
+static GList            *get_candidates_rec( GList *tree, guint target, GList *selection );
+static void              free_candidates( GList *candidates );
+static gchar            *get_selection_signature( guint target, GList *selection );
+static GSList           *signature_add_distinct( GSList *list, gchar *str );
+static void              signature_append( GString *signature, const gchar *prefix, GSList *list );
 static NAObjectItem     *expand_tokens_item( const NAObjectItem *item, NATokens *tokens );
 static void              expand_tokens_context( NAIContext *context, NATokens *tokens );
-static NAObjectProfile  *get_candidate_profile( NAObjectAction *action, guint target, GList *files );
+static NAObjectProfile  *get_candidate_profile( NAObjectAction *action, GSList *profiles, guint target, GList *files );
 static NautilusMenuItem *create_item_from_profile( NAObjectProfile *profile, guint target, GList *files, NATokens *tokens );
 static NautilusMenuItem *create_item_from_menu( NAObjectMenu *menu, GList *subitems, guint target );
 static NautilusMenuItem *create_menu_item( const NAObjectItem *item, guint target );
@@ -105,6 +145,11 @@ static void              execute_about( NautilusMenuItem *item, NautilusActions
 static void              on_pivot_items_changed_handler( NAPivot *pivot, NautilusActions *plugin );
 static void              on_settings_key_changed_handler( const gchar *group, const gchar *key, gconstpointer new_value, gboolean mandatory, NautilusActions *plugin );
 static void              on_change_event_timeout( NautilusActions *plugin );
+static void              clear_candidates_cache( NautilusActions *plugin );
+static gchar            *get_resolved_icon( const gchar *icon, gboolean cacheable );
+static gchar            *resolve_icon( const gchar *icon );
+static void              on_icon_theme_changed( GtkIconTheme *icon_theme, void *empty );
+static void              set_shared_service( NautilusActions *plugin );
 
 GType
 nautilus_actions_get_type( void )
@@ -182,7 +227,9 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->change_timeout.timeout = st_burst_timeout;
 	self->private->change_timeout.handler = ( NATimeoutFunc ) on_change_event_timeout;
 	self->private->change_timeout.user_data = self;
-	self->private->change_timeout.source_id = 0;
+
+	self->private->candidates_cache =
+			g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) free_candidates );
 }
 
 /*
@@ -221,6 +268,12 @@ instance_constructed( GObject *object )
 		 */
 		na_pivot_set_loadable( priv->pivot, !PIVOT_LOAD_DISABLED & !PIVOT_LOAD_INVALID );
 		na_pivot_load_items( priv->pivot );
+		set_shared_service( NAUTILUS_ACTIONS( object ));
+
+		/* detect the running desktop now rather than when displaying
+		 * the first menu, as OnlyShowIn/NotShowIn conditions need it
+		 */
+		na_desktop_environment_detect_running_desktop();
 
 		/* register against NAPivot to be notified of items changes
 		 */
@@ -259,6 +312,11 @@ instance_constructed( GObject *object )
 				NA_IPREFS_ITEMS_LIST_ORDER_MODE,
 				G_CALLBACK( on_settings_key_changed_handler ),
 				object );
+
+		na_settings_register_key_callback(
+				NA_IPREFS_ITEMS_SHARED_SERVICE,
+				G_CALLBACK( on_settings_key_changed_handler ),
+				object );
 	}
 }
 
@@ -276,9 +334,14 @@ instance_dispose( GObject *object )
 
 		self->private->dispose_has_run = TRUE;
 
+		na_timeout_remove( &self->private->change_timeout );
+
 		if( self->private->items_changed_handler ){
 			g_signal_handler_disconnect( self->private->pivot, self->private->items_changed_handler );
 		}
+		g_hash_table_destroy( self->private->candidates_cache );
+		na_service_unexport( self->private->pivot );
+		na_snapshot_remove( self->private->pivot );
 		g_object_unref( self->private->pivot );
 
 		/* chain up to the parent class */
@@ -483,6 +546,11 @@ menu_provider_get_toolbar_items( NautilusMenuProvider *provider, GtkWidget *wind
  *
  * Build the Nautilus menu as a list of NautilusMenuItem items
  *
+ * The static conditions are only evaluated once for a given selection
+ * signature; the resulting candidates tree is cached until the items
+ * or the runtime preferences change. Only the dynamic conditions and
+ * the tokens expansion are so re-evaluated on each popup.
+ *
  * Returns: the Nautilus menu
  */
 static GList *
@@ -490,7 +558,7 @@ build_nautilus_menu( NautilusActions *plugin, guint target, GList *selection )
 {
 	GList *nautilus_menu;
 	NATokens *tokens;
-	GList *tree;
+	GList *candidates;
 	gboolean items_add_about_item;
 	gboolean items_create_root_menu;
 
@@ -498,9 +566,9 @@ build_nautilus_menu( NautilusActions *plugin, guint target, GList *selection )
 
 	tokens = na_tokens_new_from_selection( selection );
 
-	tree = na_pivot_get_items( plugin->private->pivot );
+	candidates = get_candidates( plugin, target, selection );
 
-	nautilus_menu = build_nautilus_menu_rec( tree, target, selection, tokens );
+	nautilus_menu = build_nautilus_menu_rec( candidates, target, selection, tokens );
 
 	/* the NATokens object has been attached (and reffed) by each found
 	 * candidate profile, so it will be actually finalized only on actual
@@ -524,13 +592,17 @@ build_nautilus_menu( NautilusActions *plugin, guint target, GList *selection )
 	return( nautilus_menu );
 }
 
+/*
+ * @candidates: the list of CandidateNode's which satisfy the static
+ *  conditions for the current selection signature.
+ */
 static GList *
-build_nautilus_menu_rec( GList *tree, guint target, GList *selection, NATokens *tokens )
+build_nautilus_menu_rec( GList *candidates, guint target, GList *selection, NATokens *tokens )
 {
 	static const gchar *thisfn = "nautilus_actions_build_nautilus_menu_rec";
 	GList *nautilus_menu;
 	GList *it;
-	GList *subitems;
+	CandidateNode *node;
 	NAObjectItem *item;
 	GList *submenu;
 	NAObjectProfile *profile;
@@ -539,19 +611,20 @@ build_nautilus_menu_rec( GList *tree, guint target, GList *selection, NATokens *
 
 	nautilus_menu = NULL;
 
-	for( it = tree ; it ; it = it->next ){
+	for( it = candidates ; it ; it = it->next ){
 
-		g_return_val_if_fail( NA_IS_OBJECT_ITEM( it->data ), NULL );
-		label = na_object_get_label( it->data );
+		node = ( CandidateNode * ) it->data;
+		g_return_val_if_fail( NA_IS_OBJECT_ITEM( node->item ), NULL );
+		label = na_object_get_label( node->item );
 		g_debug( "%s: examining %s", thisfn, label );
 
-		if( !na_icontext_is_candidate( NA_ICONTEXT( it->data ), target, selection )){
+		if( !na_icontext_is_candidate_dynamic( NA_ICONTEXT( node->item ), target, selection )){
 			g_debug( "%s: is not candidate (NAIContext): %s", thisfn, label );
 			g_free( label );
 			continue;
 		}
 
-		item = expand_tokens_item( NA_OBJECT_ITEM( it->data ), tokens );
+		item = expand_tokens_item( node->item, tokens );
 
 		/* but we have to re-check for validity as a label may become
 		 * dynamically empty - thus the NAObjectItem invalid :(
@@ -567,12 +640,11 @@ build_nautilus_menu_rec( GList *tree, guint target, GList *selection, NATokens *
 		 * the 'submenu' menu of nautilusMenuItem's is attached to the returned
 		 * 'item'
 		 */
-		if( NA_IS_OBJECT_MENU( it->data )){
+		if( NA_IS_OBJECT_MENU( node->item )){
 
-			subitems = na_object_get_items( NA_OBJECT( it->data ));
-			g_debug( "%s: menu has %d items", thisfn, g_list_length( subitems ));
+			g_debug( "%s: menu has %d candidate items", thisfn, g_list_length( node->children ));
 
-			submenu = build_nautilus_menu_rec( subitems, target, selection, tokens );
+			submenu = build_nautilus_menu_rec( node->children, target, selection, tokens );
 			g_debug( "%s: submenu has %d items", thisfn, g_list_length( submenu ));
 
 			if( submenu ){
@@ -592,8 +664,9 @@ build_nautilus_menu_rec( GList *tree, guint target, GList *selection, NATokens *
 		g_return_val_if_fail( NA_IS_OBJECT_ACTION( item ), NULL );
 
 		/* if we have an action, searches for a candidate profile
+		 * among those which have satisfied the static conditions
 		 */
-		profile = get_candidate_profile( NA_OBJECT_ACTION( item ), target, selection );
+		profile = get_candidate_profile( NA_OBJECT_ACTION( item ), node->profiles, target, selection );
 		if( profile ){
 			menu_item = create_item_from_profile( profile, target, selection, tokens );
 			nautilus_menu = g_list_append( nautilus_menu, menu_item );
@@ -609,6 +682,220 @@ build_nautilus_menu_rec( GList *tree, guint target, GList *selection, NATokens *
 	return( nautilus_menu );
 }
 
+/*
+ * get_candidates:
+ * @plugin: this #NautilusActions instance.
+ * @target: the current target.
+ * @selection: the current selection.
+ *
+ * Returns: the tree of items which satisfy the static conditions for
+ * this @selection, as a list of CandidateNode's.
+ *
+ * The returned list is owned by the cache, and should not be released
+ * by the caller.
+ */
+static GList *
+get_candidates( NautilusActions *plugin, guint target, GList *selection )
+{
+	static const gchar *thisfn = "nautilus_actions_get_candidates";
+	GHashTable *cache;
+	gchar *signature;
+	GList *candidates;
+
+	cache = plugin->private->candidates_cache;
+	signature = get_selection_signature( target, selection );
+
+	if( g_hash_table_lookup_extended( cache, signature, NULL, ( gpointer * ) &candidates )){
+		g_debug( "%s: signature=%s found in cache (%d candidates)", thisfn, signature, g_list_length( candidates ));
+		g_free( signature );
+
+	} else {
+		if( g_hash_table_size( cache ) >= st_cache_max ){
+			g_hash_table_remove_all( cache );
+		}
+		candidates = get_candidates_rec( na_pivot_get_items( plugin->private->pivot ), target, selection );
+		g_debug( "%s: signature=%s computed (%d candidates)", thisfn, signature, g_list_length( candidates ));
+
+		/* the cache takes ownership of the signature */
+		g_hash_table_insert( cache, signature, candidates );
+	}
+
+	return( candidates );
+}
+
+static GList *
+get_candidates_rec( GList *tree, guint target, GList *selection )
+{
+	static const gchar *thisfn = "nautilus_actions_get_candidates_rec";
+	GList *candidates;
+	GList *it, *ip;
+	CandidateNode *node;
+	GSList *profiles;
+	GList *children;
+
+	candidates = NULL;
+
+	for( it = tree ; it ; it = it->next ){
+
+		g_return_val_if_fail( NA_IS_OBJECT_ITEM( it->data ), NULL );
+
+		if( !na_icontext_is_candidate_static( NA_ICONTEXT( it->data ), target, selection )){
+			continue;
+		}
+
+		profiles = NULL;
+		children = NULL;
+
+		/* a menu without any candidate subitem will never be displayed
+		 * an action without any candidate profile neither
+		 */
+		if( NA_IS_OBJECT_MENU( it->data )){
+			children = get_candidates_rec( na_object_get_items( it->data ), target, selection );
+			if( !children ){
+				continue;
+			}
+
+		} else {
+			for( ip = na_object_get_items( it->data ) ; ip ; ip = ip->next ){
+				if( na_icontext_is_candidate_static( NA_ICONTEXT( ip->data ), target, selection )){
+					profiles = g_slist_prepend( profiles, na_object_get_id( ip->data ));
+				}
+			}
+			if( !profiles ){
+				g_debug( "%s: action %p does not have any static candidate profile", thisfn, ( void * ) it->data );
+				continue;
+			}
+			profiles = g_slist_reverse( profiles );
+		}
+
+		node = g_new0( CandidateNode, 1 );
+		node->item = NA_OBJECT_ITEM( g_object_ref( it->data ));
+		node->profiles = profiles;
+		node->children = children;
+		candidates = g_list_prepend( candidates, node );
+	}
+
+	return( g_list_reverse( candidates ));
+}
+
+static void
+free_candidates( GList *candidates )
+{
+	GList *it;
+	CandidateNode *node;
+
+	for( it = candidates ; it ; it = it->next ){
+		node = ( CandidateNode * ) it->data;
+		g_object_unref( node->item );
+		na_core_utils_slist_free( node->profiles );
+		free_candidates( node->children );
+		g_free( node );
+	}
+
+	g_list_free( candidates );
+}
+
+/*
+ * get_selection_signature:
+ * @target: the current target.
+ * @selection: the current selection.
+ *
+ * The signature gathers all the properties of the selection which are
+ * examined by the static conditions: the target, the count of selected
+ * items, and the distinct sets of mimetypes (with the regular-file
+ * flag), schemes, dirnames and capabilities.
+ *
+ * Returns: the signature as a newly allocated string which should be
+ * g_free() by the caller.
+ */
+static gchar *
+get_selection_signature( guint target, GList *selection )
+{
+	GString *signature;
+	GSList *mimetypes, *schemes, *dirnames, *capabilities;
+	GList *it;
+	NASelectedInfo *nsi;
+	gchar *tmp;
+	guint caps;
+	const gchar *user;
+
+	mimetypes = NULL;
+	schemes = NULL;
+	dirnames = NULL;
+	capabilities = NULL;
+	user = getlogin();
+
+	for( it = selection ; it ; it = it->next ){
+		nsi = NA_SELECTED_INFO( it->data );
+
+		tmp = na_selected_info_get_mime_type( nsi );
+		mimetypes = signature_add_distinct( mimetypes,
+				g_strdup_printf( "%s:%d", tmp ? tmp : "", na_selected_info_is_regular( nsi ) ? 1 : 0 ));
+		g_free( tmp );
+
+		schemes = signature_add_distinct( schemes, na_selected_info_get_uri_scheme( nsi ));
+		dirnames = signature_add_distinct( dirnames, na_selected_info_get_dirname( nsi ));
+
+		caps = ( user && na_selected_info_is_owner( nsi, user ) ? 1 : 0 )
+				| ( na_selected_info_is_readable( nsi ) ? 2 : 0 )
+				| ( na_selected_info_is_writable( nsi ) ? 4 : 0 )
+				| ( na_selected_info_is_executable( nsi ) ? 8 : 0 )
+				| ( na_selected_info_is_local( nsi ) ? 16 : 0 );
+		capabilities = signature_add_distinct( capabilities, g_strdup_printf( "%u", caps ));
+	}
+
+	signature = g_string_new( "" );
+	g_string_append_printf( signature, "t=%u;n=%u", target, g_list_length( selection ));
+	signature_append( signature, "m", mimetypes );
+	signature_append( signature, "s", schemes );
+	signature_append( signature, "d", dirnames );
+	signature_append( signature, "c", capabilities );
+
+	na_core_utils_slist_free( capabilities );
+	na_core_utils_slist_free( dirnames );
+	na_core_utils_slist_free( schemes );
+	na_core_utils_slist_free( mimetypes );
+
+	return( g_string_free( signature, FALSE ));
+}
+
+/*
+ * takes ownership of @str
+ */
+static GSList *
+signature_add_distinct( GSList *list, gchar *str )
+{
+	if( !str ){
+		str = g_strdup( "" );
+	}
+
+	if( na_core_utils_slist_count( list, str ) == 0 ){
+		list = g_slist_prepend( list, str );
+
+	} else {
+		g_free( str );
+	}
+
+	return( list );
+}
+
+/*
+ * sort the distinct values so that the signature does not depend on
+ * the order of the selected items
+ */
+static void
+signature_append( GString *signature, const gchar *prefix, GSList *list )
+{
+	GSList *sorted;
+	gchar *text;
+
+	sorted = g_slist_sort( g_slist_copy( list ), ( GCompareFunc ) strcmp );
+	text = na_core_utils_slist_join_at_end( sorted, "," );
+	g_string_append_printf( signature, ";%s=%s", prefix, text );
+	g_free( text );
+	g_slist_free( sorted );
+}
+
 /*
  * expand_tokens_item:
  * @item: a NAObjectItem read from the NAPivot.
@@ -651,6 +938,9 @@ expand_tokens_item( const NAObjectItem *src, NATokens *tokens )
 	old = na_object_get_icon( item );
 	new = na_tokens_parse_for_display( tokens, old, TRUE );
 	na_object_set_icon( item, new );
+	if( g_strcmp0( old, new )){
+		g_object_set_data( G_OBJECT( item ), ICON_HAS_TOKENS, GUINT_TO_POINTER( TRUE ));
+	}
 	g_free( old );
 	g_free( new );
 
@@ -743,23 +1033,27 @@ expand_tokens_context( NAIContext *context, NATokens *tokens )
 
 /*
  * could also be a NAObjectAction method - but this is not used elsewhere
+ *
+ * @action: the action, after tokens expansion.
+ * @profiles: the ids of the profiles which have satisfied the static
+ *  conditions; only the dynamic ones have to be checked here.
  */
 static NAObjectProfile *
-get_candidate_profile( NAObjectAction *action, guint target, GList *files )
+get_candidate_profile( NAObjectAction *action, GSList *profiles, guint target, GList *files )
 {
 	static const gchar *thisfn = "nautilus_actions_get_candidate_profile";
 	NAObjectProfile *candidate = NULL;
 	gchar *action_label;
 	gchar *profile_label;
-	GList *profiles, *ip;
+	GSList *ip;
+	NAObjectProfile *profile;
 
 	action_label = na_object_get_label( action );
-	profiles = na_object_get_items( action );
 
 	for( ip = profiles ; ip && !candidate ; ip = ip->next ){
-		NAObjectProfile *profile = NA_OBJECT_PROFILE( ip->data );
+		profile = NA_OBJECT_PROFILE( na_object_get_item( action, ip->data ));
 
-		if( na_icontext_is_candidate( NA_ICONTEXT( profile ), target, files )){
+		if( profile && na_icontext_is_candidate_dynamic( NA_ICONTEXT( profile ), target, files )){
 			profile_label = na_object_get_label( profile );
 			g_debug( "%s: selecting %s (profile=%p '%s')", thisfn, action_label, ( void * ) profile, profile_label );
 			g_free( profile_label );
@@ -846,18 +1140,22 @@ static NautilusMenuItem *
 create_menu_item( const NAObjectItem *item, guint target )
 {
 	NautilusMenuItem *menu_item;
-	gchar *id, *name, *label, *tooltip, *icon;
+	gchar *id, *name, *label, *tooltip, *icon, *resolved;
+	gboolean cacheable;
 
 	id = na_object_get_id( item );
 	name = g_strdup_printf( "%s-%s-%s-%d", PACKAGE, G_OBJECT_TYPE_NAME( item ), id, target );
 	label = na_object_get_label( item );
 	tooltip = na_object_get_tooltip( item );
 	icon = na_object_get_icon( item );
+	cacheable = !g_object_get_data( G_OBJECT( item ), ICON_HAS_TOKENS );
+	resolved = get_resolved_icon( icon, cacheable );
 
-	menu_item = nautilus_menu_item_new( name, label, tooltip, icon );
+	menu_item = nautilus_menu_item_new( name, label, tooltip, strlen( resolved ) ? resolved : NULL );
 
 	g_object_weak_ref( G_OBJECT( menu_item ), ( GWeakNotify ) weak_notify_menu_item, NULL );
 
+	g_free( resolved );
 	g_free( icon );
  	g_free( tooltip );
  	g_free( label );
@@ -1024,6 +1322,7 @@ on_pivot_items_changed_handler( NAPivot *pivot, NautilusActions *plugin )
 
 	if( !plugin->private->dispose_has_run ){
 
+		clear_candidates_cache( plugin );
 		na_timeout_event( &plugin->private->change_timeout );
 	}
 }
@@ -1039,6 +1338,7 @@ on_settings_key_changed_handler( const gchar *group, const gchar *key, gconstpoi
 
 	if( !plugin->private->dispose_has_run ){
 
+		clear_candidates_cache( plugin );
 		na_timeout_event( &plugin->private->change_timeout );
 	}
 }
@@ -1052,6 +1352,123 @@ on_change_event_timeout( NautilusActions *plugin )
 	static const gchar *thisfn = "nautilus_actions_on_change_event_timeout";
 	g_debug( "%s: timeout expired", thisfn );
 
+	/* cached candidates hold references on the items of the previous tree
+	 */
+	clear_candidates_cache( plugin );
+
 	na_pivot_load_items( plugin->private->pivot );
+	set_shared_service( plugin );
 	nautilus_menu_provider_emit_items_updated_signal( NAUTILUS_MENU_PROVIDER( plugin ));
 }
+
+/*
+ * export our freshly loaded tree on the session bus, and write its
+ * snapshot, so that other processes (e.g. nautilus-actions-run) do not
+ * have to load it again
+ */
+static void
+set_shared_service( NautilusActions *plugin )
+{
+	if( na_settings_get_boolean( NA_IPREFS_ITEMS_SHARED_SERVICE, NULL, NULL )){
+		na_service_export( plugin->private->pivot );
+		na_service_items_changed( plugin->private->pivot );
+		na_snapshot_write( plugin->private->pivot );
+
+	} else {
+		na_service_unexport( plugin->private->pivot );
+		na_snapshot_remove( plugin->private->pivot );
+	}
+}
+
+static void
+clear_candidates_cache( NautilusActions *plugin )
+{
+	g_hash_table_remove_all( plugin->private->candidates_cache );
+
+	/* icon files may have been created or removed along with the items */
+	if( st_icons_cache ){
+		g_hash_table_remove_all( st_icons_cache );
+	}
+}
+
+/*
+ * @cacheable: whether @icon does not depend on the current selection,
+ *  i.e. did not contain any token before expansion.
+ *
+ * Returns: the icon to be provided to Nautilus, as a newly allocated
+ * string, which is empty if the icon is not available.
+ */
+static gchar *
+get_resolved_icon( const gchar *icon, gboolean cacheable )
+{
+	const gchar *resolved;
+
+	if( !icon || !strlen( icon )){
+		return( g_strdup( "" ));
+	}
+
+	if( !cacheable ){
+		return( resolve_icon( icon ));
+	}
+
+	if( !st_icons_cache ){
+		st_icons_cache = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, g_free );
+		g_signal_connect( gtk_icon_theme_get_default(), "changed", G_CALLBACK( on_icon_theme_changed ), NULL );
+	}
+
+	resolved = ( const gchar * ) g_hash_table_lookup( st_icons_cache, icon );
+
+	if( !resolved ){
+		resolved = resolve_icon( icon );
+		g_hash_table_insert( st_icons_cache, g_strdup( icon ), ( gpointer ) resolved );
+	}
+
+	return( g_strdup( resolved ));
+}
+
+/*
+ * an icon may be specified as a filename, a file URI or a themed icon
+ * name; Nautilus only knows about the first and the last ones
+ *
+ * Returns: a newly allocated string.
+ */
+static gchar *
+resolve_icon( const gchar *icon )
+{
+	static const gchar *thisfn = "nautilus_actions_resolve_icon";
+	gchar *resolved;
+	gchar *path;
+
+	resolved = NULL;
+
+	if( g_path_is_absolute( icon )){
+		if( g_file_test( icon, G_FILE_TEST_IS_REGULAR )){
+			resolved = g_strdup( icon );
+		}
+
+	} else if( g_str_has_prefix( icon, "file://" )){
+		path = g_filename_from_uri( icon, NULL, NULL );
+		if( path && g_file_test( path, G_FILE_TEST_IS_REGULAR )){
+			resolved = path;
+		} else {
+			g_free( path );
+		}
+
+	} else if( gtk_icon_theme_has_icon( gtk_icon_theme_get_default(), icon )){
+		resolved = g_strdup( icon );
+	}
+
+	if( !resolved ){
+		g_debug( "%s: icon=%s: not available", thisfn, icon );
+	}
+
+	return( resolved ? resolved : g_strdup( "" ));
+}
+
+static void
+on_icon_theme_changed( GtkIconTheme *icon_theme, void *empty )
+{
+	g_debug( "nautilus_actions_on_icon_theme_changed: icon_theme=%p", ( void * ) icon_theme );
+
+	g_hash_table_remove_all( st_icons_cache );
+}
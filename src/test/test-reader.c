@@ -33,6 +33,7 @@
 
 #include <glib/gi18n.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <api/na-core-utils.h>
 
@@ -78,6 +79,7 @@ main( int argc, char **argv )
 	na_pivot_set_loadable( pivot, !PIVOT_LOAD_DISABLED & !PIVOT_LOAD_INVALID );
 	na_pivot_load_items( pivot );
 
+	memset( &parms, '\0', sizeof( NAImporterParms ));
 	parms.uris = g_slist_prepend( NULL, uri );
 	parms.check_fn = NULL;
 	parms.check_fn_data = NULL;
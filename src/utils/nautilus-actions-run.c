@@ -228,9 +228,16 @@ get_action( const gchar *id )
 
 	pivot = na_pivot_new();
 	na_pivot_set_loadable( pivot, !PIVOT_LOAD_DISABLED & !PIVOT_LOAD_INVALID );
-	na_pivot_load_items( pivot );
 
-	action = ( NAObjectAction * ) na_pivot_get_item( pivot, id );
+	/* first try to only rebuild the requested action from the snapshot
+	 * of the tree, before loading the whole tree
+	 */
+	action = ( NAObjectAction * ) na_pivot_get_snapshot_item( pivot, id );
+
+	if( !action ){
+		na_pivot_load_shared_items( pivot );
+		action = ( NAObjectAction * ) na_pivot_get_item( pivot, id );
+	}
 
 	if( !action ){
 		g_printerr( _( "Error: action '%s' doesn't exist.\n" ), id );
@@ -454,6 +461,16 @@ execute_action( NAObjectAction *action, NAObjectProfile *profile, GList *targets
 
 	tokens = na_tokens_new_from_selection( targets );
 	na_tokens_execute_action( tokens, profile );
+
+	/* the commands which exceed the max count of simultaneous children
+	 * are only run when a previous one terminates: wait for them before
+	 * exiting
+	 */
+	while( na_tokens_get_execution_progress( NULL, NULL )){
+		g_main_context_iteration( NULL, TRUE );
+	}
+
+	g_object_unref( tokens );
 }
 
 /*